@@ -1,71 +1,159 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-
-#include "OGGameplayTriggerTypes.h"
-
-#include "OGGameplayTriggerSubsystem.h"
-#include "Net/UnrealNetwork.h"
-
-bool FOGGameplayTriggerHandle::IsActive() const
-{
-	return IsValid() && TriggerSubsystem->IsTriggerActive(*this);
-}
-
-bool FOGGameplayTriggerHandle::IsValid() const
-{
-	return FOGHandleBase::IsValid() && TriggerType.IsValid() && TriggerSubsystem.IsValid();
-}
-
-void FOGGameplayTriggerHandle::Reset()
-{
-	if (IsActive())
-	{
-		TriggerSubsystem->EndTrigger(*this);
-	}
-	TriggerType = FGameplayTag::EmptyTag;
-	TriggerSubsystem.Reset();
-	Super::Reset();
-}
-
-
-bool FOGTriggerListenerHandle::IsValid() const
-{
-	return FOGHandleBase::IsValid() && TriggerType.IsValid() && TriggerSubsystem.IsValid() &&
-		TriggerSubsystem->IsListenerHandleValid(*this);
-}
-
-void FOGTriggerListenerHandle::Reset()
-{
-	if (IsValid())
-	{
-		TriggerSubsystem->RemoveTriggerListener(*this);
-	}
-	TriggerType = FGameplayTag::EmptyTag;
-	TriggerSubsystem.Reset();
-	FOGHandleBase::Reset();
-}
-
-void UOGGameplayTriggerContext::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
-{
-	UObject::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-	FDoRepLifetimeParams Params;
-	Params.bIsPushBased = true;
-	
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, TriggerType, Params)
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, TriggerTags, Params)
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, InitiatorObject, Params)
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, TargetObject, Params)
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, DataBank, Params)
-}
-
-bool UOGGameplayTriggerFilter::DoesTriggerPassFilter(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const
-{
-	if (!DoesTriggerPassFilter_Native(TriggerPhase, Trigger, OutIsFilterStale))
-	{
-		return false;
-	}
-	bool bPasses = true;
-	DoesTriggerPassFilter_BP(TriggerPhase, Trigger, bPasses, OutIsFilterStale);
-	return bPasses;
-}
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGGameplayTriggerTypes.h"
+
+#include "OGGameplayTriggerSubsystem.h"
+#include "Net/UnrealNetwork.h"
+
+bool FOGGameplayTriggerHandle::IsActive() const
+{
+	return IsValid() && TriggerSubsystem->IsTriggerActive(*this);
+}
+
+bool FOGGameplayTriggerHandle::IsValid() const
+{
+	return FOGHandleBase::IsValid() && TriggerType.IsValid() && TriggerSubsystem.IsValid();
+}
+
+void FOGGameplayTriggerHandle::Reset()
+{
+	if (IsActive())
+	{
+		TriggerSubsystem->EndTrigger(*this);
+	}
+	TriggerType = FGameplayTag::EmptyTag;
+	TriggerSubsystem.Reset();
+	Super::Reset();
+}
+
+
+bool FOGTriggerListenerHandle::IsValid() const
+{
+	return FOGHandleBase::IsValid() && TriggerType.IsValid() && TriggerSubsystem.IsValid() &&
+		TriggerSubsystem->IsListenerHandleValid(*this);
+}
+
+void FOGTriggerListenerHandle::Reset()
+{
+	if (IsValid())
+	{
+		TriggerSubsystem->RemoveTriggerListener(*this);
+	}
+	TriggerType = FGameplayTag::EmptyTag;
+	TriggerSubsystem.Reset();
+	FOGHandleBase::Reset();
+}
+
+bool FOGTriggerListenerGroupHandle::IsValid() const
+{
+	return FOGHandleBase::IsValid() && TriggerSubsystem.IsValid() && TriggerSubsystem->IsListenerGroupValid(*this);
+}
+
+void FOGTriggerListenerGroupHandle::Reset()
+{
+	if (IsValid())
+	{
+		TriggerSubsystem->RemoveListenerGroup(*this);
+	}
+	TriggerSubsystem.Reset();
+	FOGHandleBase::Reset();
+}
+
+bool FOGTriggerTapHandle::IsValid() const
+{
+	return FOGHandleBase::IsValid() && TriggerSubsystem.IsValid() && TriggerSubsystem->IsTriggerTapValid(*this);
+}
+
+void FOGTriggerTapHandle::Reset()
+{
+	if (IsValid())
+	{
+		TriggerSubsystem->RemoveTriggerTap(*this);
+	}
+	TriggerSubsystem.Reset();
+	FOGHandleBase::Reset();
+}
+
+bool FOGTriggerAggregateViewHandle::IsValid() const
+{
+	return FOGHandleBase::IsValid() && TriggerSubsystem.IsValid() && TriggerSubsystem->IsAggregateViewValid(*this);
+}
+
+void FOGTriggerAggregateViewHandle::Reset()
+{
+	if (IsValid())
+	{
+		TriggerSubsystem->RemoveAggregateView(*this);
+	}
+	TriggerSubsystem.Reset();
+	FOGHandleBase::Reset();
+}
+
+void UOGGameplayTriggerContext::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	UObject::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, TriggerType, Params)
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, TriggerTagSet, Params)
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, InitiatorObject, Params)
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, TargetObject, Params)
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, DataBank, Params)
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, bHasLocation, Params)
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, Location, Params)
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, Radius, Params)
+}
+
+void UOGGameplayTriggerContext::SetLocation(const FVector& InLocation, float InRadius)
+{
+	bHasLocation = true;
+	Location = InLocation;
+	Radius = FMath::Max(InRadius, 0.f);
+}
+
+void UOGGameplayTriggerContext::ClearLocation()
+{
+	bHasLocation = false;
+	Location = FVector::ZeroVector;
+	Radius = 0.f;
+}
+
+bool UOGGameplayTriggerFilter::DoesTriggerPassFilter(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const
+{
+	if (!DoesTriggerPassFilter_Native(TriggerPhase, Trigger, OutIsFilterStale))
+	{
+		return false;
+	}
+	bool bPasses = true;
+	DoesTriggerPassFilter_BP(TriggerPhase, Trigger, bPasses, OutIsFilterStale);
+	return bPasses;
+}
+
+bool UOGGameplayTriggerFilter::IsFilterStale() const
+{
+	if (IsFilterStale_Native())
+	{
+		return true;
+	}
+	bool bIsStale = false;
+	IsFilterStale_BP(bIsStale);
+	return bIsStale;
+}
+
+bool FOGTriggerCompositeHandle::IsValid() const
+{
+	return FOGHandleBase::IsValid() && TriggerSubsystem.IsValid() && TriggerSubsystem->IsCompositeTriggerValid(*this);
+}
+
+void FOGTriggerCompositeHandle::Reset()
+{
+	if (IsValid())
+	{
+		TriggerSubsystem->RemoveCompositeTrigger(*this);
+	}
+	TriggerSubsystem.Reset();
+	FOGHandleBase::Reset();
+}
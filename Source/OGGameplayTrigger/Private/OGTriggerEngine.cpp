@@ -0,0 +1,2329 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGTriggerEngine.h"
+
+#include "Algo/AnyOf.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Count.h"
+#include "Algo/StableSort.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "OGGameplayTriggerSubsystem.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOGGameplayTrigger, Log, All);
+
+namespace OGGameplayTriggerSnapshot
+{
+	static constexpr uint32 Magic = 0x4F475453; // 'OGTS'
+
+	enum class EVersion : int32
+	{
+		Initial = 1,
+		// Trigger location and radius, written after the context properties
+		TriggerLocation = 2,
+		// Remaining duration and periodic updates of timed triggers, written after the location
+		TriggerTimers = 3,
+
+		// -----<new versions can be added above this line>-----
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+}
+
+static float GOGTriggerDeferredCallbackBudgetMs = 1.f;
+static FAutoConsoleVariableRef CVarOGTriggerDeferredCallbackBudgetMs(
+	TEXT("OG.GameplayTrigger.DeferredCallbackBudgetMs"),
+	GOGTriggerDeferredCallbackBudgetMs,
+	TEXT("Milliseconds per frame the gameplay trigger subsystem may spend running deferrable listener callbacks. Callbacks over budget spill over into the next frame."));
+
+static int32 GOGTriggerSweepListenersPerFrame = 32;
+static FAutoConsoleVariableRef CVarOGTriggerSweepListenersPerFrame(
+	TEXT("OG.GameplayTrigger.SweepListenersPerFrame"),
+	GOGTriggerSweepListenersPerFrame,
+	TEXT("Number of trigger listeners checked for staleness each frame by the background sweep. 0 disables the sweep."));
+
+static float GOGTriggerTrimIdleSeconds = 30.f;
+static FAutoConsoleVariableRef CVarOGTriggerTrimIdleSeconds(
+	TEXT("OG.GameplayTrigger.TrimIdleSeconds"),
+	GOGTriggerTrimIdleSeconds,
+	TEXT("Seconds a per-type listener or active trigger table has to stay empty or oversized before it is released or shrunk. 0 disables trimming."));
+
+static float GOGTriggerSpatialCellSize = 1000.f;
+static FAutoConsoleVariableRef CVarOGTriggerSpatialCellSize(
+	TEXT("OG.GameplayTrigger.SpatialCellSize"),
+	GOGTriggerSpatialCellSize,
+	TEXT("Edge length of the cells of the spatial listener grids. Only applies to grids created after it changes, a trigger type keeps its grid while it has spatial listeners."));
+
+//Handle validity without the subsystem check, handles of headless engines have no subsystem
+template<typename THandle>
+static bool IsEngineHandleValid(const THandle& Handle)
+{
+	return Handle.FOGHandleBase::IsValid() && Handle.TriggerType.IsValid();
+}
+
+FOGTriggerListenerData::FOGTriggerListenerData(const FGameplayTag& InTriggerType, EOGTriggerListenerPhases InListenerPhases,
+                                               const FOGTriggerDelegate& InCallback, const UObject* FilterInstigatorObject, const UObject* FilterTargetObject,
+                                               const TArray<UOGGameplayTriggerFilter*>& Filters) :
+	ListenerPhases(InListenerPhases),
+	OwnerKey(InCallback.GetUObject()),
+	InstigatorKey(FilterInstigatorObject),
+	TargetKey(FilterTargetObject),
+	Callback(InCallback)
+{
+	TriggerType = InTriggerType;
+	bFilterOnInstigator = FilterInstigatorObject != nullptr;
+	bFilterOnTarget = FilterTargetObject != nullptr;
+
+	SetFilters(Filters);
+}
+
+FOGTriggerListenerData::FOGTriggerListenerData(const FGameplayTag& InTriggerType, EOGTriggerListenerPhases InListenerPhases,
+                                               const FOGTriggerDelegate& InCallback, const FOGTriggerListenerOptions& Options) :
+	FOGTriggerListenerData(InTriggerType, InListenerPhases, InCallback, Options.FilterInstigator, Options.FilterTarget, Options.Filters)
+{
+	ApplyOptions(Options);
+}
+
+void FOGTriggerListenerData::Reinit(const FGameplayTag& InTriggerType, EOGTriggerListenerPhases InListenerPhases, const FOGTriggerListenerOptions& Options)
+{
+	//Same state as the constructor without a callback, field by field so the arrays keep their allocations.
+	//WhenListenerRemoved is kept, it is never handed out for pooled listeners
+	Handle = FOGTriggerListenerHandle();
+	TriggerType = InTriggerType;
+	AdditionalTriggerTypes.Reset();
+	ListenerPhases = InListenerPhases;
+	AnyThreadDispatch = nullptr;
+	LastCallTime = TNumericLimits<double>::Lowest();
+	LastCallFrame = 0;
+	NumCallsInFrame = 0;
+	bIsSpatial = false;
+	Location = FVector::ZeroVector;
+	TrackedActor = nullptr;
+	TrackedActorKey = FObjectKey();
+	SpatialListIndex = INDEX_NONE;
+	OwnerKey = FObjectKey();
+	bFilterOnInstigator = Options.FilterInstigator != nullptr;
+	InstigatorKey = FObjectKey(Options.FilterInstigator);
+	bFilterOnTarget = Options.FilterTarget != nullptr;
+	TargetKey = FObjectKey(Options.FilterTarget);
+	Callback.Unbind();
+	SetFilters(Options.Filters);
+	bHasFired = false;
+	ApplyOptions(Options);
+}
+
+void FOGTriggerListenerData::SetFilters(const TArray<UOGGameplayTriggerFilter*>& Filters)
+{
+	//Dispatch calls every filter without checking it, unset entries (e.g. a Blueprint array entry left to None) filter nothing
+	FilterObjects.Reset(Filters.Num());
+	for (UOGGameplayTriggerFilter* Filter : Filters)
+	{
+		if (Filter)
+		{
+			FilterObjects.Add(TStrongObjectPtr(Filter));
+		}
+	}
+}
+
+void FOGTriggerListenerData::ApplyOptions(const FOGTriggerListenerOptions& Options)
+{
+	Priority = Options.Priority;
+	bDeferrable = Options.bDeferrable;
+	RunOn = Options.RunOn;
+	Group = Options.Group;
+	MinInterval = Options.MinInterval;
+	MaxPerFrame = Options.MaxPerFrame;
+	RequiredTags = FOGTriggerTagSetId(Options.RequiredTags);
+	BlockedTags = FOGTriggerTagSetId(Options.BlockedTags);
+	if (Options.TrackedActor)
+	{
+		bIsSpatial = true;
+		TrackedActor = Options.TrackedActor;
+		TrackedActorKey = FObjectKey(Options.TrackedActor);
+		Location = Options.TrackedActor->GetActorLocation();
+	}
+	else if (Options.Location.IsSet())
+	{
+		bIsSpatial = true;
+		Location = Options.Location.GetValue();
+	}
+	Radius = FMath::Max(Options.Radius, 0.f);
+	if (Options.Owner)
+	{
+		OwnerKey = FObjectKey(Options.Owner);
+	}
+}
+
+FOGTriggerListenerData::~FOGTriggerListenerData()
+{
+	FilterObjects.Empty();
+}
+
+bool FOGTriggerListenerData::ShouldListenerProcessTrigger(EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, const FOGTriggerClock& Clock,
+	bool& bOutIsFilterStale) const
+{
+	//Listeners whose owner, instigator or target went away are reclaimed by the engine, so dispatch doesn't have to look for them.
+	//Object keys never match a different object, even if the filtered object is gone and the trigger has no instigator / target
+	if (IsRateLimited(Clock))
+		return false;
+	if (!(ListenerPhases & TriggerPhase))
+		return false;
+	if (!RequiredTags->IsEmpty() && !Trigger->GetTriggerTagSet().HasAll(RequiredTags.Get()))
+		return false;
+	if (!BlockedTags->IsEmpty() && Trigger->GetTriggerTagSet().HasAny(BlockedTags.Get()))
+		return false;
+	if (bFilterOnInstigator && FObjectKey(Trigger->InitiatorObject.Get()) != InstigatorKey)
+		return false;
+	if (bFilterOnTarget && FObjectKey(Trigger->TargetObject.Get()) != TargetKey)
+		return false;
+	
+	for (const TStrongObjectPtr<UOGGameplayTriggerFilter>& FilterObject : FilterObjects)
+	{
+		if (!FilterObject->DoesTriggerPassFilter(TriggerPhase, Trigger, bOutIsFilterStale))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FOGTriggerListenerData::IsBoundTo(const FObjectKey& Object) const
+{
+	return OwnerKey == Object || InstigatorKey == Object || TargetKey == Object || TrackedActorKey == Object;
+}
+
+bool FOGTriggerListenerData::IsStale() const
+{
+	if (!Callback.IsBound() && !AnyThreadDispatch && !bIsAwaiter)
+		return true;
+	for (const FObjectKey& BoundObject : {OwnerKey, InstigatorKey, TargetKey})
+	{
+		if (BoundObject != FObjectKey() && !BoundObject.ResolveObjectPtr())
+			return true;
+	}
+	if (!TrackedActor.IsExplicitlyNull() && !TrackedActor.IsValid())
+		return true;
+	for (const TStrongObjectPtr<UOGGameplayTriggerFilter>& FilterObject : FilterObjects)
+	{
+		if (!FilterObject.IsValid() || FilterObject->IsFilterStale())
+			return true;
+	}
+	return false;
+}
+
+SIZE_T FOGTriggerEngine::FOGTriggerListenerSnapshot::GetAllocatedSize() const
+{
+	return Listeners.GetAllocatedSize() + Phases.GetAllocatedSize() + RequiredTagMasks.GetAllocatedSize() + BlockedTagMasks.GetAllocatedSize()
+		+ IsSpatial.GetAllocatedSize();
+}
+
+void FOGTriggerEngine::FOGTriggerListenerSnapshot::Insert(int32 Index, const TSharedRef<FOGTriggerListenerData>& Listener)
+{
+	Listeners.Insert(Listener, Index);
+	Phases.Insert(Listener->ListenerPhases, Index);
+	RequiredTagMasks.Insert(Listener->RequiredTags->ExplicitMask, Index);
+	//A folded blocked bit could stand for a tag the listener doesn't block, so only collision free masks may reject
+	BlockedTagMasks.Insert(Listener->BlockedTags->IsMaskExact() ? Listener->BlockedTags->ExplicitMask : FOGTriggerTagMask(), Index);
+	IsSpatial.Insert(Listener->bIsSpatial, Index);
+	UpdateSpatialListIndices(Index);
+	ListenedPhases |= Listener->ListenerPhases;
+}
+
+void FOGTriggerEngine::FOGTriggerListenerSnapshot::RemoveAt(int32 Index)
+{
+	Listeners.RemoveAt(Index, EAllowShrinking::No);
+	Phases.RemoveAt(Index, EAllowShrinking::No);
+	RequiredTagMasks.RemoveAt(Index, EAllowShrinking::No);
+	BlockedTagMasks.RemoveAt(Index, EAllowShrinking::No);
+	IsSpatial.RemoveAt(Index, EAllowShrinking::No);
+	UpdateSpatialListIndices(Index);
+	UpdateListenedPhases();
+}
+
+void FOGTriggerEngine::FOGTriggerListenerSnapshot::UpdateSpatialListIndices(int32 FirstIndex)
+{
+	//Dispatch maps the listeners found by the spatial grid back to their position through these
+	for (int32 Index = FirstIndex; Index < Listeners.Num(); ++Index)
+	{
+		if (IsSpatial[Index])
+		{
+			Listeners[Index]->SpatialListIndex = Index;
+		}
+	}
+}
+
+void FOGTriggerEngine::FOGTriggerListenerSnapshot::UpdateListenedPhases()
+{
+	ListenedPhases = EOGTriggerListenerPhases::None;
+	for (const EOGTriggerListenerPhases Phase : Phases)
+	{
+		ListenedPhases |= Phase;
+	}
+}
+
+void FOGTriggerEngine::FOGTriggerListenerSnapshot::Shrink()
+{
+	Listeners.Shrink();
+	Phases.Shrink();
+	RequiredTagMasks.Shrink();
+	BlockedTagMasks.Shrink();
+	IsSpatial.Shrink();
+}
+
+void FOGTriggerEngine::FOGTriggerListenerSnapshot::FindCandidates(EOGTriggerListenerPhases TriggerPhase, const FOGTriggerTagSet& TriggerTags,
+	bool bTriggerHasLocation, TBitArray<TInlineAllocator<4>>& OutCandidates) const
+{
+	const int32 NumListeners = Listeners.Num();
+	OutCandidates.Init(false, NumListeners);
+	const VectorRegister4Int TriggerBits = VectorIntLoadAligned(TriggerTags.AllMask.Words);
+	//Blocked bits can only be trusted if the trigger's bits didn't collide either
+	const VectorRegister4Int BlockableBits = TriggerTags.IsMaskExact() ? TriggerBits : GlobalVectorConstants::IntZero;
+	for (int32 Index = 0; Index < NumListeners; ++Index)
+	{
+		if (!(Phases[Index] & TriggerPhase) || (bTriggerHasLocation && IsSpatial[Index]))
+			continue;
+		//Any required bit the trigger doesn't have means a required tag is missing, any blocked bit it has means a blocked tag is present
+		const VectorRegister4Int MissingBits = VectorIntAndNot(TriggerBits, VectorIntLoadAligned(RequiredTagMasks[Index].Words));
+		const VectorRegister4Int BlockingBits = VectorIntAnd(BlockableBits, VectorIntLoadAligned(BlockedTagMasks[Index].Words));
+		const VectorRegister4Int RejectingBits = VectorIntOr(MissingBits, BlockingBits);
+		if (VectorMaskBits(VectorCast4IntTo4Float(VectorIntCompareEQ(RejectingBits, GlobalVectorConstants::IntZero))) == 0xF)
+		{
+			OutCandidates[Index] = true;
+		}
+	}
+}
+
+FOGTriggerEngine::FOGTriggerSpatialGrid::FOGTriggerSpatialGrid() :
+	CellSize(FMath::Max(GOGTriggerSpatialCellSize, 1.f))
+{
+}
+
+FIntVector FOGTriggerEngine::FOGTriggerSpatialGrid::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize), FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void FOGTriggerEngine::FOGTriggerSpatialGrid::Add(FOGTriggerListenerData& Listener)
+{
+	Cells.FindOrAdd(GetCell(Listener.Location)).Add(&Listener);
+	if (Listener.TrackedActor.IsValid())
+	{
+		TrackedListeners.Add(&Listener);
+	}
+	MaxListenerRadius = FMath::Max(MaxListenerRadius, Listener.Radius);
+	NumListeners++;
+}
+
+void FOGTriggerEngine::FOGTriggerSpatialGrid::Remove(FOGTriggerListenerData& Listener)
+{
+	const FIntVector Cell = GetCell(Listener.Location);
+	if (FCell* Listeners = Cells.Find(Cell))
+	{
+		Listeners->RemoveSingleSwap(&Listener, EAllowShrinking::No);
+		if (Listeners->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+	TrackedListeners.RemoveSingleSwap(&Listener, EAllowShrinking::No);
+	NumListeners--;
+}
+
+void FOGTriggerEngine::FOGTriggerSpatialGrid::Move(FOGTriggerListenerData& Listener, const FVector& NewLocation)
+{
+	const FIntVector OldCell = GetCell(Listener.Location);
+	const FIntVector NewCell = GetCell(NewLocation);
+	Listener.Location = NewLocation;
+	if (OldCell == NewCell)
+		return;
+	if (FCell* Listeners = Cells.Find(OldCell))
+	{
+		Listeners->RemoveSingleSwap(&Listener, EAllowShrinking::No);
+		if (Listeners->IsEmpty())
+		{
+			Cells.Remove(OldCell);
+		}
+	}
+	Cells.FindOrAdd(NewCell).Add(&Listener);
+}
+
+void FOGTriggerEngine::FOGTriggerSpatialGrid::ForEachListenerNear(const FVector& Location, float Radius, TFunctionRef<void(FOGTriggerListenerData&)> Visitor) const
+{
+	const float Reach = Radius + MaxListenerRadius;
+	const FIntVector MinCell = GetCell(Location - FVector(Reach));
+	const FIntVector MaxCell = GetCell(Location + FVector(Reach));
+	const int64 NumCellsInRange = int64(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1);
+	//Huge radii would visit more empty cells than there are occupied ones
+	if (NumCellsInRange > Cells.Num())
+	{
+		for (const auto& [Cell, Listeners] : Cells)
+		{
+			if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y && Cell.Z >= MinCell.Z && Cell.Z <= MaxCell.Z)
+			{
+				for (FOGTriggerListenerData* Listener : Listeners)
+				{
+					Visitor(*Listener);
+				}
+			}
+		}
+		return;
+	}
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				if (const FCell* Listeners = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					for (FOGTriggerListenerData* Listener : *Listeners)
+					{
+						Visitor(*Listener);
+					}
+				}
+			}
+		}
+	}
+}
+
+SIZE_T FOGTriggerEngine::FOGTriggerSpatialGrid::GetAllocatedSize() const
+{
+	SIZE_T Size = Cells.GetAllocatedSize() + TrackedListeners.GetAllocatedSize();
+	for (const auto& [Cell, Listeners] : Cells)
+	{
+		Size += Listeners.GetAllocatedSize();
+	}
+	return Size;
+}
+
+UOGGameplayTriggerContext* FOGTriggerEngine::MakeGameplayTriggerContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator,
+	UObject* Target)
+{
+	UOGGameplayTriggerContext* NewTrigger = NewObject<UOGGameplayTriggerContext>(GetContextOuter());
+	NewTrigger->TriggerType = TriggerType;
+	NewTrigger->SetTriggerTags(TriggerTags);
+	NewTrigger->InitiatorObject = Initiator;
+	NewTrigger->TargetObject = Target;
+	return NewTrigger;
+}
+
+UOGGameplayTriggerContext* FOGTriggerEngine::GetTriggerContextForUpdate(const FOGGameplayTriggerHandle& Handle)
+{
+	
+	if (!IsEngineHandleValid(Handle))
+		return nullptr;
+
+	for (const FOGPendingTriggerOperation& PendingOperation : OperationQueue)
+	{
+		if (Handle != PendingOperation.Handle)
+			continue;
+		if (!ensureMsgf(!(PendingOperation.Operation & EOGTriggerOperationFlags::Op_RemoveActiveTrigger),TEXT("Trying to update a handle that is pending removal")))
+			return nullptr;
+		if (!!(PendingOperation.Operation & (EOGTriggerOperationFlags::Op_AddActiveTrigger | EOGTriggerOperationFlags::Op_UpdateActiveTrigger)))
+		{
+			ensure(PendingOperation.StoredTriggerContext.IsValid());
+			//Deep copy the stored trigger context and return it so the changes don't interfere with pending/current operations
+			return DuplicateTriggerContext(PendingOperation.StoredTriggerContext.Get());
+		}
+	}
+
+	const TriggerMap* TriggerMap = ActiveTriggersByType.Find(Handle.TriggerType);
+	if (!ensureMsgf(TriggerMap,TEXT("Could not find active trigger for handle")))
+		return nullptr;
+	const TStrongObjectPtr<UOGGameplayTriggerContext>* ContextPtrPtr = TriggerMap->Find(Handle);
+	if (!ensureMsgf(ContextPtrPtr && ContextPtrPtr->IsValid(), TEXT("Could not find active trigger for handle")))
+		return nullptr;
+	//if there is nothing pending on the handle, just return the stored trigger context for in-place modification
+	return ContextPtrPtr->Get();
+}
+
+FOGTriggerListenerHandle FOGTriggerEngine::RegisterTriggerListener(const FGameplayTag& TriggerType, const EOGTriggerListenerPhases Phases,
+                                                                              const FOGTriggerDelegate& Delegate, const UObject* FilterInstigator, const UObject* FilterTarget,
+                                                                              const bool bShouldFireForExistingTriggers, const TArray<UOGGameplayTriggerFilter*>& Filters,
+                                                                              TOGFuture<void>* OutWhenListenerRemoved)
+{
+	FOGTriggerListenerOptions Options;
+	Options.FilterInstigator = FilterInstigator;
+	Options.FilterTarget = FilterTarget;
+	Options.bShouldFireForExistingTriggers = bShouldFireForExistingTriggers;
+	Options.Filters = Filters;
+	return RegisterTriggerListener(TriggerType, Phases, Delegate, Options, OutWhenListenerRemoved);
+}
+
+FOGTriggerListenerHandle FOGTriggerEngine::RegisterTriggerListener(const FGameplayTag& TriggerType, const EOGTriggerListenerPhases Phases,
+                                                                              const FOGTriggerDelegate& Delegate, const FOGTriggerListenerOptions& Options,
+                                                                              TOGFuture<void>* OutWhenListenerRemoved)
+{
+	if (!ensure(Delegate.IsBound()) || !IsDelegateAllowedToRunOn(Delegate, Options.RunOn))
+		return FOGHandleBase::EmptyHandle<FOGTriggerListenerHandle>();
+	return RegisterTriggerListener_Internal(MakeListenerData(TriggerType, Phases, Delegate, Options), Options, OutWhenListenerRemoved);
+}
+
+FOGTriggerListenerHandle FOGTriggerEngine::RegisterTriggerListener(const FGameplayTagContainer& TriggerTypes, const EOGTriggerListenerPhases Phases,
+	const FOGTriggerDelegate& Delegate, const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved)
+{
+	if (!ensure(Delegate.IsBound()) || !ensureMsgf(TriggerTypes.IsValid(), TEXT("Tried to register a listener without any trigger type"))
+		|| !IsDelegateAllowedToRunOn(Delegate, Options.RunOn))
+		return FOGHandleBase::EmptyHandle<FOGTriggerListenerHandle>();
+	if (!ensureMsgf(!Options.TrackedActor && !Options.Location.IsSet(), TEXT("Spatial listeners are indexed per trigger type, they can only listen to a single type")))
+		return FOGHandleBase::EmptyHandle<FOGTriggerListenerHandle>();
+
+	const TArray<FGameplayTag>& Types = TriggerTypes.GetGameplayTagArray();
+	const TSharedRef<FOGTriggerListenerData> ListenerData = MakeListenerData(Types[0], Phases, Delegate, Options);
+	ListenerData->AdditionalTriggerTypes.Append(Types.GetData() + 1, Types.Num() - 1);
+	return RegisterTriggerListener_Internal(ListenerData, Options, OutWhenListenerRemoved);
+}
+
+bool FOGTriggerEngine::IsDelegateAllowedToRunOn(const FOGTriggerDelegate& Delegate, EOGTriggerRunOn RunOn)
+{
+	//Executing a UObject delegate resolves its weak object pointer, which is only safe on the game thread
+	return ensureMsgf(RunOn == EOGTriggerRunOn::GameThread || !Delegate.GetUObject(),
+		TEXT("AnyThread listeners can't be bound to a UObject, bind a raw, shared pointer or static callback instead"));
+}
+
+TSharedRef<FOGTriggerListenerData> FOGTriggerEngine::MakeListenerData(const FGameplayTag& TriggerType, const EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
+	const FOGTriggerListenerOptions& Options)
+{
+	const TSharedRef<FOGTriggerListenerData> ListenerData = MakeShared<FOGTriggerListenerData>(TriggerType, Phases, Delegate, Options);
+	if (Options.RunOn == EOGTriggerRunOn::AnyThread)
+	{
+		ListenerData->AnyThreadDispatch = [Delegate](const FOGGameplayTriggerHandle& TriggerHandle, EOGTriggerListenerPhases TriggerPhase, const FOGFrozenTriggerContextPtr& FrozenContext)
+		{
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Delegate, TriggerHandle, TriggerPhase, FrozenContext]() mutable
+			{
+				{
+					//Keeps GC from running while the callback reads the frozen context
+					FGCScopeGuard GCGuard;
+					(void)Delegate.ExecuteIfBound(TriggerHandle, TriggerPhase, FrozenContext->Get());
+				}
+				AsyncTask(ENamedThreads::GameThread, [FrozenContext = MoveTemp(FrozenContext)]() {});
+			});
+		};
+	}
+	return ListenerData;
+}
+
+FOGTriggerListenerHandle FOGTriggerEngine::RegisterTriggerListener_Internal(const TSharedRef<FOGTriggerListenerData>& ListenerData, const FOGTriggerListenerOptions& Options,
+	TOGFuture<void>* OutWhenListenerRemoved)
+{
+	ensureMsgf(!Options.bShouldFireForExistingTriggers || !!(ListenerData->ListenerPhases & EOGTriggerListenerPhases::TriggerStart), TEXT("If using bShouldFireForExisitngTriggers, you must respond to TriggerStart"));
+	ensureMsgf(Options.RunOn == EOGTriggerRunOn::GameThread || !Options.bDeferrable, TEXT("AnyThread listeners never block dispatch, they can't also be deferrable"));
+
+	FOGTriggerListenerHandle Handle = CreateNewListenerHandle(ListenerData->TriggerType);
+	ListenerData->Handle = Handle;
+	if (ListenerData->Group.FOGHandleBase::IsValid())
+	{
+		TArray<FGameplayTag, TInlineAllocator<4>>* GroupTypes = ListenerGroups.Find(ListenerData->Group);
+		if (ensureMsgf(GroupTypes, TEXT("Listener group has already been removed, the listener is registered without a group")))
+		{
+			ListenerData->ForEachTriggerType([GroupTypes](const FGameplayTag& TriggerType) { GroupTypes->AddUnique(TriggerType); });
+		}
+		else
+		{
+			ListenerData->Group = FOGHandleBase::EmptyHandle<FOGTriggerListenerGroupHandle>();
+		}
+	}
+	if (OutWhenListenerRemoved)
+	{
+		*OutWhenListenerRemoved = ListenerData->WhenListenerRemoved;
+	}
+
+	//Added before firing for existing triggers, so listeners that remove themselves from their callback (e.g. awaiters) are removed for good
+	AddTriggerListener_Internal(Handle, ListenerData);
+	for (const FObjectKey& BoundObject : {ListenerData->OwnerKey, ListenerData->InstigatorKey, ListenerData->TargetKey, ListenerData->TrackedActorKey})
+	{
+		if (BoundObject != FObjectKey())
+		{
+			ListenerData->ForEachTriggerType([this, &BoundObject](const FGameplayTag& TriggerType) { BindListenerToObject(BoundObject, TriggerType); });
+		}
+	}
+
+	if (Options.bShouldFireForExistingTriggers)
+	{
+		//These callbacks are not part of a dispatch, so they can't consume the trigger that may currently be dispatching
+		TGuardValue<bool> DispatchGuard(bIsDispatchingCallbacks, false);
+		ListenerData->ForEachTriggerType([this, &ListenerData](const FGameplayTag& TriggerType)
+		{
+			TriggerMap* Triggers = ActiveTriggersByType.Find(TriggerType);
+			if (!Triggers)
+				return;
+			for (auto& [TriggerHandle,Trigger] : *Triggers)
+			{
+				bool bIsFilterStale = false;
+				if (ListenerData->IsInRangeOf(Trigger.Get()) && ListenerData->ShouldListenerProcessTrigger(EOGTriggerListenerPhases::TriggerStart, Trigger.Get(), GetClock(), bIsFilterStale))
+				{
+					FOGFrozenTriggerContextPtr FrozenContext;
+					ExecuteListenerCallback(ListenerData, TriggerHandle, EOGTriggerListenerPhases::TriggerStart, Trigger.Get(), FrozenContext);
+				}
+			}
+		});
+	}
+	if (Options.ReplayHistorySince.IsSet())
+	{
+		ReplayTriggerHistory(ListenerData, Options.ReplayHistorySince.GetValue());
+	}
+	
+	return Handle;
+}
+
+TOGFuture<const UOGGameplayTriggerContext*> FOGTriggerEngine::WaitForTrigger(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases,
+	const FOGTriggerListenerOptions& Options, FOGTriggerListenerHandle* OutHandle)
+{
+	ensureMsgf(Options.RunOn == EOGTriggerRunOn::GameThread && !Options.bDeferrable, TEXT("WaitForTrigger is always fulfilled synchronously during dispatch"));
+	
+	TOGFuture<const UOGGameplayTriggerContext*> Future;
+	FOGTriggerListenerHandle Handle;
+	{
+		const TSharedRef<FOGTriggerListenerData> ListenerData = AcquireAwaiterListener();
+		ListenerData->Reinit(TriggerType, Phases, Options);
+		ListenerData->RunOn = EOGTriggerRunOn::GameThread;
+		ListenerData->bDeferrable = false;
+		ListenerData->bIsAwaiter = true;
+		ListenerData->AwaiterPromise = TOGPromise<const UOGGameplayTriggerContext*>();
+		Future = ListenerData->AwaiterPromise;
+		Handle = RegisterTriggerListener_Internal(ListenerData, Options, nullptr);
+	}
+	//An awaiter fulfilled by an existing trigger was retired while this function still held it
+	ReleaseRetiredListeners();
+	if (OutHandle)
+	{
+		*OutHandle = Handle;
+	}
+	return Future;
+}
+
+TSharedRef<FOGTriggerListenerData> FOGTriggerEngine::AcquireAwaiterListener()
+{
+	if (AwaiterPool.IsEmpty())
+		return MakeShared<FOGTriggerListenerData>();
+	return AwaiterPool.Pop(EAllowShrinking::No);
+}
+
+void FOGTriggerEngine::ReleaseListener(const TSharedRef<FOGTriggerListenerData>& Listener)
+{
+	static constexpr int32 MaxPooledAwaiters = 64;
+	
+	if (!Listener->bIsAwaiter || AwaiterPool.Num() + RetiredListeners.Num() >= MaxPooledAwaiters)
+		return;
+	//Only recycle awaiters that nothing else (e.g. a pinned snapshot of the list) can still observe, try again once it has let go
+	if (!Listener.IsUnique())
+	{
+		RetiredListeners.Add(Listener);
+		return;
+	}
+	Listener->AwaiterPromise = TOGPromise<const UOGGameplayTriggerContext*>(nullptr);
+	Listener->FilterObjects.Reset();
+	Listener->OwnerKey = FObjectKey();
+	Listener->InstigatorKey = FObjectKey();
+	Listener->TargetKey = FObjectKey();
+	AwaiterPool.Add(Listener);
+}
+
+void FOGTriggerEngine::RemoveTriggerListener(const FOGTriggerListenerHandle& Handle)
+{
+	if (!IsEngineHandleValid(Handle))
+		return;
+	RemoveTriggerListener_Internal(Handle);
+}
+
+FOGTriggerListenerGroupHandle FOGTriggerEngine::CreateListenerGroup()
+{
+	FOGTriggerListenerGroupHandle Group = FOGHandleBase::GenerateHandle<FOGTriggerListenerGroupHandle>();
+	Group.TriggerSubsystem = Subsystem;
+	ListenerGroups.Add(Group);
+	return Group;
+}
+
+void FOGTriggerEngine::RemoveListenerGroup(const FOGTriggerListenerGroupHandle& Group)
+{
+	TriggerTypeArray GroupTypes;
+	if (!ListenerGroups.RemoveAndCopyValue(Group, GroupTypes))
+		return;
+	RemoveTriggerListeners_Internal(GroupTypes, [&Group](const FOGTriggerListenerData& Listener) { return Listener.Group == Group; });
+}
+
+FOGTriggerTapHandle FOGTriggerEngine::AddTriggerTap(const FOGTriggerDelegate& Delegate, const FOGTriggerTapOptions& Options)
+{
+	if (!ensure(Delegate.IsBound()))
+		return FOGHandleBase::EmptyHandle<FOGTriggerTapHandle>();
+	ensureMsgf(Options.SampleRate > 0.f && Options.SampleRate <= 1.f, TEXT("Trigger tap sample rate %f is outside of (0, 1], it is clamped"), Options.SampleRate);
+
+	FOGTriggerTap& Tap = Taps.AddDefaulted_GetRef();
+	Tap.Handle = FOGHandleBase::GenerateHandle<FOGTriggerTapHandle>();
+	Tap.Handle.TriggerSubsystem = Subsystem;
+	Tap.Callback = Delegate;
+	Tap.Phases = Options.Phases;
+	Tap.SampleRate = FMath::Clamp(Options.SampleRate, 0.f, 1.f);
+	//Sampled taps start with a full call owed, so the first matching trigger is always seen
+	Tap.SampleCredit = 1.f - Tap.SampleRate;
+	TapPhases |= Tap.Phases;
+	return Tap.Handle;
+}
+
+void FOGTriggerEngine::RemoveTriggerTap(const FOGTriggerTapHandle& Handle)
+{
+	const int32 Index = Taps.IndexOfByPredicate([&Handle](const FOGTriggerTap& Tap) { return Tap.Handle == Handle; });
+	if (Index == INDEX_NONE)
+		return;
+	if (bIsDispatchingTaps)
+	{
+		Taps[Index].bIsRemoved = true;
+		bHasRemovedTaps = true;
+	}
+	else
+	{
+		Taps.RemoveAt(Index);
+	}
+	UpdateTapPhases();
+}
+
+void FOGTriggerEngine::UpdateTapPhases()
+{
+	TapPhases = EOGTriggerListenerPhases::None;
+	for (const FOGTriggerTap& Tap : Taps)
+	{
+		if (!Tap.bIsRemoved)
+		{
+			TapPhases |= Tap.Phases;
+		}
+	}
+}
+
+void FOGTriggerEngine::UpdateObservedFlags(const FGameplayTag& TriggerType)
+{
+	const bool bIsObserved = AggregateViewsByType.Contains(TriggerType) || CompositeTriggersByType.Contains(TriggerType);
+	const bool bKeepsHistory = HistoryByType.Contains(TriggerType);
+	FOGTriggerListenerList* Listeners = bIsObserved || bKeepsHistory ? &ListenersByType.FindOrAdd(TriggerType) : ListenersByType.Find(TriggerType);
+	if (Listeners)
+	{
+		Listeners->bIsObserved = bIsObserved;
+		Listeners->bKeepsHistory = bKeepsHistory;
+	}
+}
+
+FOGTriggerAggregateViewHandle FOGTriggerEngine::CreateAggregateView(const FOGTriggerAggregateViewOptions& Options)
+{
+	if (!ensureMsgf(Options.TriggerType.IsValid(), TEXT("Aggregate views need a trigger type"))
+		|| !ensureMsgf(Options.Op == EOGTriggerAggregateOp::Count || Options.Value, TEXT("Sum, Min and Max aggregate views need a value")))
+		return FOGHandleBase::EmptyHandle<FOGTriggerAggregateViewHandle>();
+
+	FOGTriggerAggregateViewHandle Handle = FOGHandleBase::GenerateHandle<FOGTriggerAggregateViewHandle>();
+	Handle.TriggerSubsystem = Subsystem;
+	FOGTriggerAggregateView& View = AggregateViews.Add(Handle);
+	View.TriggerType = Options.TriggerType;
+	View.Op = Options.Op;
+	View.KeyBy = Options.KeyBy;
+	View.Value = Options.Value;
+	AggregateViewsByType.FindOrAdd(Options.TriggerType).Add(Handle);
+	UpdateObservedFlags(Options.TriggerType);
+	if (const TriggerMap* Triggers = ActiveTriggersByType.Find(Options.TriggerType))
+	{
+		for (const auto& [TriggerHandle, Trigger] : *Triggers)
+		{
+			View.Add(TriggerHandle, *Trigger);
+		}
+	}
+	return Handle;
+}
+
+void FOGTriggerEngine::RemoveAggregateView(const FOGTriggerAggregateViewHandle& Handle)
+{
+	FOGTriggerAggregateView View;
+	if (!AggregateViews.RemoveAndCopyValue(Handle, View))
+		return;
+	auto& Views = AggregateViewsByType.FindChecked(View.TriggerType);
+	Views.Remove(Handle);
+	if (Views.IsEmpty())
+	{
+		AggregateViewsByType.Remove(View.TriggerType);
+		UpdateObservedFlags(View.TriggerType);
+	}
+}
+
+double FOGTriggerEngine::ReadAggregateView(const FOGTriggerAggregateViewHandle& Handle, const UObject* Key, double DefaultValue) const
+{
+	const FOGTriggerAggregateView* View = AggregateViews.Find(Handle);
+	if (!View)
+		return DefaultValue;
+	const FOGTriggerAggregateView::FBucket* Bucket = View->Buckets.Find(View->KeyBy == EOGTriggerAggregateKey::None ? FObjectKey() : FObjectKey(Key));
+	switch (View->Op)
+	{
+	case EOGTriggerAggregateOp::Count:
+		return Bucket ? Bucket->Count : 0.0;
+	case EOGTriggerAggregateOp::Sum:
+		return Bucket ? Bucket->Sum : 0.0;
+	case EOGTriggerAggregateOp::Min:
+		return Bucket ? Bucket->Heap.HeapTop() : DefaultValue;
+	case EOGTriggerAggregateOp::Max:
+		return Bucket ? -Bucket->Heap.HeapTop() : DefaultValue;
+	}
+	return DefaultValue;
+}
+
+int32 FOGTriggerEngine::GetAggregateViewCount(const FOGTriggerAggregateViewHandle& Handle, const UObject* Key) const
+{
+	const FOGTriggerAggregateView* View = AggregateViews.Find(Handle);
+	if (!View)
+		return 0;
+	const FOGTriggerAggregateView::FBucket* Bucket = View->Buckets.Find(View->KeyBy == EOGTriggerAggregateKey::None ? FObjectKey() : FObjectKey(Key));
+	return Bucket ? Bucket->Count : 0;
+}
+
+FOGTriggerCompositeHandle FOGTriggerEngine::CreateCompositeTrigger(const FOGTriggerCompositeOptions& Options)
+{
+	const bool bHasValidTerms = !Options.Terms.IsEmpty()
+		&& !Options.Terms.ContainsByPredicate([](const FOGTriggerCompositeTerm& Term) { return !Term.TriggerType.IsValid(); });
+	const bool bHasRequiredTerm = Options.Terms.ContainsByPredicate([](const FOGTriggerCompositeTerm& Term) { return !Term.bNegated; });
+	const bool bFeedsItself = Options.Terms.ContainsByPredicate([&Options](const FOGTriggerCompositeTerm& Term) { return Term.TriggerType == Options.OutputType; });
+	if (!ensureMsgf(Options.OutputType.IsValid() && bHasValidTerms, TEXT("Composite triggers need an output type and at least one term"))
+		|| !ensureMsgf(!bFeedsItself, TEXT("Composite triggers can't have a term on their own output type"))
+		//A keyed composite made only of negated terms would hold for every object that has no trigger at all
+		|| !ensureMsgf(bHasRequiredTerm || Options.KeyBy == EOGTriggerAggregateKey::None, TEXT("Keyed composite triggers need at least one term that isn't negated")))
+		return FOGHandleBase::EmptyHandle<FOGTriggerCompositeHandle>();
+
+	FOGTriggerCompositeHandle Handle = FOGHandleBase::GenerateHandle<FOGTriggerCompositeHandle>();
+	Handle.TriggerSubsystem = Subsystem;
+	FOGTriggerComposite& Composite = CompositeTriggers.Add(Handle);
+	Composite.OutputType = Options.OutputType;
+	Composite.OutputTags = Options.OutputTags;
+	Composite.KeyBy = Options.KeyBy;
+	Composite.Terms = Options.Terms;
+	TArray<FGameplayTag, TInlineAllocator<4>> TermTypes;
+	for (FOGTriggerCompositeTerm& Term : Composite.Terms)
+	{
+		Term.MinCount = FMath::Max(Term.MinCount, 1);
+		TermTypes.AddUnique(Term.TriggerType);
+	}
+	for (const FGameplayTag& TriggerType : TermTypes)
+	{
+		CompositeTriggersByType.FindOrAdd(TriggerType).Add(Handle);
+		UpdateObservedFlags(TriggerType);
+	}
+	if (Composite.KeyBy == EOGTriggerAggregateKey::None)
+	{
+		Composite.States.Add(FObjectKey(), Composite.MakeState(nullptr));
+	}
+
+	//Derived triggers are only queued until the composite is fully seeded
+	const bool bIsOutermost = OperationQueue.IsEmpty();
+	if (bIsOutermost)
+	{
+		BeginOperationBatch();
+	}
+	for (const FGameplayTag& TriggerType : TermTypes)
+	{
+		const TriggerMap* Triggers = ActiveTriggersByType.Find(TriggerType);
+		if (!Triggers)
+			continue;
+		for (const auto& [TriggerHandle, Trigger] : *Triggers)
+		{
+			//An instantaneous trigger being dispatched is in the active triggers, but will never be counted out
+			const bool bIsInstantaneous = Algo::AnyOf(OperationQueue, [&TriggerHandle](const FOGPendingTriggerOperation& Operation)
+			{
+				return Operation.Handle == TriggerHandle && (Operation.Operation & EOGTriggerOperationFlags::InstantaneousTrigger) == EOGTriggerOperationFlags::InstantaneousTrigger;
+			});
+			if (!bIsInstantaneous)
+			{
+				UpdateCompositeTrigger(Composite, TriggerHandle, *Trigger, 1);
+			}
+		}
+	}
+	for (auto& [Key, State] : Composite.States)
+	{
+		EvaluateCompositeState(Composite, State);
+	}
+	if (bIsOutermost)
+	{
+		EndOperationBatch();
+	}
+	return Handle;
+}
+
+void FOGTriggerEngine::RemoveCompositeTrigger(const FOGTriggerCompositeHandle& Handle)
+{
+	FOGTriggerComposite Composite;
+	if (!CompositeTriggers.RemoveAndCopyValue(Handle, Composite))
+		return;
+	for (const FOGTriggerCompositeTerm& Term : Composite.Terms)
+	{
+		TArray<FOGTriggerCompositeHandle, TInlineAllocator<2>>* Composites = CompositeTriggersByType.Find(Term.TriggerType);
+		if (Composites && Composites->Remove(Handle) > 0 && Composites->IsEmpty())
+		{
+			CompositeTriggersByType.Remove(Term.TriggerType);
+			UpdateObservedFlags(Term.TriggerType);
+		}
+	}
+	for (auto& [Key, State] : Composite.States)
+	{
+		if (State.bIsOutputActive && IsTriggerActiveOrPending(State.Output))
+		{
+			EndTrigger(State.Output);
+		}
+	}
+}
+
+bool FOGTriggerEngine::IsCompositeTriggerActive(const FOGTriggerCompositeHandle& Handle, const UObject* Key) const
+{
+	const FOGTriggerComposite* Composite = CompositeTriggers.Find(Handle);
+	if (!Composite)
+		return false;
+	const FOGTriggerComposite::FState* State = Composite->States.Find(Composite->KeyBy == EOGTriggerAggregateKey::None ? FObjectKey() : FObjectKey(Key));
+	return State && State->bIsOutputActive;
+}
+
+void FOGTriggerEngine::ConsumeTrigger()
+{
+	if (!ensureMsgf(bIsDispatchingCallbacks, TEXT("ConsumeTrigger can only be called from inside a trigger listener callback")))
+		return;
+	bIsTriggerConsumed = true;
+}
+
+void FOGTriggerEngine::RegisterTriggerCoalescing(const FGameplayTag& TriggerType, const FOGTriggerMergeDelegate& Merge)
+{
+	CoalescingMergeByType.Add(TriggerType, Merge);
+}
+
+void FOGTriggerEngine::UnregisterTriggerCoalescing(const FGameplayTag& TriggerType)
+{
+	if (!PendingCoalescedTriggers.IsEmpty())
+	{
+		FlushCoalescedTriggers();
+	}
+	CoalescingMergeByType.Remove(TriggerType);
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::CoalesceInstantaneousTrigger(UOGGameplayTriggerContext* TriggerContext)
+{
+	const FOGTriggerMergeDelegate* Merge = CoalescingMergeByType.Find(TriggerContext->TriggerType);
+	if (!Merge)
+		return FOGGameplayTriggerHandle();
+
+	const FOGTriggerCoalescingKey Key{TriggerContext->TriggerType, FObjectKey(TriggerContext->InitiatorObject), FObjectKey(TriggerContext->TargetObject)};
+	if (const int32* Index = PendingCoalescedIndices.Find(Key))
+	{
+		const FOGCoalescedTrigger& Pending = PendingCoalescedTriggers[*Index];
+		(void)Merge->ExecuteIfBound(Pending.Context.Get(), TriggerContext);
+		return Pending.Handle;
+	}
+	const FOGGameplayTriggerHandle Handle = CreateNewTriggerHandle(TriggerContext->TriggerType);
+	PendingCoalescedIndices.Add(Key, PendingCoalescedTriggers.Num());
+	PendingCoalescedTriggers.Add({Handle, TStrongObjectPtr(TriggerContext)});
+	return Handle;
+}
+
+void FOGTriggerEngine::FlushCoalescedTriggers()
+{
+	if (PendingCoalescedTriggers.IsEmpty())
+		return;
+	//Triggers coalesced by the listeners of this flush wait for the next one
+	TArray<FOGCoalescedTrigger> Pending = MoveTemp(PendingCoalescedTriggers);
+	PendingCoalescedTriggers.Reset();
+	PendingCoalescedIndices.Reset();
+
+	const bool bIsNested = !OperationQueue.IsEmpty();
+	if (!bIsNested)
+	{
+		BeginOperationBatch();
+	}
+	for (const FOGCoalescedTrigger& Trigger : Pending)
+	{
+		EnqueueOperation(FOGPendingTriggerOperation(Trigger.Handle, EOGTriggerOperationFlags::InstantaneousTrigger, Trigger.Context.Get()));
+	}
+	if (!bIsNested)
+	{
+		EndOperationBatch();
+	}
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::InstantaneousTrigger(UOGGameplayTriggerContext* TriggerContext)
+{
+	const FOGGameplayTriggerHandle CoalescedHandle = CoalesceInstantaneousTrigger(TriggerContext);
+	if (IsEngineHandleValid(CoalescedHandle))
+		return CoalescedHandle;
+	return StartTrigger_Internal(TriggerContext, EOGTriggerOperationFlags::InstantaneousTrigger);
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::InstantaneousTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags,
+	UObject* Initiator, UObject* Target)
+{
+	return InstantaneousTrigger(MakeGameplayTriggerContext(TriggerType, TriggerTags, Initiator, Target));
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::StartTrigger(UOGGameplayTriggerContext* TriggerContext)
+{
+	return StartTrigger_Internal(TriggerContext, EOGTriggerOperationFlags::OpenTrigger);
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::StartTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator,
+	UObject* Target)
+{
+	return StartTrigger_Internal(MakeGameplayTriggerContext(TriggerType, TriggerTags, Initiator, Target), EOGTriggerOperationFlags::OpenTrigger);
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::StartTrigger(UOGGameplayTriggerContext* TriggerContext, const FOGTriggerStartOptions& Options)
+{
+	const FOGGameplayTriggerHandle Handle = StartTrigger_Internal(TriggerContext, EOGTriggerOperationFlags::OpenTrigger);
+	if (Options.Duration <= 0.f && Options.UpdateInterval <= 0.f)
+		return Handle;
+	//A listener may have ended the trigger while it was being started
+	if (!IsTriggerActiveOrPending(Handle))
+		return Handle;
+
+	const double StartTime = TimerWheel.GetTime();
+	ScheduleTriggerTimers(Handle, Options.Duration > 0.f ? StartTime + Options.Duration : -1.0, Options.UpdateInterval, StartTime + Options.UpdateInterval);
+	return Handle;
+}
+
+void FOGTriggerEngine::ScheduleTriggerTimers(const FOGGameplayTriggerHandle& Handle, double EndTime, float UpdateInterval, double NextUpdateTime)
+{
+	FOGTriggerTimerState& TimerState = TriggerTimers.Add(Handle);
+	TimerState.Serial = ++NextTimerSerial;
+	TimerState.UpdateInterval = UpdateInterval;
+	TimerState.EndTime = EndTime;
+	TimerState.NextUpdateTime = NextUpdateTime;
+	if (EndTime >= 0.0)
+	{
+		TimerWheel.Schedule({Handle, TimerState.Serial, false}, EndTime);
+	}
+	if (UpdateInterval > 0.f && (EndTime < 0.0 || NextUpdateTime < EndTime))
+	{
+		TimerWheel.Schedule({Handle, TimerState.Serial, true}, NextUpdateTime);
+	}
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::StartTimedTrigger(UOGGameplayTriggerContext* TriggerContext, float Duration, float UpdateInterval)
+{
+	FOGTriggerStartOptions Options;
+	Options.Duration = Duration;
+	Options.UpdateInterval = UpdateInterval;
+	return StartTrigger(TriggerContext, Options);
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::StartTimedTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, float Duration,
+	float UpdateInterval, UObject* Initiator, UObject* Target)
+{
+	return StartTimedTrigger(MakeGameplayTriggerContext(TriggerType, TriggerTags, Initiator, Target), Duration, UpdateInterval);
+}
+
+void FOGTriggerEngine::UpdateTrigger(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* UpdatedTriggerContext)
+{
+	const FOGPendingTriggerOperation Operation(Handle, EOGTriggerOperationFlags::UpdateTrigger, UpdatedTriggerContext);
+	EnqueueAndProcessOperation(Operation);
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::StartTrigger_Internal(UOGGameplayTriggerContext* TriggerContext, EOGTriggerOperationFlags Operations)
+{
+	FOGGameplayTriggerHandle Handle = CreateNewTriggerHandle(TriggerContext->TriggerType);
+	const FOGPendingTriggerOperation Operation(Handle, Operations, TriggerContext);
+	EnqueueAndProcessOperation(Operation);
+	return Handle;
+}
+
+UObject* FOGTriggerEngine::GetContextOuter() const
+{
+	return Subsystem ? static_cast<UObject*>(Subsystem) : GetTransientPackage();
+}
+
+UOGGameplayTriggerContext* FOGTriggerEngine::DuplicateTriggerContext(const UOGGameplayTriggerContext* TriggerContext)
+{
+	return NewObject<UOGGameplayTriggerContext>(GetContextOuter(), TriggerContext->GetClass(), NAME_None, RF_NoFlags, const_cast<UOGGameplayTriggerContext*>(TriggerContext));
+}
+
+FOGTriggerListenerHandle FOGTriggerEngine::CreateNewListenerHandle(const FGameplayTag& TriggerType)
+{
+	FOGTriggerListenerHandle Handle = FOGHandleBase::GenerateHandle<FOGTriggerListenerHandle>();
+	Handle.TriggerType = TriggerType;
+	Handle.TriggerSubsystem = Subsystem;
+	return Handle;
+}
+
+FOGGameplayTriggerHandle FOGTriggerEngine::CreateNewTriggerHandle(const FGameplayTag& TriggerType)
+{
+	FOGGameplayTriggerHandle Handle = FOGHandleBase::GenerateHandle<FOGGameplayTriggerHandle>();
+	Handle.TriggerType = TriggerType;
+	Handle.TriggerSubsystem = Subsystem;
+	return Handle;
+}
+
+void FOGTriggerEngine::EndTrigger(const FOGGameplayTriggerHandle& Handle)
+{
+	const FOGPendingTriggerOperation Operation(Handle, EOGTriggerOperationFlags::CloseTrigger);
+	EnqueueAndProcessOperation(Operation);
+}
+
+bool FOGTriggerEngine::IsTriggerActive(const FOGGameplayTriggerHandle& Handle)
+{
+	if (!IsEngineHandleValid(Handle))
+		return false;
+	const TriggerMap* TriggerMap = ActiveTriggersByType.Find(Handle.TriggerType);
+	if (!TriggerMap)
+		return false;
+	return TriggerMap->Contains(Handle);
+}
+
+bool FOGTriggerEngine::IsTriggerActiveOrPending(const FOGGameplayTriggerHandle& Handle)
+{
+	for (const FOGPendingTriggerOperation& PendingOperation : OperationQueue)
+	{
+		if (Handle != PendingOperation.Handle)
+			continue;
+		if (!!(PendingOperation.Operation & EOGTriggerOperationFlags::Op_RemoveActiveTrigger))
+			return false;
+		if (!!(PendingOperation.Operation & (EOGTriggerOperationFlags::Op_AddActiveTrigger | EOGTriggerOperationFlags::Op_UpdateActiveTrigger)))
+		{
+			return true;
+		}
+	}
+	return IsTriggerActive(Handle);
+}
+
+bool FOGTriggerEngine::IsListenerHandleValid(const FOGTriggerListenerHandle& Handle)
+{
+	// Registration and removal are applied immediately, so it's valid iff we can find it in the current Listeners list
+	const FOGTriggerListenerList* Listeners = ListenersByType.Find(Handle.TriggerType);
+	if (!Listeners)
+		return false;
+	return Listeners->Get().ContainsByPredicate([&Handle](const TSharedRef<FOGTriggerListenerData>& Listener) { return Listener->Handle == Handle; });
+}
+
+bool FOGTriggerEngine::SaveActiveTriggers(TArray<uint8>& OutBytes) const
+{
+	if (!ensureMsgf(OperationQueue.IsEmpty(), TEXT("Cannot snapshot active triggers while trigger operations are being processed")))
+		return false;
+
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes, true);
+	//Object references are written as path names so they can be resolved again in the world being restored into
+	FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+
+	uint32 Magic = OGGameplayTriggerSnapshot::Magic;
+	int32 Version = int32(OGGameplayTriggerSnapshot::EVersion::Latest);
+	int32 NumTriggers = 0;
+	for (const auto& [TriggerType, Triggers] : ActiveTriggersByType)
+	{
+		NumTriggers += Triggers.Num();
+	}
+	Ar << Magic;
+	Ar << Version;
+	Ar << NumTriggers;
+
+	for (const auto& [TriggerType, Triggers] : ActiveTriggersByType)
+	{
+		for (const auto& [Handle, Trigger] : Triggers)
+		{
+			FOGGameplayTriggerHandle HandleToWrite = Handle;
+			FOGGameplayTriggerHandle::StaticStruct()->SerializeBin(Ar, &HandleToWrite);
+			
+			UObject* ContextClass = Trigger->GetClass();
+			Ar << ContextClass;
+			Trigger->GetClass()->SerializeBin(Ar, Trigger.Get());
+			Ar << Trigger->bHasLocation;
+			Ar << Trigger->Location;
+			Ar << Trigger->Radius;
+
+			//Timers are stored relative to the wheel, the wheel of the engine restoring them has its own time
+			const FOGTriggerTimerState* TimerState = TriggerTimers.Find(Handle);
+			bool bIsTimed = TimerState != nullptr;
+			double RemainingDuration = TimerState && TimerState->EndTime >= 0.0 ? TimerState->EndTime - TimerWheel.GetTime() : -1.0;
+			float UpdateInterval = TimerState ? TimerState->UpdateInterval : 0.f;
+			double UntilNextUpdate = TimerState ? TimerState->NextUpdateTime - TimerWheel.GetTime() : 0.0;
+			Ar << bIsTimed;
+			if (bIsTimed)
+			{
+				Ar << RemainingDuration;
+				Ar << UpdateInterval;
+				Ar << UntilNextUpdate;
+			}
+		}
+	}
+	return !Ar.IsError();
+}
+
+bool FOGTriggerEngine::RestoreActiveTriggers(const TArray<uint8>& Bytes, EOGTriggerRestoreMode RestoreMode,
+	TMap<FOGGameplayTriggerHandle, FOGGameplayTriggerHandle>* OutRestoredHandles)
+{
+	if (!ensureMsgf(OperationQueue.IsEmpty(), TEXT("Cannot restore active triggers while trigger operations are being processed")))
+		return false;
+
+	FMemoryReader Reader(Bytes, true);
+	FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumTriggers = 0;
+	Ar << Magic;
+	Ar << Version;
+	Ar << NumTriggers;
+	if (!ensureMsgf(!Ar.IsError() && Magic == OGGameplayTriggerSnapshot::Magic, TEXT("Data is not a gameplay trigger snapshot")))
+		return false;
+	if (!ensureMsgf(Version >= int32(OGGameplayTriggerSnapshot::EVersion::Initial) && Version <= int32(OGGameplayTriggerSnapshot::EVersion::Latest),
+		TEXT("Unsupported gameplay trigger snapshot version %d"), Version))
+		return false;
+	//Every trigger takes at least a byte, so a count the remaining bytes can't hold is corrupted, and is rejected before anything is allocated for it
+	if (!ensureMsgf(NumTriggers >= 0 && NumTriggers <= Ar.TotalSize() - Ar.Tell(), TEXT("Gameplay trigger snapshot is malformed, it can't hold %d triggers"), NumTriggers))
+		return false;
+
+	//Read the whole snapshot before touching the tables so a malformed snapshot doesn't leave a partial restore behind
+	struct FRestoredTrigger
+	{
+		FOGGameplayTriggerHandle SavedHandle;
+		UOGGameplayTriggerContext* Trigger = nullptr;
+		bool bIsTimed = false;
+		double RemainingDuration = -1.0;
+		float UpdateInterval = 0.f;
+		double UntilNextUpdate = 0.0;
+	};
+	TArray<FRestoredTrigger> RestoredTriggers;
+	RestoredTriggers.Reserve(NumTriggers);
+	for (int32 i = 0; i < NumTriggers; ++i)
+	{
+		FRestoredTrigger& Restored = RestoredTriggers.AddDefaulted_GetRef();
+		FOGGameplayTriggerHandle& SavedHandle = Restored.SavedHandle;
+		FOGGameplayTriggerHandle::StaticStruct()->SerializeBin(Ar, &SavedHandle);
+		SavedHandle.TriggerSubsystem = Subsystem;
+
+		UObject* ContextClassObject = nullptr;
+		Ar << ContextClassObject;
+		if (!ensureMsgf(!Ar.IsError(), TEXT("Gameplay trigger snapshot is malformed")))
+			return false;
+		UClass* ContextClass = Cast<UClass>(ContextClassObject);
+		if (!ensureMsgf(ContextClass && ContextClass->IsChildOf<UOGGameplayTriggerContext>(), TEXT("Could not resolve trigger context class in snapshot")))
+			return false;
+
+		UOGGameplayTriggerContext* Trigger = NewObject<UOGGameplayTriggerContext>(GetContextOuter(), ContextClass);
+		Restored.Trigger = Trigger;
+		ContextClass->SerializeBin(Ar, Trigger);
+		if (Version >= int32(OGGameplayTriggerSnapshot::EVersion::TriggerLocation))
+		{
+			Ar << Trigger->bHasLocation;
+			Ar << Trigger->Location;
+			Ar << Trigger->Radius;
+		}
+		if (Version >= int32(OGGameplayTriggerSnapshot::EVersion::TriggerTimers))
+		{
+			Ar << Restored.bIsTimed;
+			if (Restored.bIsTimed)
+			{
+				Ar << Restored.RemainingDuration;
+				Ar << Restored.UpdateInterval;
+				Ar << Restored.UntilNextUpdate;
+			}
+		}
+		if (!ensureMsgf(!Ar.IsError() && IsEngineHandleValid(SavedHandle) && Trigger->TriggerType == SavedHandle.TriggerType, TEXT("Gameplay trigger snapshot is malformed")))
+			return false;
+	}
+
+	//Triggers derived by composites from the restored triggers are queued behind the restore
+	BeginOperationBatch();
+	for (const FRestoredTrigger& Restored : RestoredTriggers)
+	{
+		UOGGameplayTriggerContext* Trigger = Restored.Trigger;
+		const FOGGameplayTriggerHandle Handle = CreateNewTriggerHandle(Trigger->TriggerType);
+		if (OutRestoredHandles)
+		{
+			OutRestoredHandles->Add(Restored.SavedHandle, Handle);
+		}
+		if (RestoreMode == EOGTriggerRestoreMode::FireTriggerStart)
+		{
+			//Same operation as StartTrigger, so listeners, taps, aggregate views and composites all see the restored trigger start
+			EnqueueOperation(FOGPendingTriggerOperation(Handle, EOGTriggerOperationFlags::OpenTrigger, Trigger));
+		}
+		else
+		{
+			AddActiveTrigger_Internal(Handle, Trigger);
+			UpdateCompositeTriggers(Handle, *Trigger, 1);
+		}
+		//Scheduled while the batch is held, a listener ending the trigger during the batch also cancels its timers
+		if (Restored.bIsTimed)
+		{
+			const double Now = TimerWheel.GetTime();
+			ScheduleTriggerTimers(Handle, Restored.RemainingDuration >= 0.0 ? Now + FMath::Max(Restored.RemainingDuration, 0.0) : -1.0, Restored.UpdateInterval,
+				Now + FMath::Max(Restored.UntilNextUpdate, 0.0));
+		}
+	}
+	EndOperationBatch();
+	return true;
+}
+
+FOGTriggerEngine::FOGTriggerEngine(UOGGameplayTriggerSubsystem* InSubsystem) :
+	Subsystem(InSubsystem)
+{
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FOGTriggerEngine::HandlePostGarbageCollect);
+}
+
+FOGTriggerEngine::~FOGTriggerEngine()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+}
+
+void FOGTriggerEngine::Reset()
+{
+	if (OnActorUnbound)
+	{
+		for (const auto& [BoundObject, TriggerTypes] : ListenerTypesByBoundObject)
+		{
+			if (AActor* Actor = Cast<AActor>(BoundObject.ResolveObjectPtr()))
+			{
+				OnActorUnbound(Actor);
+			}
+		}
+	}
+	ListenerTypesByBoundObject.Empty();
+	IdleListenerTypes.Empty();
+	IdleTriggerTypes.Empty();
+	MemoryStats.NumListeners = 0;
+	MemoryStats.NumActiveTriggers = 0;
+	ReplicatedTriggers.Empty();
+	ActiveTriggersByType.Empty();
+	ListenersByType.Empty();
+	SpatialGridsByType.Empty();
+	ListenerGroups.Empty();
+	OperationQueue.Empty();
+	DeferredCallbacks.Empty();
+	TriggerTimers.Empty();
+	TimerWheel.Reset();
+	CoalescingMergeByType.Empty();
+	PendingCoalescedTriggers.Empty();
+	PendingCoalescedIndices.Empty();
+	HistoryByType.Empty();
+	Taps.Empty();
+	TapPhases = EOGTriggerListenerPhases::None;
+	bHasRemovedTaps = false;
+	AggregateViews.Empty();
+	AggregateViewsByType.Empty();
+	CompositeTriggers.Empty();
+	CompositeTriggersByType.Empty();
+	AwaiterPool.Empty();
+	RetiredListeners.Empty();
+}
+
+void FOGTriggerEngine::Tick(float DeltaTime)
+{
+	EngineFrame++;
+	UpdateTrackedListeners();
+	ProcessTriggerTimers(DeltaTime);
+	FlushCoalescedTriggers();
+	ProcessDeferredCallbacks();
+	SweepStaleListeners();
+	ReleaseRetiredListeners();
+
+	if (GOGTriggerTrimIdleSeconds > 0.f)
+	{
+		TimeSinceTrim += DeltaTime;
+		if (TimeSinceTrim >= GOGTriggerTrimIdleSeconds)
+		{
+			TrimTables();
+		}
+	}
+	OnTicked.Broadcast();
+}
+
+void FOGTriggerEngine::TrimTables()
+{
+	if (!ensureMsgf(OperationQueue.IsEmpty(), TEXT("Cannot trim trigger tables while trigger operations are being processed")))
+		return;
+	TimeSinceTrim = 0.f;
+
+	//Arrays and sparse maps only give memory back when told to, oversized means more than twice the slots that are in use
+	auto IsOversized = [](int32 Num, int32 Max) { return Max > 8 && Max > 2 * Num; };
+	TSet<FGameplayTag> NewIdleListenerTypes;
+	TSet<FGameplayTag> NewIdleTriggerTypes;
+	int32 NumTrimmedTables = 0;
+
+	for (auto It = ListenersByType.CreateIterator(); It; ++It)
+	{
+		const FOGTriggerListenerSnapshot& Listeners = It->Value.Get();
+		//Lists of observed types carry the flags HasListeners reads, so they are kept even when empty
+		const bool bIsKept = !Listeners.IsEmpty() || It->Value.bIsObserved || It->Value.bKeepsHistory;
+		if (bIsKept && !IsOversized(Listeners.Num(), Listeners.Max()))
+			continue;
+		if (!IdleListenerTypes.Contains(It->Key))
+		{
+			NewIdleListenerTypes.Add(It->Key);
+			continue;
+		}
+		NumTrimmedTables++;
+		if (!bIsKept)
+		{
+			It.RemoveCurrent();
+		}
+		else
+		{
+			It->Value.Edit().Shrink();
+		}
+	}
+	for (auto It = ActiveTriggersByType.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsEmpty() && !IsOversized(It->Value.Num(), It->Value.GetMaxIndex()))
+			continue;
+		if (!IdleTriggerTypes.Contains(It->Key))
+		{
+			NewIdleTriggerTypes.Add(It->Key);
+			continue;
+		}
+		NumTrimmedTables++;
+		if (It->Value.IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+		else
+		{
+			It->Value.Compact();
+			It->Value.Shrink();
+		}
+	}
+	if (NumTrimmedTables > 0)
+	{
+		ListenersByType.Compact();
+		ListenersByType.Shrink();
+		ActiveTriggersByType.Compact();
+		ActiveTriggersByType.Shrink();
+	}
+	IdleListenerTypes = MoveTemp(NewIdleListenerTypes);
+	IdleTriggerTypes = MoveTemp(NewIdleTriggerTypes);
+
+	MemoryStats.NumTrimmedTables += NumTrimmedTables;
+	MemoryStats.AllocatedBytes = GetTablesAllocatedSize();
+	MemoryStats.PeakAllocatedBytes = FMath::Max(MemoryStats.PeakAllocatedBytes, MemoryStats.AllocatedBytes);
+	UE_CLOG(NumTrimmedTables > 0, LogOGGameplayTrigger, Verbose, TEXT("Trimmed %d idle trigger tables, %llu bytes allocated (peak %llu)"),
+		NumTrimmedTables, uint64(MemoryStats.AllocatedBytes), uint64(MemoryStats.PeakAllocatedBytes));
+}
+
+SIZE_T FOGTriggerEngine::GetTablesAllocatedSize() const
+{
+	SIZE_T Size = ListenersByType.GetAllocatedSize() + ActiveTriggersByType.GetAllocatedSize();
+	for (const auto& [TriggerType, Listeners] : ListenersByType)
+	{
+		Size += Listeners.Get().GetAllocatedSize();
+		for (const TSharedRef<FOGTriggerListenerData>& Listener : Listeners.Get())
+		{
+			//Listeners of several types are counted once, with their primary type
+			if (Listener->TriggerType == TriggerType)
+			{
+				Size += sizeof(FOGTriggerListenerData) + Listener->FilterObjects.GetAllocatedSize() + Listener->AdditionalTriggerTypes.GetAllocatedSize();
+			}
+		}
+	}
+	for (const auto& [TriggerType, Triggers] : ActiveTriggersByType)
+	{
+		Size += Triggers.GetAllocatedSize();
+	}
+	Size += HistoryByType.GetAllocatedSize();
+	for (const auto& [TriggerType, History] : HistoryByType)
+	{
+		Size += History.Entries.GetAllocatedSize();
+	}
+	Size += Taps.GetAllocatedSize();
+	Size += AggregateViews.GetAllocatedSize() + AggregateViewsByType.GetAllocatedSize();
+	for (const auto& [ViewHandle, View] : AggregateViews)
+	{
+		Size += View.Buckets.GetAllocatedSize() + View.Contributions.GetAllocatedSize();
+	}
+	Size += CompositeTriggers.GetAllocatedSize() + CompositeTriggersByType.GetAllocatedSize();
+	for (const auto& [CompositeHandle, Composite] : CompositeTriggers)
+	{
+		Size += Composite.Terms.GetAllocatedSize() + Composite.States.GetAllocatedSize() + Composite.TriggerKeys.GetAllocatedSize();
+	}
+	Size += SpatialGridsByType.GetAllocatedSize();
+	for (const auto& [TriggerType, Grid] : SpatialGridsByType)
+	{
+		Size += Grid.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FOGTriggerEngine::EnqueueAndProcessOperation(const FOGPendingTriggerOperation& Operation)
+{
+	const bool bShouldProcess = OperationQueue.IsEmpty();
+	EnqueueOperation(Operation);
+	if (!bShouldProcess)
+		return;
+
+	ProcessOperationQueue();
+}
+
+void FOGTriggerEngine::ProcessOperationQueue()
+{
+	FOGPendingTriggerOperation* CurrentOperation;
+	while (PeekOperation(CurrentOperation))
+	{
+        ProcessTriggerOperation(*CurrentOperation);
+		
+		PopOperation();
+	}
+}
+
+void FOGTriggerEngine::BeginOperationBatch()
+{
+	ensureMsgf(OperationQueue.IsEmpty(), TEXT("Operation batches cannot be nested inside trigger processing"));
+	//An empty operation at the tail of the queue makes any operation raised during the batch wait behind it
+	EnqueueOperation(FOGPendingTriggerOperation());
+}
+
+void FOGTriggerEngine::EndOperationBatch()
+{
+	PopOperation();
+	ProcessOperationQueue();
+}
+
+void FOGTriggerEngine::ProcessTriggerOperation(const FOGPendingTriggerOperation& TriggerOperation)
+{
+	UOGGameplayTriggerContext* TriggerContext;
+
+	if (!!(TriggerOperation.Operation & EOGTriggerOperationFlags::Op_AddActiveTrigger))
+	{
+		TriggerContext = TriggerOperation.StoredTriggerContext.Get();
+		AddActiveTrigger_Internal(TriggerOperation.Handle, TriggerContext);
+		//Instantaneous triggers are never active long enough to flip a composite
+		if (!(TriggerOperation.Operation & EOGTriggerOperationFlags::Op_RemoveActiveTrigger))
+		{
+			UpdateCompositeTriggers(TriggerOperation.Handle, *TriggerContext, 1);
+		}
+	}
+	else if (!!(TriggerOperation.Operation & EOGTriggerOperationFlags::Op_UpdateActiveTrigger))
+	{
+		TriggerContext = TriggerOperation.StoredTriggerContext.Get();
+		UpdateActiveTrigger_Internal(TriggerOperation.Handle, TriggerContext);
+	}
+	else
+	{
+		TriggerContext = ActiveTriggersByType.FindChecked(TriggerOperation.Handle.TriggerType).FindChecked(TriggerOperation.Handle).Get();
+	}
+	
+	if (!!(TriggerOperation.Operation & EOGTriggerOperationFlags::Op_ProcessCallbacks))
+	{
+		const EOGTriggerListenerPhases TriggerPhase = EOGTriggerListenerPhases(uint8(TriggerOperation.Operation) & uint8(EOGTriggerListenerPhases::All));
+		ProcessTriggerCallbacks(TriggerOperation.Handle, TriggerPhase, TriggerContext);
+		ProcessTriggerTaps(TriggerOperation.Handle, TriggerPhase, TriggerContext);
+	}
+	if (!!(TriggerOperation.Operation & EOGTriggerOperationFlags::Op_NetworkRPC))
+	{
+		//TODO: replicate via RPC, necessary for networked instantaneous triggers since they will never stay in the array long enough to replicate by value
+		//Caution! I believe you can only fire a reliable RPC once per net update, so if there are multiple instantaneous networked triggers at once it will likely cause problems.
+		//I could batch the triggers but that gets to be a lot of extra work to support networked gameplay triggers, especially if I try to maintain trigger order.
+		//I do want to support networked persistent triggers though
+	}
+	if (!!(TriggerOperation.Operation & EOGTriggerOperationFlags::Op_RemoveActiveTrigger))
+	{
+		if ((TriggerOperation.Operation & EOGTriggerOperationFlags::InstantaneousTrigger) == EOGTriggerOperationFlags::InstantaneousTrigger)
+		{
+			RecordTriggerHistory(TriggerOperation.Handle, TriggerContext);
+		}
+		else
+		{
+			UpdateCompositeTriggers(TriggerOperation.Handle, *TriggerContext, -1);
+		}
+		RemoveActiveTrigger_Internal(TriggerOperation.Handle);
+	}
+}
+
+void FOGTriggerEngine::ProcessTriggerCallbacks(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases TriggerPhase, UOGGameplayTriggerContext* TriggerContext)
+{
+	const FOGTriggerListenerList* Listeners = ListenersByType.Find(TriggerContext->TriggerType);
+	if (!Listeners)
+		return;
+
+	{
+		//Listeners registered or removed by callbacks edit a copy of the list, this dispatch keeps iterating the snapshot it started with
+		const TSharedRef<const FOGTriggerListenerSnapshot> Snapshot = Listeners->Pin();
+		TGuardValue<bool> DispatchGuard(bIsDispatchingCallbacks, true);
+		bIsTriggerConsumed = false;
+		FOGFrozenTriggerContextPtr FrozenContext;
+		TBitArray<TInlineAllocator<4>> Candidates;
+		Snapshot->FindCandidates(TriggerPhase, TriggerContext->GetTriggerTagSet(), TriggerContext->bHasLocation, Candidates);
+		if (TriggerContext->bHasLocation)
+		{
+			if (const FOGTriggerSpatialGrid* Grid = SpatialGridsByType.Find(TriggerContext->TriggerType))
+			{
+				Grid->ForEachListenerNear(TriggerContext->Location, TriggerContext->Radius, [&Snapshot, &Candidates, TriggerContext](FOGTriggerListenerData& Listener)
+				{
+					if (!Listener.IsInRangeOf(TriggerContext))
+						return;
+					//The index tracks the newest list that was edited, which is usually the pinned one. When it isn't (the listener is shared
+					//with the list of another type, or the list was edited since), the listener is looked up in the pinned snapshot itself
+					int32 ListIndex = Listener.SpatialListIndex;
+					if (!Snapshot->Listeners.IsValidIndex(ListIndex) || &Snapshot->Listeners[ListIndex].Get() != &Listener)
+					{
+						ListIndex = Snapshot->IndexOfByPredicate([&Listener](const TSharedRef<FOGTriggerListenerData>& Other) { return &Other.Get() == &Listener; });
+					}
+					if (ListIndex != INDEX_NONE)
+					{
+						Candidates[ListIndex] = true;
+					}
+				});
+			}
+		}
+		for (TConstSetBitIterator<TInlineAllocator<4>> It(Candidates); It; ++It)
+		{
+			const TSharedRef<FOGTriggerListenerData>& Listener = (*Snapshot)[It.GetIndex()];
+			bool bIsFilterStale = false;
+			if (Listener->ShouldListenerProcessTrigger(TriggerPhase, TriggerContext, GetClock(), bIsFilterStale))
+			{
+				ExecuteListenerCallback(Listener, TriggerHandle, TriggerPhase, TriggerContext, FrozenContext);
+				//Listeners are sorted by priority, so everything after a consuming listener is skipped entirely
+				if (bIsTriggerConsumed)
+					break;
+			}
+			else if (bIsFilterStale)
+			{
+				//A filter reported that it will block every trigger from now on
+				RemoveTriggerListener_Internal(Listener->Handle);
+			}
+		}
+		bIsTriggerConsumed = false;
+	}
+	ReleaseRetiredListeners();
+}
+
+void FOGTriggerEngine::ExecuteListenerCallback(const TSharedRef<FOGTriggerListenerData>& Listener, const FOGGameplayTriggerHandle& TriggerHandle,
+	EOGTriggerListenerPhases TriggerPhase, UOGGameplayTriggerContext* TriggerContext, FOGFrozenTriggerContextPtr& FrozenContext)
+{
+	Listener->RecordCall(GetClock());
+	if (Listener->bIsAwaiter)
+	{
+		//Awaiters only fire once, even if several existing triggers match or a pinned snapshot of the list still contains them
+		if (Listener->bHasFired)
+			return;
+		Listener->bHasFired = true;
+		RemoveTriggerListener(Listener->Handle);
+		Listener->AwaiterPromise->Fulfill(TriggerContext);
+	}
+	else if (Listener->RunOn == EOGTriggerRunOn::AnyThread)
+	{
+		if (!FrozenContext.IsValid())
+		{
+			FrozenContext = MakeShared<FOGFrozenTriggerContext, ESPMode::ThreadSafe>(DuplicateTriggerContext(TriggerContext));
+		}
+		Listener->AnyThreadDispatch(TriggerHandle, TriggerPhase, FrozenContext);
+	}
+	else if (Listener->bDeferrable)
+	{
+		DeferredCallbacks.Add({TWeakPtr<FOGTriggerListenerData>(Listener), TriggerHandle, TriggerPhase, TStrongObjectPtr(TriggerContext)});
+	}
+	else
+	{
+		(void)Listener->Callback.ExecuteIfBound(TriggerHandle, TriggerPhase, TriggerContext);
+	}
+}
+
+void FOGTriggerEngine::ProcessTriggerTaps(const FOGGameplayTriggerHandle& TriggerHandle, EOGTriggerListenerPhases TriggerPhase, UOGGameplayTriggerContext* TriggerContext)
+{
+	if (Taps.IsEmpty())
+		return;
+
+	const bool bIsOutermostDispatch = !bIsDispatchingTaps;
+	{
+		TGuardValue<bool> TapGuard(bIsDispatchingTaps, true);
+		TGuardValue<bool> DispatchGuard(bIsDispatchingCallbacks, false);
+		//Taps added by a tap start with the next trigger
+		const int32 NumTaps = Taps.Num();
+		for (int32 Index = 0; Index < NumTaps; ++Index)
+		{
+			FOGTriggerTap& Tap = Taps[Index];
+			if (Tap.bIsRemoved || !(Tap.Phases & TriggerPhase))
+				continue;
+			if (!Tap.Callback.IsBound())
+			{
+				Tap.bIsRemoved = true;
+				bHasRemovedTaps = true;
+				UpdateTapPhases();
+				continue;
+			}
+			Tap.SampleCredit += Tap.SampleRate;
+			if (Tap.SampleCredit < 1.f)
+				continue;
+			Tap.SampleCredit -= 1.f;
+			//Copied since the callback may add taps and reallocate the array
+			const FOGTriggerDelegate Callback = Tap.Callback;
+			(void)Callback.ExecuteIfBound(TriggerHandle, TriggerPhase, TriggerContext);
+		}
+	}
+	if (bIsOutermostDispatch && bHasRemovedTaps)
+	{
+		Taps.RemoveAll([](const FOGTriggerTap& Tap) { return Tap.bIsRemoved; });
+		bHasRemovedTaps = false;
+	}
+}
+
+void FOGTriggerEngine::ProcessDeferredCallbacks()
+{
+	if (DeferredCallbacks.IsEmpty())
+		return;
+
+	const double BudgetSeconds = FMath::Max(GOGTriggerDeferredCallbackBudgetMs, 0.f) * 0.001;
+	const double StartTime = FPlatformTime::Seconds();
+	//Callbacks deferred while draining wait for the next frame, so a deferrable listener that re-triggers itself can't stall the tick
+	const int32 NumToProcess = DeferredCallbacks.Num();
+	int32 NumProcessed = 0;
+	//Always run at least one callback so the queue makes progress even with a zero budget
+	while (NumProcessed < NumToProcess)
+	{
+		//Move the entry out since the callback may defer more callbacks and reallocate the queue
+		const FOGDeferredTriggerCallback Deferred = MoveTemp(DeferredCallbacks[NumProcessed++]);
+		const TSharedPtr<FOGTriggerListenerData> Listener = Deferred.Listener.Pin();
+		//The listener may have been removed since the trigger was dispatched
+		if (Listener.IsValid() && Deferred.TriggerContext.IsValid())
+		{
+			(void)Listener->Callback.ExecuteIfBound(Deferred.TriggerHandle, Deferred.TriggerPhase, Deferred.TriggerContext.Get());
+		}
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+			break;
+	}
+	DeferredCallbacks.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+}
+
+void FOGTriggerEngine::ProcessTriggerTimers(float DeltaTime)
+{
+	//The wheel keeps moving even without timers, new timers are relative to its time
+	TArray<FOGTriggerTimer> Expired;
+	TimerWheel.Advance(TimerWheel.GetTime() + DeltaTime, Expired);
+	if (Expired.IsEmpty())
+		return;
+
+	//Everything that expired this frame is processed as one batch, so listeners that start or end triggers queue behind it
+	BeginOperationBatch();
+	for (const FOGTriggerTimer& Timer : Expired)
+	{
+		FOGTriggerTimerState* TimerState = TriggerTimers.Find(Timer.Handle);
+		if (!TimerState || TimerState->Serial != Timer.Serial)
+			continue;
+		if (!Timer.bIsUpdate)
+		{
+			TriggerTimers.Remove(Timer.Handle);
+			EnqueueOperation(FOGPendingTriggerOperation(Timer.Handle, EOGTriggerOperationFlags::CloseTrigger));
+			continue;
+		}
+
+		const TriggerMap* ActiveTriggers = ActiveTriggersByType.Find(Timer.Handle.TriggerType);
+		const TStrongObjectPtr<UOGGameplayTriggerContext>* ActiveTrigger = ActiveTriggers ? ActiveTriggers->Find(Timer.Handle) : nullptr;
+		if (!ensure(ActiveTrigger))
+			continue;
+		EnqueueOperation(FOGPendingTriggerOperation(Timer.Handle, EOGTriggerOperationFlags::UpdateTrigger, ActiveTrigger->Get()));
+		//An update that is already overdue fires on the next frame, so a long frame doesn't fire a burst of updates
+		TimerState->NextUpdateTime += TimerState->UpdateInterval;
+		if (TimerState->EndTime < 0.0 || TimerState->NextUpdateTime < TimerState->EndTime)
+		{
+			TimerWheel.Schedule(Timer, TimerState->NextUpdateTime);
+		}
+	}
+	EndOperationBatch();
+}
+
+void FOGTriggerEngine::EnableTriggerHistory(const FGameplayTag& TriggerType, int32 Capacity)
+{
+	if (!ensureMsgf(Capacity > 0, TEXT("Trigger history needs room for at least one trigger")))
+		return;
+	FOGTriggerHistory& History = HistoryByType.FindOrAdd(TriggerType);
+	UpdateObservedFlags(TriggerType);
+	if (History.Capacity == Capacity)
+		return;
+
+	TArray<FOGTriggerHistory::FEntry> Entries;
+	Entries.Reserve(Capacity);
+	const int32 NumDropped = FMath::Max(History.Entries.Num() - Capacity, 0);
+	int32 EntryIndex = 0;
+	History.ForEach([&Entries, &EntryIndex, NumDropped](const FOGTriggerHistory::FEntry& Entry)
+	{
+		if (EntryIndex++ >= NumDropped)
+		{
+			Entries.Add(Entry);
+		}
+	});
+	History.Entries = MoveTemp(Entries);
+	History.Capacity = Capacity;
+	History.Oldest = 0;
+}
+
+void FOGTriggerEngine::DisableTriggerHistory(const FGameplayTag& TriggerType)
+{
+	HistoryByType.Remove(TriggerType);
+	UpdateObservedFlags(TriggerType);
+}
+
+void FOGTriggerEngine::RecordTriggerHistory(const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext* Trigger)
+{
+	FOGTriggerHistory* History = HistoryByType.Find(Trigger->TriggerType);
+	if (!History)
+		return;
+
+	FOGTriggerHistory::FEntry* Entry;
+	if (History->Entries.Num() < History->Capacity)
+	{
+		Entry = &History->Entries.AddDefaulted_GetRef();
+	}
+	else
+	{
+		Entry = &History->Entries[History->Oldest];
+		History->Oldest = (History->Oldest + 1) % History->Capacity;
+	}
+	Entry->Handle = Handle;
+	Entry->Time = GetEngineTime();
+	//The context handed to InstantaneousTrigger belongs to the caller, who may reuse it, so the history keeps its own copy
+	if (Entry->Context.IsValid() && Entry->Context->GetClass() == Trigger->GetClass() && !bIsReplayingHistory)
+	{
+		for (TFieldIterator<FProperty> It(Trigger->GetClass()); It; ++It)
+		{
+			It->CopyCompleteValue_InContainer(Entry->Context.Get(), Trigger);
+		}
+	}
+	else
+	{
+		Entry->Context = TStrongObjectPtr(DuplicateTriggerContext(Trigger));
+	}
+}
+
+void FOGTriggerEngine::ReplayTriggerHistory(const TSharedRef<FOGTriggerListenerData>& Listener, double Since)
+{
+	//Triggers fired by the replayed callbacks are recorded, but not replayed
+	TArray<FOGTriggerHistory::FEntry, TInlineAllocator<16>> ReplayedTriggers;
+	Listener->ForEachTriggerType([this, &ReplayedTriggers, Since](const FGameplayTag& TriggerType)
+	{
+		if (const FOGTriggerHistory* History = HistoryByType.Find(TriggerType))
+		{
+			History->ForEach([&ReplayedTriggers, Since](const FOGTriggerHistory::FEntry& Entry)
+			{
+				if (Entry.Time >= Since)
+				{
+					ReplayedTriggers.Add(Entry);
+				}
+			});
+		}
+	});
+	if (ReplayedTriggers.IsEmpty())
+		return;
+	if (!Listener->AdditionalTriggerTypes.IsEmpty())
+	{
+		//Interleave the histories of the listener's types, oldest first
+		Algo::StableSortBy(ReplayedTriggers, &FOGTriggerHistory::FEntry::Time);
+	}
+
+	//Like existing triggers, replayed triggers are not part of a dispatch and can't be consumed
+	TGuardValue<bool> DispatchGuard(bIsDispatchingCallbacks, false);
+	TGuardValue<bool> ReplayGuard(bIsReplayingHistory, true);
+	const EOGTriggerListenerPhases TriggerPhase = EOGTriggerListenerPhases(uint8(EOGTriggerOperationFlags::InstantaneousTrigger) & uint8(EOGTriggerListenerPhases::All));
+	for (const FOGTriggerHistory::FEntry& Entry : ReplayedTriggers)
+	{
+		bool bIsFilterStale = false;
+		if (Listener->IsInRangeOf(Entry.Context.Get()) && Listener->ShouldListenerProcessTrigger(TriggerPhase, Entry.Context.Get(), GetClock(), bIsFilterStale))
+		{
+			FOGFrozenTriggerContextPtr FrozenContext;
+			ExecuteListenerCallback(Listener, Entry.Handle, TriggerPhase, Entry.Context.Get(), FrozenContext);
+		}
+	}
+}
+
+void FOGTriggerEngine::SweepStaleListeners()
+{
+	int32 Budget = GOGTriggerSweepListenersPerFrame;
+	bool bHasStartedPass = false;
+	while (Budget > 0)
+	{
+		if (SweepTypeIndex >= SweepTriggerTypes.Num())
+		{
+			//Never start more than one pass per frame, the remaining budget may be larger than the number of listeners
+			if (bHasStartedPass)
+				return;
+			bHasStartedPass = true;
+			if (!SweepTriggerTypes.IsEmpty())
+			{
+				SweepStats.NumCompletedPasses++;
+				UE_CLOG(SweepStats.NumListenersReclaimed > SweepStatsAtPassStart.NumListenersReclaimed, LogOGGameplayTrigger, Verbose,
+					TEXT("Stale listener sweep reclaimed %lld listeners and released %lld filter references"),
+					SweepStats.NumListenersReclaimed - SweepStatsAtPassStart.NumListenersReclaimed, SweepStats.NumFilterReferencesReleased - SweepStatsAtPassStart.NumFilterReferencesReleased);
+			}
+			SweepStatsAtPassStart = SweepStats;
+			ListenersByType.GetKeys(SweepTriggerTypes);
+			SweepTypeIndex = 0;
+			SweepListenerIndex = 0;
+			if (SweepTriggerTypes.IsEmpty())
+				return;
+		}
+
+		const FGameplayTag& TriggerType = SweepTriggerTypes[SweepTypeIndex];
+		const FOGTriggerListenerList* Listeners = ListenersByType.Find(TriggerType);
+		const int32 NumListeners = Listeners ? Listeners->Get().Num() : 0;
+		//The list may have shrunk since the previous frame
+		SweepListenerIndex = FMath::Min(SweepListenerIndex, NumListeners);
+		const int32 EndIndex = FMath::Min(NumListeners, SweepListenerIndex + Budget);
+		TArray<FOGTriggerListenerHandle, TInlineAllocator<8>> StaleHandles;
+		for (int32 Index = SweepListenerIndex; Index < EndIndex; ++Index)
+		{
+			const FOGTriggerListenerData& Listener = *Listeners->Get()[Index];
+			if (Listener.IsStale())
+			{
+				StaleHandles.Add(Listener.Handle);
+				SweepStats.NumFilterReferencesReleased += Listener.FilterObjects.Num();
+			}
+		}
+		Budget -= EndIndex - SweepListenerIndex;
+		SweepStats.NumListenersVisited += EndIndex - SweepListenerIndex;
+		//Every removed listener was before EndIndex, so the cursor moves back by as many
+		SweepListenerIndex = EndIndex - StaleHandles.Num();
+		if (!StaleHandles.IsEmpty())
+		{
+			SweepStats.NumListenersReclaimed += StaleHandles.Num();
+			RemoveTriggerListeners_Internal(MakeArrayView(&TriggerType, 1), [&StaleHandles](const FOGTriggerListenerData& Listener) { return StaleHandles.Contains(Listener.Handle); });
+		}
+		if (EndIndex >= NumListeners)
+		{
+			SweepTypeIndex++;
+			SweepListenerIndex = 0;
+		}
+	}
+}
+
+void FOGTriggerEngine::AddActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* Trigger)
+{
+	if (IsTriggerTypeReplicated(Trigger->TriggerType))
+	{
+		ReplicatedTriggers.Add(Trigger);
+	}
+	const TStrongObjectPtr StrongTrigger(Trigger);
+	ActiveTriggersByType.FindOrAdd(Trigger->TriggerType).Add(Handle, StrongTrigger);
+	MemoryStats.NumActiveTriggers++;
+	MemoryStats.PeakActiveTriggers = FMath::Max(MemoryStats.PeakActiveTriggers, MemoryStats.NumActiveTriggers);
+	AddToAggregateViews(Handle, Trigger);
+}
+
+void FOGTriggerEngine::UpdateActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* Trigger)
+{
+	const TStrongObjectPtr<UOGGameplayTriggerContext> TriggerBeingModified = ActiveTriggersByType.FindChecked(Handle.TriggerType).FindChecked(Handle);
+	
+	//TODO: I'm not 100% sure that uobject equality check will just check if the pointers are the same
+	if (TriggerBeingModified.Get() == Trigger)
+	{
+		//The trigger may have been modified in place
+		if (IsTriggerTypeReplicated(TriggerBeingModified->TriggerType))
+		{
+			//TODO: find element and mark it dirty
+		}
+	}
+	else
+	{
+		if (IsTriggerTypeReplicated(TriggerBeingModified->TriggerType))
+		{
+			ReplicatedTriggers.RemoveSwap(TriggerBeingModified.Get());
+			ReplicatedTriggers.Add(Trigger);
+		}
+		const TStrongObjectPtr StrongTrigger(Trigger);
+        ActiveTriggersByType.FindOrAdd(Trigger->TriggerType).Add(Handle, StrongTrigger);
+	}
+	//Contributions are recorded, so the previous value is known even if the context was modified in place
+	RemoveFromAggregateViews(Handle);
+	AddToAggregateViews(Handle, Trigger);
+}
+
+void FOGTriggerEngine::RemoveActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle)
+{
+	const TStrongObjectPtr<UOGGameplayTriggerContext> TriggerBeingRemoved = ActiveTriggersByType.FindChecked(Handle.TriggerType).FindAndRemoveChecked(Handle);
+	MemoryStats.NumActiveTriggers--;
+	//Any timer still on the wheel for this trigger is ignored when it expires
+	TriggerTimers.Remove(Handle);
+	RemoveFromAggregateViews(Handle);
+
+	if (IsTriggerTypeReplicated(TriggerBeingRemoved->TriggerType))
+	{
+		ReplicatedTriggers.RemoveSwap(TriggerBeingRemoved.Get());
+	}
+}
+
+void FOGTriggerEngine::AddToAggregateViews(const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext* Trigger)
+{
+	const auto* Views = AggregateViewsByType.Find(Handle.TriggerType);
+	if (!Views)
+		return;
+	for (const FOGTriggerAggregateViewHandle& ViewHandle : *Views)
+	{
+		AggregateViews.FindChecked(ViewHandle).Add(Handle, *Trigger);
+	}
+}
+
+void FOGTriggerEngine::RemoveFromAggregateViews(const FOGGameplayTriggerHandle& Handle)
+{
+	const auto* Views = AggregateViewsByType.Find(Handle.TriggerType);
+	if (!Views)
+		return;
+	for (const FOGTriggerAggregateViewHandle& ViewHandle : *Views)
+	{
+		AggregateViews.FindChecked(ViewHandle).Remove(Handle);
+	}
+}
+
+void FOGTriggerEngine::FOGTriggerAggregateView::Add(const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext& Trigger)
+{
+	FContribution Contribution;
+	if (Op != EOGTriggerAggregateOp::Count)
+	{
+		const TOptional<double> TriggerValue = Value(Trigger);
+		if (!TriggerValue.IsSet())
+			return;
+		Contribution.Value = TriggerValue.GetValue();
+	}
+	if (KeyBy == EOGTriggerAggregateKey::Instigator)
+	{
+		Contribution.Key = FObjectKey(Trigger.InitiatorObject.Get());
+	}
+	else if (KeyBy == EOGTriggerAggregateKey::Target)
+	{
+		Contribution.Key = FObjectKey(Trigger.TargetObject.Get());
+	}
+
+	FBucket& Bucket = Buckets.FindOrAdd(Contribution.Key);
+	Bucket.Count++;
+	Bucket.Sum += Contribution.Value;
+	if (Op == EOGTriggerAggregateOp::Min || Op == EOGTriggerAggregateOp::Max)
+	{
+		Bucket.PushValue(ToHeapValue(Contribution.Value));
+	}
+	Contributions.Add(Handle, Contribution);
+}
+
+void FOGTriggerEngine::FOGTriggerAggregateView::Remove(const FOGGameplayTriggerHandle& Handle)
+{
+	FContribution Contribution;
+	if (!Contributions.RemoveAndCopyValue(Handle, Contribution))
+		return;
+	FBucket& Bucket = Buckets.FindChecked(Contribution.Key);
+	if (--Bucket.Count == 0)
+	{
+		//Also resets the sum, so rounding errors don't pile up over the lifetime of the view
+		Buckets.Remove(Contribution.Key);
+		return;
+	}
+	Bucket.Sum -= Contribution.Value;
+	if (Op == EOGTriggerAggregateOp::Min || Op == EOGTriggerAggregateOp::Max)
+	{
+		Bucket.RemoveValue(ToHeapValue(Contribution.Value));
+	}
+}
+
+void FOGTriggerEngine::FOGTriggerAggregateView::FBucket::PushValue(double HeapValue)
+{
+	Heap.HeapPush(HeapValue);
+}
+
+void FOGTriggerEngine::FOGTriggerAggregateView::FBucket::RemoveValue(double HeapValue)
+{
+	if (Heap.HeapTop() != HeapValue)
+	{
+		RemovedValues.FindOrAdd(HeapValue)++;
+		NumRemovedValues++;
+		//Rebuilt once removed values outnumber the ones still in the view, so the heap stays within twice the size of the bucket
+		if (NumRemovedValues > Count)
+		{
+			Heap.RemoveAll([this](double Value)
+			{
+				int32* NumRemoved = RemovedValues.Find(Value);
+				return NumRemoved && (*NumRemoved)-- > 0;
+			});
+			Heap.Heapify();
+			RemovedValues.Reset();
+			NumRemovedValues = 0;
+		}
+		return;
+	}
+	Heap.HeapPopDiscard();
+	//Keeps the top readable by dropping the values that were removed while they were below it
+	while (!Heap.IsEmpty())
+	{
+		int32* NumRemoved = RemovedValues.Find(Heap.HeapTop());
+		if (!NumRemoved)
+			break;
+		if (--*NumRemoved == 0)
+		{
+			RemovedValues.Remove(Heap.HeapTop());
+		}
+		NumRemovedValues--;
+		Heap.HeapPopDiscard();
+	}
+}
+
+void FOGTriggerEngine::UpdateCompositeTriggers(const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext& Trigger, int32 Delta)
+{
+	const auto* Composites = CompositeTriggersByType.Find(Handle.TriggerType);
+	if (!Composites)
+		return;
+	for (const FOGTriggerCompositeHandle& CompositeHandle : *Composites)
+	{
+		UpdateCompositeTrigger(CompositeTriggers.FindChecked(CompositeHandle), Handle, Trigger, Delta);
+	}
+}
+
+void FOGTriggerEngine::UpdateCompositeTrigger(FOGTriggerComposite& Composite, const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext& Trigger, int32 Delta)
+{
+	FObjectKey Key;
+	UObject* KeyObject = nullptr;
+	if (Composite.KeyBy != EOGTriggerAggregateKey::None)
+	{
+		if (Delta > 0)
+		{
+			KeyObject = Composite.KeyBy == EOGTriggerAggregateKey::Instigator ? Trigger.InitiatorObject.Get() : Trigger.TargetObject.Get();
+			if (!KeyObject)
+				return;
+			Key = FObjectKey(KeyObject);
+			Composite.TriggerKeys.Add(Handle, Key);
+		}
+		else if (!Composite.TriggerKeys.RemoveAndCopyValue(Handle, Key))
+		{
+			return;
+		}
+	}
+	FOGTriggerComposite::FState* State = Composite.States.Find(Key);
+	if (!State)
+	{
+		State = &Composite.States.Add(Key, Composite.MakeState(KeyObject));
+	}
+
+	State->NumTriggers += Delta;
+	for (int32 TermIndex = 0; TermIndex < Composite.Terms.Num(); ++TermIndex)
+	{
+		if (Composite.Terms[TermIndex].TriggerType != Handle.TriggerType)
+			continue;
+		const bool bWasSatisfied = Composite.IsTermSatisfied(*State, TermIndex);
+		State->Counts[TermIndex] += Delta;
+		State->NumSatisfiedTerms += int32(Composite.IsTermSatisfied(*State, TermIndex)) - int32(bWasSatisfied);
+	}
+	EvaluateCompositeState(Composite, *State);
+	//A keyed state without triggers has a required term that doesn't hold, so its output has just been ended
+	if (Composite.KeyBy != EOGTriggerAggregateKey::None && State->NumTriggers == 0)
+	{
+		Composite.States.Remove(Key);
+	}
+}
+
+void FOGTriggerEngine::EvaluateCompositeState(const FOGTriggerComposite& Composite, FOGTriggerComposite::FState& State)
+{
+	const bool bHolds = State.NumSatisfiedTerms == Composite.Terms.Num();
+	if (bHolds == State.bIsOutputActive)
+		return;
+	State.bIsOutputActive = bHolds;
+	//The derived trigger is only queued, so its dispatch never touches the composite tables while they are being updated
+	ensureMsgf(!OperationQueue.IsEmpty(), TEXT("Composite triggers must be evaluated while the operation queue is held"));
+	if (bHolds)
+	{
+		UObject* KeyObject = State.KeyObject.Get();
+		UObject* Initiator = Composite.KeyBy == EOGTriggerAggregateKey::Instigator ? KeyObject : nullptr;
+		UObject* Target = Composite.KeyBy == EOGTriggerAggregateKey::Target ? KeyObject : nullptr;
+		State.Output = CreateNewTriggerHandle(Composite.OutputType);
+		EnqueueOperation(FOGPendingTriggerOperation(State.Output, EOGTriggerOperationFlags::OpenTrigger,
+			MakeGameplayTriggerContext(Composite.OutputType, Composite.OutputTags, Initiator, Target)));
+	}
+	//The derived trigger may have been ended by someone else already
+	else if (IsTriggerActiveOrPending(State.Output))
+	{
+		EnqueueOperation(FOGPendingTriggerOperation(State.Output, EOGTriggerOperationFlags::CloseTrigger));
+	}
+}
+
+FOGTriggerEngine::FOGTriggerComposite::FState FOGTriggerEngine::FOGTriggerComposite::MakeState(UObject* KeyObject) const
+{
+	FState State;
+	State.Counts.SetNumZeroed(Terms.Num());
+	//With no trigger counted, exactly the negated terms hold
+	State.NumSatisfiedTerms = Algo::CountIf(Terms, [](const FOGTriggerCompositeTerm& Term) { return Term.bNegated; });
+	State.KeyObject = KeyObject;
+	return State;
+}
+
+void FOGTriggerEngine::AddTriggerListener_Internal(const FOGTriggerListenerHandle& Handle, const TSharedRef<FOGTriggerListenerData>& Listener)
+{
+	Listener->ForEachTriggerType([this, &Listener](const FGameplayTag& TriggerType)
+	{
+		FOGTriggerListenerSnapshot& Listeners = ListenersByType.FindOrAdd(TriggerType).Edit();
+		//Insert after every listener with the same or higher priority to keep the list sorted and registration order stable
+		const int32 InsertIndex = Algo::UpperBoundBy(Listeners.Listeners, Listener->Priority,
+			[](const TSharedRef<FOGTriggerListenerData>& Other) { return Other->Priority; }, TGreater<>());
+		Listeners.Insert(Listener, InsertIndex);
+	});
+	if (Listener->bIsSpatial)
+	{
+		SpatialGridsByType.FindOrAdd(Listener->TriggerType).Add(*Listener);
+	}
+	MemoryStats.NumListeners++;
+	MemoryStats.PeakListeners = FMath::Max(MemoryStats.PeakListeners, MemoryStats.NumListeners);
+}
+
+void FOGTriggerEngine::RemoveTriggerListener_Internal(const FOGTriggerListenerHandle& Handle)
+{
+	FOGTriggerListenerList* Listeners = ListenersByType.Find(Handle.TriggerType);
+	if (!Listeners)
+		return;
+	const int32 Index = Listeners->Get().IndexOfByPredicate([&Handle](const TSharedRef<FOGTriggerListenerData>& Listener) { return Listener->Handle == Handle; });
+	if (Index != INDEX_NONE)
+	{
+		FOGTriggerListenerSnapshot& EditableListeners = Listeners->Edit();
+		const TSharedRef<FOGTriggerListenerData> RemovedListener = EditableListeners[Index];
+		EditableListeners.RemoveAt(Index);
+		if (!RemovedListener->AdditionalTriggerTypes.IsEmpty())
+		{
+			RemoveFromRemainingTypes(RemovedListener);
+		}
+		RemoveFromSpatialGrid(*RemovedListener);
+		MemoryStats.NumListeners--;
+		ReleaseListener(RemovedListener);
+	}
+}
+
+void FOGTriggerEngine::RemoveFromRemainingTypes(const TSharedRef<FOGTriggerListenerData>& Listener)
+{
+	Listener->ForEachTriggerType([this, &Listener](const FGameplayTag& TriggerType)
+	{
+		FOGTriggerListenerList* Listeners = ListenersByType.Find(TriggerType);
+		if (!Listeners)
+			return;
+		const int32 Index = Listeners->Get().IndexOfByPredicate([&Listener](const TSharedRef<FOGTriggerListenerData>& Other) { return Other == Listener; });
+		if (Index != INDEX_NONE)
+		{
+			Listeners->Edit().RemoveAt(Index);
+		}
+	});
+}
+
+void FOGTriggerEngine::RemoveFromSpatialGrid(FOGTriggerListenerData& Listener)
+{
+	if (!Listener.bIsSpatial)
+		return;
+	FOGTriggerSpatialGrid& Grid = SpatialGridsByType.FindChecked(Listener.TriggerType);
+	Grid.Remove(Listener);
+	Listener.SpatialListIndex = INDEX_NONE;
+	if (Grid.NumListeners == 0)
+	{
+		SpatialGridsByType.Remove(Listener.TriggerType);
+	}
+}
+
+int32 FOGTriggerEngine::GetNumTrackedListeners() const
+{
+	int32 NumTrackedListeners = 0;
+	for (const auto& [TriggerType, Grid] : SpatialGridsByType)
+	{
+		NumTrackedListeners += Grid.TrackedListeners.Num();
+	}
+	return NumTrackedListeners;
+}
+
+void FOGTriggerEngine::UpdateTrackedListeners()
+{
+	for (auto& [TriggerType, Grid] : SpatialGridsByType)
+	{
+		for (FOGTriggerListenerData* Listener : Grid.TrackedListeners)
+		{
+			//Listeners whose actor is gone are reclaimed through their EndPlay binding, until then they keep their last location
+			if (const AActor* Actor = Listener->TrackedActor.Get())
+			{
+				Grid.Move(*Listener, Actor->GetActorLocation());
+			}
+		}
+	}
+}
+
+void FOGTriggerEngine::ReleaseRetiredListeners()
+{
+	if (RetiredListeners.IsEmpty())
+		return;
+	TArray<TSharedRef<FOGTriggerListenerData>> Retired = MoveTemp(RetiredListeners);
+	RetiredListeners.Reset();
+	for (const TSharedRef<FOGTriggerListenerData>& Listener : Retired)
+	{
+		ReleaseListener(Listener);
+	}
+}
+
+void FOGTriggerEngine::RemoveTriggerListeners_Internal(TConstArrayView<FGameplayTag> TriggerTypes, TFunctionRef<bool(const FOGTriggerListenerData&)> Predicate)
+{
+	TArray<TSharedRef<FOGTriggerListenerData>> RemovedListeners;
+	for (const FGameplayTag& TriggerType : TriggerTypes)
+	{
+		FOGTriggerListenerList* Listeners = ListenersByType.Find(TriggerType);
+		if (!Listeners || !Listeners->Get().ContainsByPredicate([&Predicate](const TSharedRef<FOGTriggerListenerData>& Listener) { return Predicate(*Listener); }))
+			continue;
+		//Single stable pass, so the remaining listeners keep their priority order
+		Listeners->Edit().RemoveAll([&Predicate, &RemovedListeners](const TSharedRef<FOGTriggerListenerData>& Listener)
+		{
+			if (!Predicate(*Listener))
+				return false;
+			//Listeners of several types can be met once per type
+			if (Listener->AdditionalTriggerTypes.IsEmpty() || !RemovedListeners.Contains(Listener))
+			{
+				RemovedListeners.Add(Listener);
+			}
+			return true;
+		});
+	}
+	MemoryStats.NumListeners -= RemovedListeners.Num();
+	for (const TSharedRef<FOGTriggerListenerData>& Listener : RemovedListeners)
+	{
+		if (!Listener->AdditionalTriggerTypes.IsEmpty())
+		{
+			RemoveFromRemainingTypes(Listener);
+		}
+		RemoveFromSpatialGrid(*Listener);
+		ReleaseListener(Listener);
+	}
+}
+
+void FOGTriggerEngine::BindListenerToObject(const FObjectKey& Object, const FGameplayTag& TriggerType)
+{
+	if (TriggerTypeArray* TriggerTypes = ListenerTypesByBoundObject.Find(Object))
+	{
+		TriggerTypes->AddUnique(TriggerType);
+		return;
+	}
+	ListenerTypesByBoundObject.Add(Object).Add(TriggerType);
+	//Actors are reclaimed as soon as they end play if the owner tracks it, any other object when it is garbage collected
+	if (!OnActorBound)
+		return;
+	if (AActor* Actor = Cast<AActor>(Object.ResolveObjectPtr()))
+	{
+		OnActorBound(Actor);
+	}
+}
+
+void FOGTriggerEngine::RemoveListenersBoundToObject(const FObjectKey& Object)
+{
+	TriggerTypeArray TriggerTypes;
+	if (!ListenerTypesByBoundObject.RemoveAndCopyValue(Object, TriggerTypes))
+		return;
+	RemoveTriggerListeners_Internal(TriggerTypes, [&Object](const FOGTriggerListenerData& Listener) { return Listener.IsBoundTo(Object); });
+}
+
+void FOGTriggerEngine::HandlePostGarbageCollect()
+{
+	TArray<FObjectKey, TInlineAllocator<16>> CollectedObjects;
+	for (const auto& [BoundObject, TriggerTypes] : ListenerTypesByBoundObject)
+	{
+		if (!BoundObject.ResolveObjectPtr())
+		{
+			CollectedObjects.Add(BoundObject);
+		}
+	}
+	for (const FObjectKey& BoundObject : CollectedObjects)
+	{
+		RemoveListenersBoundToObject(BoundObject);
+	}
+}
+
+void FOGTriggerEngine::EnqueueOperation(const FOGPendingTriggerOperation& Operation)
+{
+	//Enqueue at Head and Dequeue at Tail so that iterating through the queue will access the last operations first
+	OperationQueue.AddHead(Operation);
+}
+
+bool FOGTriggerEngine::PeekOperation(FOGPendingTriggerOperation*& OutOperation) const
+{
+	if (OperationQueue.IsEmpty())
+		return false;
+	OutOperation = &OperationQueue.GetTail()->GetValue();
+	return true;
+}
+
+void FOGTriggerEngine::PopOperation()
+{
+	if (OperationQueue.IsEmpty())
+		return;
+	OperationQueue.RemoveNode(OperationQueue.GetTail());
+}
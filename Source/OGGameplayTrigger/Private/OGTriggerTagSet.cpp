@@ -0,0 +1,236 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGTriggerTagSet.h"
+
+#include "Misc/ScopeRWLock.h"
+
+namespace OGTriggerTagSet
+{
+	typedef TArray<FGameplayTag, TInlineAllocator<8>> FSortedTags;
+
+	/**
+	 * Process-wide interning table. Tags get a bit index the first time a set uses them, so the bitsets stay dense
+	 * and don't depend on the tag manager's net index table being built.
+	 */
+	struct FTable
+	{
+		FRWLock Lock;
+		TMap<FGameplayTag, int32> TagIndices;
+		//Sets bucketed by the hash of their sorted explicit tags
+		TMap<uint32, TArray<const FOGTriggerTagSet*, TInlineAllocator<1>>> SetsByHash;
+		TArray<TUniquePtr<FOGTriggerTagSet>> Sets;
+		//Set once by the constructor, so it can be read without the lock while Sets grows on other threads
+		const FOGTriggerTagSet* EmptySet;
+
+		FTable()
+		{
+			TUniquePtr<FOGTriggerTagSet> NewEmptySet = MakeUnique<FOGTriggerTagSet>();
+			EmptySet = NewEmptySet.Get();
+			SetsByHash.Add(0).Add(NewEmptySet.Get());
+			Sets.Add(MoveTemp(NewEmptySet));
+		}
+
+		static FTable& Get()
+		{
+			static FTable Table;
+			return Table;
+		}
+	};
+
+	static void SortTags(FSortedTags& Tags)
+	{
+		Tags.Sort([](const FGameplayTag& A, const FGameplayTag& B) { return A.GetTagName().FastLess(B.GetTagName()); });
+	}
+
+	static uint32 HashSortedTags(const FSortedTags& Tags)
+	{
+		uint32 Hash = 0;
+		for (const FGameplayTag& Tag : Tags)
+		{
+			Hash = HashCombineFast(Hash, GetTypeHash(Tag));
+		}
+		return Hash;
+	}
+
+	static bool MatchesSortedTags(const FOGTriggerTagSet& Set, const FSortedTags& Tags)
+	{
+		const TArray<FGameplayTag>& SetTags = Set.Tags.GetGameplayTagArray();
+		if (SetTags.Num() != Tags.Num())
+			return false;
+		//Interned sets store their explicit tags sorted, so a linear compare is enough
+		for (int32 i = 0; i < Tags.Num(); ++i)
+		{
+			if (SetTags[i] != Tags[i])
+				return false;
+		}
+		return true;
+	}
+
+	static const FOGTriggerTagSet* FindSet(const FTable& Table, uint32 Hash, const FSortedTags& Tags)
+	{
+		if (const auto* Bucket = Table.SetsByHash.Find(Hash))
+		{
+			for (const FOGTriggerTagSet* Set : *Bucket)
+			{
+				if (MatchesSortedTags(*Set, Tags))
+					return Set;
+			}
+		}
+		return nullptr;
+	}
+
+	static void SetBit(FOGTriggerTagSet::FWords& Words, int32 Index)
+	{
+		const int32 WordIndex = Index / 32;
+		if (Words.Num() <= WordIndex)
+		{
+			Words.SetNumZeroed(WordIndex + 1);
+		}
+		Words[WordIndex] |= 1u << (Index % 32);
+	}
+
+	static bool TestBit(const FOGTriggerTagSet::FWords& Words, int32 Index)
+	{
+		const int32 WordIndex = Index / 32;
+		return Index != INDEX_NONE && WordIndex < Words.Num() && (Words[WordIndex] & (1u << (Index % 32))) != 0;
+	}
+
+	static FOGTriggerTagMask FoldBits(const FOGTriggerTagSet::FWords& Words)
+	{
+		FOGTriggerTagMask Mask;
+		for (int32 i = 0; i < Words.Num(); ++i)
+		{
+			Mask.Words[i % FOGTriggerTagMask::NumWords] |= Words[i];
+		}
+		return Mask;
+	}
+
+	//Table lock has to be held for writing
+	static int32 GetOrAddTagIndex(FTable& Table, const FGameplayTag& Tag)
+	{
+		if (const int32* Index = Table.TagIndices.Find(Tag))
+			return *Index;
+		return Table.TagIndices.Add(Tag, Table.TagIndices.Num());
+	}
+}
+
+bool FOGTriggerTagSet::HasTag(const FGameplayTag& Tag) const
+{
+	return OGTriggerTagSet::TestBit(AllBits, FindTagIndex(Tag));
+}
+
+bool FOGTriggerTagSet::HasTagExact(const FGameplayTag& Tag) const
+{
+	return OGTriggerTagSet::TestBit(ExplicitBits, FindTagIndex(Tag));
+}
+
+bool FOGTriggerTagSet::HasAll(const FOGTriggerTagSet& Other) const
+{
+	for (int32 i = 0; i < Other.ExplicitBits.Num(); ++i)
+	{
+		const uint32 Word = i < AllBits.Num() ? AllBits[i] : 0;
+		if ((Other.ExplicitBits[i] & ~Word) != 0)
+			return false;
+	}
+	return true;
+}
+
+bool FOGTriggerTagSet::HasAny(const FOGTriggerTagSet& Other) const
+{
+	const int32 NumWords = FMath::Min(AllBits.Num(), Other.ExplicitBits.Num());
+	for (int32 i = 0; i < NumWords; ++i)
+	{
+		if ((Other.ExplicitBits[i] & AllBits[i]) != 0)
+			return true;
+	}
+	return false;
+}
+
+const FOGTriggerTagSet& FOGTriggerTagSet::Intern(const FGameplayTagContainer& Tags)
+{
+	using namespace OGTriggerTagSet;
+	if (Tags.IsEmpty())
+		return Empty();
+
+	FSortedTags SortedTags(Tags.GetGameplayTagArray());
+	SortTags(SortedTags);
+	const uint32 Hash = HashSortedTags(SortedTags);
+
+	FTable& Table = FTable::Get();
+	{
+		FReadScopeLock ReadLock(Table.Lock);
+		if (const FOGTriggerTagSet* Set = FindSet(Table, Hash, SortedTags))
+			return *Set;
+	}
+
+	FWriteScopeLock WriteLock(Table.Lock);
+	//Another thread may have interned the same set while the lock was released
+	if (const FOGTriggerTagSet* Set = FindSet(Table, Hash, SortedTags))
+		return *Set;
+
+	TUniquePtr<FOGTriggerTagSet> NewSet = MakeUnique<FOGTriggerTagSet>();
+	NewSet->Id = Table.Sets.Num();
+	for (const FGameplayTag& Tag : SortedTags)
+	{
+		NewSet->Tags.AddTagFast(Tag);
+		SetBit(NewSet->ExplicitBits, GetOrAddTagIndex(Table, Tag));
+	}
+	NewSet->Tags.FillParentTags();
+	//Contains the explicit tags as well as their parents
+	for (const FGameplayTag& Tag : NewSet->Tags.GetGameplayTagParents())
+	{
+		SetBit(NewSet->AllBits, GetOrAddTagIndex(Table, Tag));
+	}
+	NewSet->ExplicitMask = FoldBits(NewSet->ExplicitBits);
+	NewSet->AllMask = FoldBits(NewSet->AllBits);
+
+	const FOGTriggerTagSet& Result = *NewSet;
+	Table.SetsByHash.FindOrAdd(Hash).Add(NewSet.Get());
+	Table.Sets.Add(MoveTemp(NewSet));
+	return Result;
+}
+
+const FOGTriggerTagSet& FOGTriggerTagSet::Empty()
+{
+	return *OGTriggerTagSet::FTable::Get().EmptySet;
+}
+
+int32 FOGTriggerTagSet::FindTagIndex(const FGameplayTag& Tag)
+{
+	OGTriggerTagSet::FTable& Table = OGTriggerTagSet::FTable::Get();
+	FReadScopeLock ReadLock(Table.Lock);
+	const int32* Index = Table.TagIndices.Find(Tag);
+	return Index ? *Index : INDEX_NONE;
+}
+
+bool FOGTriggerTagSetId::Serialize(FArchive& Ar)
+{
+	FGameplayTagContainer Tags;
+	if (Ar.IsSaving())
+	{
+		Tags = Set->Tags;
+	}
+	//Same layout as a plain FGameplayTagContainer property
+	FGameplayTagContainer::StaticStruct()->SerializeItem(Ar, &Tags, nullptr);
+	if (Ar.IsLoading())
+	{
+		Set = &FOGTriggerTagSet::Intern(Tags);
+	}
+	return true;
+}
+
+bool FOGTriggerTagSetId::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	FGameplayTagContainer Tags;
+	if (Ar.IsSaving())
+	{
+		Tags = Set->Tags;
+	}
+	Tags.NetSerialize(Ar, Map, bOutSuccess);
+	if (Ar.IsLoading())
+	{
+		Set = &FOGTriggerTagSet::Intern(Tags);
+	}
+	return true;
+}
@@ -0,0 +1,281 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGTriggerTelemetry.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOGTriggerTelemetry, Log, All);
+
+namespace OGTriggerTelemetry
+{
+	static constexpr uint32 Magic = 0x4F475454; // 'OGTT'
+
+	enum class EVersion : int32
+	{
+		Initial = 1,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	static const TCHAR* FileExtension = TEXT(".ogtt");
+
+	//A row takes at least one byte in each of its four packed columns, and a name at least its length
+	static constexpr int64 MinRowBytes = 4;
+	static constexpr int64 MinNameBytes = sizeof(int32);
+
+	static bool CanHold(const FArchive& Ar, int32 Num, int64 MinBytesPerElement)
+	{
+		return Num >= 0 && Num <= (Ar.TotalSize() - Ar.Tell()) / MinBytesPerElement;
+	}
+
+	static void SerializePackedColumn(FArchive& Ar, TArray<uint32>& Column, int32 NumRows)
+	{
+		if (Ar.IsLoading())
+		{
+			Column.SetNumUninitialized(NumRows);
+		}
+		for (uint32& Value : Column)
+		{
+			Ar.SerializeIntPacked(Value);
+		}
+	}
+}
+
+class FOGTriggerTelemetrySink::FWriter
+{
+public:
+	explicit FWriter(const FOGTriggerTelemetryOptions& Options) :
+		Directory(Options.Directory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("Telemetry") / TEXT("GameplayTriggers") : Options.Directory),
+		FilePrefix(Options.FilePrefix),
+		MaxFileBytes(FMath::Max<int64>(Options.MaxFileBytes, 1)),
+		MaxFiles(FMath::Max(Options.MaxFiles, 1))
+	{
+		IFileManager::Get().MakeDirectory(*Directory, true);
+		//Continue after the files of previous sessions instead of appending to them
+		TArray<FString> ExistingFiles;
+		IFileManager::Get().FindFiles(ExistingFiles, *(Directory / FilePrefix + TEXT("_*") + OGTriggerTelemetry::FileExtension), true, false);
+		TArray<int32> ExistingIndices;
+		for (const FString& File : ExistingFiles)
+		{
+			const FString Index = FPaths::GetBaseFilename(File).RightChop(FilePrefix.Len() + 1);
+			if (Index.IsNumeric())
+			{
+				ExistingIndices.Add(FCString::Atoi(*Index));
+			}
+		}
+		const int32 LastIndex = ExistingIndices.IsEmpty() ? INDEX_NONE : FMath::Max(ExistingIndices);
+		FileIndex = LastIndex + 1;
+		//The file of this session counts towards the limit
+		for (const int32 Index : ExistingIndices)
+		{
+			if (Index <= FileIndex - MaxFiles)
+			{
+				IFileManager::Get().Delete(*GetFilePath(Index));
+			}
+		}
+	}
+
+	void Write(double StartTime, double EndTime, const TArray<TPair<FCounterKey, uint32>>& Counters)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Ar(Bytes);
+		uint32 Magic = OGTriggerTelemetry::Magic;
+		int32 Version = int32(OGTriggerTelemetry::EVersion::Latest);
+		Ar << Magic;
+		Ar << Version;
+		Ar << StartTime;
+		Ar << EndTime;
+
+		//Types, tag sets and classes share a string table, rows only store indices into it
+		TArray<FString> Names;
+		TMap<FName, int32> NameIndices;
+		TMap<uint32, int32> TagSetIndices;
+		auto AddName = [&Names](FString&& Name) { return Names.Add(MoveTemp(Name)); };
+		const int32 NumRows = Counters.Num();
+		TArray<uint32> TypeColumn, TagsColumn, ClassColumn, CountColumn;
+		TypeColumn.Reserve(NumRows);
+		TagsColumn.Reserve(NumRows);
+		ClassColumn.Reserve(NumRows);
+		CountColumn.Reserve(NumRows);
+		for (const auto& [Key, Count] : Counters)
+		{
+			const FName TypeName = Key.TriggerType.GetTagName();
+			const int32* TypeIndex = NameIndices.Find(TypeName);
+			TypeColumn.Add(TypeIndex ? *TypeIndex : NameIndices.Add(TypeName, AddName(TypeName.ToString())));
+			//Interned tag sets are immutable and never freed, reading them from the pipe is safe
+			const int32* TagsIndex = TagSetIndices.Find(Key.TriggerTags->Id);
+			TagsColumn.Add(TagsIndex ? *TagsIndex : TagSetIndices.Add(Key.TriggerTags->Id, AddName(Key.TriggerTags->Tags.ToStringSimple())));
+			const FName ClassName = Key.InstigatorClass;
+			const int32* ClassIndex = NameIndices.Find(ClassName);
+			ClassColumn.Add(ClassIndex ? *ClassIndex : NameIndices.Add(ClassName, AddName(ClassName.IsNone() ? FString() : ClassName.ToString())));
+			CountColumn.Add(Count);
+		}
+		Ar << Names;
+		int32 NumRowsToWrite = NumRows;
+		Ar << NumRowsToWrite;
+		OGTriggerTelemetry::SerializePackedColumn(Ar, TypeColumn, NumRows);
+		OGTriggerTelemetry::SerializePackedColumn(Ar, TagsColumn, NumRows);
+		OGTriggerTelemetry::SerializePackedColumn(Ar, ClassColumn, NumRows);
+		OGTriggerTelemetry::SerializePackedColumn(Ar, CountColumn, NumRows);
+
+		const FString Path = GetFilePath(FileIndex);
+		const int64 FileSize = IFileManager::Get().FileSize(*Path);
+		if (FileSize > 0 && FileSize + Bytes.Num() > MaxFileBytes)
+		{
+			FileIndex++;
+			IFileManager::Get().Delete(*GetFilePath(FileIndex - MaxFiles));
+		}
+		if (!FFileHelper::SaveArrayToFile(Bytes, *GetFilePath(FileIndex), &IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogOGTriggerTelemetry, Warning, TEXT("Failed to write trigger telemetry to %s"), *GetFilePath(FileIndex));
+			return;
+		}
+		NumWindowsWritten.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	FString GetFilePath(int32 Index) const { return Directory / FString::Printf(TEXT("%s_%d%s"), *FilePrefix, Index, OGTriggerTelemetry::FileExtension); }
+
+	const FString Directory;
+	const FString FilePrefix;
+	const int64 MaxFileBytes;
+	const int32 MaxFiles;
+	int32 FileIndex = 0;
+	std::atomic<int64> NumWindowsWritten = 0;
+};
+
+FOGTriggerTelemetrySink::FOGTriggerTelemetrySink(FOGTriggerEngine& InEngine, const FOGTriggerTelemetryOptions& InOptions) :
+	Engine(InEngine),
+	WindowSeconds(FMath::Max(InOptions.WindowSeconds, 0.001)),
+	WindowStart(InEngine.GetEngineTime()),
+	Writer(MakeShared<FWriter, ESPMode::ThreadSafe>(InOptions)),
+	WritePipe(TEXT("OGTriggerTelemetry"))
+{
+	FOGTriggerTapOptions TapOptions;
+	//Instantaneous triggers are dispatched with TriggerStart as well, so every trigger is counted once
+	TapOptions.Phases = EOGTriggerListenerPhases::TriggerStart;
+	Tap = Engine.AddTriggerTap(FOGTriggerDelegate::CreateRaw(this, &FOGTriggerTelemetrySink::HandleTrigger), TapOptions);
+	TickHandle = Engine.OnTicked.AddRaw(this, &FOGTriggerTelemetrySink::CloseElapsedWindow);
+}
+
+FOGTriggerTelemetrySink::~FOGTriggerTelemetrySink()
+{
+	Engine.RemoveTriggerTap(Tap);
+	Engine.OnTicked.Remove(TickHandle);
+	Flush();
+	WaitForWrites();
+}
+
+void FOGTriggerTelemetrySink::Flush()
+{
+	SubmitWindow(Engine.GetEngineTime());
+	WindowStart = Engine.GetEngineTime();
+}
+
+void FOGTriggerTelemetrySink::WaitForWrites() const
+{
+	WritePipe.WaitUntilEmpty();
+}
+
+int64 FOGTriggerTelemetrySink::GetNumWindowsWritten() const
+{
+	return Writer->NumWindowsWritten.load(std::memory_order_relaxed);
+}
+
+const FString& FOGTriggerTelemetrySink::GetDirectory() const
+{
+	return Writer->Directory;
+}
+
+void FOGTriggerTelemetrySink::HandleTrigger(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* Trigger)
+{
+	//Triggers started during Tick can come in before the window was closed for this frame
+	CloseElapsedWindow();
+	const UObject* Instigator = Trigger->InitiatorObject.Get();
+	Counters.FindOrAdd({Trigger->TriggerType, Trigger->TriggerTagSet, Instigator ? Instigator->GetClass()->GetFName() : NAME_None})++;
+}
+
+void FOGTriggerTelemetrySink::CloseElapsedWindow()
+{
+	const double Now = Engine.GetEngineTime();
+	if (Now < WindowStart + WindowSeconds)
+		return;
+	//Windows stay aligned on the first one, even if whole windows went by without any trigger
+	const double NewWindowStart = Now - FMath::Fmod(Now - WindowStart, WindowSeconds);
+	SubmitWindow(WindowStart + WindowSeconds);
+	WindowStart = NewWindowStart;
+}
+
+void FOGTriggerTelemetrySink::SubmitWindow(double EndTime)
+{
+	if (Counters.IsEmpty())
+		return;
+	TArray<TPair<FCounterKey, uint32>> Window = Counters.Array();
+	//Keeps the map's allocation, the next window usually sees the same combinations
+	Counters.Reset();
+	WritePipe.Launch(TEXT("OGTriggerTelemetryWrite"), [WindowWriter = Writer, StartTime = WindowStart, EndTime, Window = MoveTemp(Window)]()
+	{
+		WindowWriter->Write(StartTime, EndTime, Window);
+	});
+}
+
+bool FOGTriggerTelemetrySink::ReadTelemetryFile(const FString& Path, TArray<FOGTriggerTelemetryWindow>& OutWindows)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+		return false;
+
+	FMemoryReader Ar(Bytes);
+	while (!Ar.AtEnd())
+	{
+		uint32 Magic = 0;
+		int32 Version = 0;
+		Ar << Magic;
+		Ar << Version;
+		if (Ar.IsError() || Magic != OGTriggerTelemetry::Magic
+			|| Version < int32(OGTriggerTelemetry::EVersion::Initial) || Version > int32(OGTriggerTelemetry::EVersion::Latest))
+			return false;
+
+		FOGTriggerTelemetryWindow Window;
+		Ar << Window.StartTime;
+		Ar << Window.EndTime;
+		//Counts are checked against the bytes left before anything is sized from them, so a corrupted file can't ask for a huge allocation
+		int32 NumNames = 0;
+		Ar << NumNames;
+		if (Ar.IsError() || !OGTriggerTelemetry::CanHold(Ar, NumNames, OGTriggerTelemetry::MinNameBytes))
+			return false;
+		TArray<FString> Names;
+		Names.SetNum(NumNames);
+		for (FString& Name : Names)
+		{
+			Ar << Name;
+		}
+		int32 NumRows = 0;
+		Ar << NumRows;
+		if (Ar.IsError() || !OGTriggerTelemetry::CanHold(Ar, NumRows, OGTriggerTelemetry::MinRowBytes))
+			return false;
+		TArray<uint32> TypeColumn, TagsColumn, ClassColumn, CountColumn;
+		OGTriggerTelemetry::SerializePackedColumn(Ar, TypeColumn, NumRows);
+		OGTriggerTelemetry::SerializePackedColumn(Ar, TagsColumn, NumRows);
+		OGTriggerTelemetry::SerializePackedColumn(Ar, ClassColumn, NumRows);
+		OGTriggerTelemetry::SerializePackedColumn(Ar, CountColumn, NumRows);
+		if (Ar.IsError())
+			return false;
+
+		Window.Rows.Reserve(NumRows);
+		for (int32 Row = 0; Row < NumRows; ++Row)
+		{
+			if (!Names.IsValidIndex(TypeColumn[Row]) || !Names.IsValidIndex(TagsColumn[Row]) || !Names.IsValidIndex(ClassColumn[Row]))
+				return false;
+			Window.Rows.Add({Names[TypeColumn[Row]], Names[TagsColumn[Row]], Names[ClassColumn[Row]], CountColumn[Row]});
+		}
+		OutWindows.Add(MoveTemp(Window));
+	}
+	return true;
+}
@@ -0,0 +1,113 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+
+#include "OGTriggerTimerWheel.h"
+
+FOGTriggerTimerWheel::FOGTriggerTimerWheel(double InTickSeconds) :
+	TickSeconds(InTickSeconds)
+{
+}
+
+void FOGTriggerTimerWheel::Schedule(const FOGTriggerTimer& Timer, double InTime)
+{
+	//Round up, a timer never expires before its time
+	const double Ticks = FMath::CeilToDouble(InTime / TickSeconds);
+	const uint64 ExpiryTick = Ticks > double(CurrentTick) ? uint64(Ticks) : CurrentTick + 1;
+	ScheduleAtTick({Timer, ExpiryTick});
+	NumTimers++;
+}
+
+void FOGTriggerTimerWheel::ScheduleAtTick(const FEntry& Entry)
+{
+	//Timers further away than the whole wheel wait in the last level and are placed again every time it cascades
+	static constexpr uint64 MaxDelta = (uint64(1) << (SlotBits * NumLevels)) - 1;
+	const uint64 ExpiryTick = FMath::Min(Entry.ExpiryTick, CurrentTick + MaxDelta);
+
+	//The level is the lowest one where the expiry and the current tick only differ in that level's digit or below,
+	//which guarantees the slot is reached by the cascade before the timer is due
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && (ExpiryTick >> (SlotBits * (Level + 1))) != (CurrentTick >> (SlotBits * (Level + 1))))
+	{
+		Level++;
+	}
+	const int32 Slot = int32((ExpiryTick >> (SlotBits * Level)) & (NumSlots - 1));
+	Slots[Level][Slot].Add(Entry);
+}
+
+void FOGTriggerTimerWheel::Cascade(int32 Level)
+{
+	const int32 Slot = int32((CurrentTick >> (SlotBits * Level)) & (NumSlots - 1));
+	FSlot Entries = MoveTemp(Slots[Level][Slot]);
+	Slots[Level][Slot].Reset();
+	for (const FEntry& Entry : Entries)
+	{
+		ScheduleAtTick(Entry);
+	}
+}
+
+void FOGTriggerTimerWheel::Advance(double InTime, TArray<FOGTriggerTimer>& OutExpired)
+{
+	Time = FMath::Max(Time, InTime);
+	const uint64 TargetTick = uint64(FMath::FloorToDouble(Time / TickSeconds));
+	while (CurrentTick < TargetTick)
+	{
+		//Nothing to expire, jump straight to the target
+		if (NumTimers == 0)
+		{
+			CurrentTick = TargetTick;
+			break;
+		}
+		++CurrentTick;
+
+		//Every time a level wraps around, the next slot of the level above moves down, highest level first
+		int32 NumWrappedLevels = 0;
+		while (NumWrappedLevels < NumLevels - 1 && ((CurrentTick >> (SlotBits * NumWrappedLevels)) & (NumSlots - 1)) == 0)
+		{
+			NumWrappedLevels++;
+		}
+		for (int32 Level = NumWrappedLevels; Level > 0; --Level)
+		{
+			Cascade(Level);
+		}
+
+		FSlot& Slot = Slots[0][CurrentTick & (NumSlots - 1)];
+		FSlot Expired = MoveTemp(Slot);
+		Slot.Reset();
+		for (const FEntry& Entry : Expired)
+		{
+			//Only timers that were clamped to the end of the wheel can still be in the future
+			if (Entry.ExpiryTick > CurrentTick)
+			{
+				ScheduleAtTick(Entry);
+				continue;
+			}
+			OutExpired.Add(Entry.Timer);
+			NumTimers--;
+		}
+	}
+}
+
+void FOGTriggerTimerWheel::Reset()
+{
+	for (FSlot (&Level)[NumSlots] : Slots)
+	{
+		for (FSlot& Slot : Level)
+		{
+			Slot.Empty();
+		}
+	}
+	NumTimers = 0;
+}
+
+SIZE_T FOGTriggerTimerWheel::GetAllocatedSize() const
+{
+	SIZE_T Size = 0;
+	for (const FSlot (&Level)[NumSlots] : Slots)
+	{
+		for (const FSlot& Slot : Level)
+		{
+			Size += Slot.GetAllocatedSize();
+		}
+	}
+	return Size;
+}
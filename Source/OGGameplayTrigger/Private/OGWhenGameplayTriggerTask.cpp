@@ -1,109 +1,135 @@
-﻿// Fill out your copyright notice in the Description page of Project Settings.
-
-
-#include "OGWhenGameplayTriggerTask.h"
-
-#include "OGGameplayTriggerSubsystem.h"
-
-UOGWhenGameplayTriggerTask* UOGWhenGameplayTriggerTask::WhenGameplayTrigger(TScriptInterface<IGameplayTaskOwnerInterface> TaskOwner, const FGameplayTag TriggerType, EOGTriggerListenerPhases TriggerPhase,
-                                                                            const bool bOnce, const bool bShouldFireForExistingTriggers, const UObject* FilterInstigator, const UObject* FilterTarget,
-                                                                            const TArray<UOGGameplayTriggerFilter*>& Filters)
-{
-	if (!ensureMsgf(TriggerPhase, TEXT("Tried to start a trigger listener with no trigger phase")))
-		return nullptr;
-	
-	UOGWhenGameplayTriggerTask* Task = NewTask<UOGWhenGameplayTriggerTask>(TaskOwner);
-	if (!Task)
-		return nullptr;
-	
-	Task->TriggerType = TriggerType;
-	Task->TriggerPhase = TriggerPhase;
-	Task->bShouldFireForExistingTriggers = bShouldFireForExistingTriggers;
-	Task->bOnce = bOnce;
-	Task->FilterInstigator = FilterInstigator;
-	Task->FilterTarget = FilterTarget;
-	Task->FilterObjects = Filters;
-
-	return Task;
-}
-
-
-
-void UOGWhenGameplayTriggerTask::OnTrigger(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& Phases, const UOGGameplayTriggerContext* TriggerContext)
-{
-	When.Broadcast(TriggerHandle, TriggerContext);
-	if (bOnce)
-	{
-		EndTask();
-	}
-}
-
-void UOGWhenGameplayTriggerTask::Activate()
-{
-	UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(this);
-	Handle = TriggerSubsystem->RegisterTriggerListener(TriggerType, TriggerPhase, FOGTriggerDelegate::CreateUObject(this, &UOGWhenGameplayTriggerTask::OnTrigger), FilterInstigator, FilterTarget, bShouldFireForExistingTriggers, FilterObjects, &WhenListenerRemoved);
-	WhenListenerRemoved->Then(TOGFuture<void>::FThenDelegate::CreateUObject(this, &UOGWhenGameplayTriggerTask::EndTask));
-}
-
-void UOGWhenGameplayTriggerTask::OnDestroy(bool bInOwnerFinished)
-{
-	//clear the delegate immediately in case there are other triggers pending
-	When.Clear();
-	//Remove the trigger listener if it hasn't been already.
-	Handle.Reset();
-	FilterObjects.Empty();
-	Super::OnDestroy(bInOwnerFinished);
-}
-
-UOGWhenGameplayTriggerTask_MultiPhase* UOGWhenGameplayTriggerTask_MultiPhase::WhenGameplayTrigger_MultiPhase(TScriptInterface<IGameplayTaskOwnerInterface> TaskOwner,
-	const FGameplayTag TriggerType, const bool bShouldFireForExistingTriggers, const UObject* FilterInstigator, const UObject* FilterTarget, const TArray<UOGGameplayTriggerFilter*>& Filters)
-{
-	UOGWhenGameplayTriggerTask_MultiPhase* Task = NewTask<UOGWhenGameplayTriggerTask_MultiPhase>(TaskOwner);
-
-	if (!Task)
-		return nullptr;
-
-	Task->TriggerType = TriggerType;
-	Task->bShouldFireForExistingTriggers = bShouldFireForExistingTriggers;
-	Task->FilterInstigator = FilterInstigator;
-	Task->FilterTarget = FilterTarget;
-	Task->FilterObjects = Filters;
-
-	return Task;
-}
-
-void UOGWhenGameplayTriggerTask_MultiPhase::OnTrigger(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& Phases, const UOGGameplayTriggerContext* TriggerContext) const
-{
-	if (!!(Phases & EOGTriggerListenerPhases::TriggerStart))
-	{
-		WhenStart.Broadcast(TriggerHandle, TriggerContext);
-	}
-	else if (!!(Phases & EOGTriggerListenerPhases::TriggerEnd))
-	{
-		WhenEnd.Broadcast(TriggerHandle, TriggerContext);
-	}
-	else
-	{
-		ensure(!!(Phases & EOGTriggerListenerPhases::TriggerUpdate));
-		WhenUpdate.Broadcast(TriggerHandle, TriggerContext);
-	}
-}
-
-void UOGWhenGameplayTriggerTask_MultiPhase::Activate()
-{
-	UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(this);
-	Handle = TriggerSubsystem->RegisterTriggerListener(TriggerType, EOGTriggerListenerPhases::All, FOGTriggerDelegate::CreateUObject(this, &UOGWhenGameplayTriggerTask_MultiPhase::OnTrigger), FilterInstigator, FilterTarget, bShouldFireForExistingTriggers, FilterObjects, &WhenListenerRemoved);
-	WhenListenerRemoved->Then(TOGFuture<void>::FThenDelegate::CreateUObject(this, &UOGWhenGameplayTriggerTask::EndTask));
-}
-
-void UOGWhenGameplayTriggerTask_MultiPhase::OnDestroy(bool bInOwnerFinished)
-{
-	//clear the delegate immediately in case there are other triggers pending
-	WhenStart.Clear();
-	WhenUpdate.Clear();
-	WhenEnd.Clear();
-	//Remove the trigger listener if it hasn't been already.
-	Handle.Reset();
-	
-	Super::OnDestroy(bInOwnerFinished);
-}
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "OGWhenGameplayTriggerTask.h"
+
+#include "OGGameplayTriggerSubsystem.h"
+
+UOGWhenGameplayTriggerTask* UOGWhenGameplayTriggerTask::WhenGameplayTrigger(TScriptInterface<IGameplayTaskOwnerInterface> TaskOwner, const FGameplayTag TriggerType, EOGTriggerListenerPhases TriggerPhase,
+                                                                            const bool bOnce, const bool bShouldFireForExistingTriggers, const UObject* FilterInstigator, const UObject* FilterTarget,
+                                                                            const TArray<UOGGameplayTriggerFilter*>& Filters)
+{
+	if (!ensureMsgf(TriggerPhase, TEXT("Tried to start a trigger listener with no trigger phase")))
+		return nullptr;
+	
+	UOGWhenGameplayTriggerTask* Task = NewTask<UOGWhenGameplayTriggerTask>(TaskOwner);
+	if (!Task)
+		return nullptr;
+	
+	Task->TriggerType = TriggerType;
+	Task->TriggerPhase = TriggerPhase;
+	Task->bShouldFireForExistingTriggers = bShouldFireForExistingTriggers;
+	Task->bOnce = bOnce;
+	Task->FilterInstigator = FilterInstigator;
+	Task->FilterTarget = FilterTarget;
+	Task->FilterObjects = Filters;
+
+	return Task;
+}
+
+UOGWhenGameplayTriggerTask* UOGWhenGameplayTriggerTask::WhenAnyGameplayTrigger(TScriptInterface<IGameplayTaskOwnerInterface> TaskOwner, const FGameplayTagContainer& TriggerTypes,
+	EOGTriggerListenerPhases TriggerPhase, const bool bOnce, const bool bShouldFireForExistingTriggers, const UObject* FilterInstigator, const UObject* FilterTarget,
+	const TArray<UOGGameplayTriggerFilter*>& Filters)
+{
+	if (!ensureMsgf(TriggerTypes.IsValid(), TEXT("Tried to start a trigger listener with no trigger type")))
+		return nullptr;
+	
+	UOGWhenGameplayTriggerTask* Task = WhenGameplayTrigger(TaskOwner, FGameplayTag::EmptyTag, TriggerPhase, bOnce, bShouldFireForExistingTriggers, FilterInstigator, FilterTarget, Filters);
+	if (!Task)
+		return nullptr;
+	
+	Task->TriggerTypes = TriggerTypes;
+	return Task;
+}
+
+void UOGWhenGameplayTriggerTask::OnTrigger(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& Phases, const UOGGameplayTriggerContext* TriggerContext)
+{
+	When.Broadcast(TriggerHandle, TriggerContext);
+	if (bOnce)
+	{
+		EndTask();
+	}
+}
+
+void UOGWhenGameplayTriggerTask::Activate()
+{
+	UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(this);
+	const FOGTriggerDelegate Delegate = FOGTriggerDelegate::CreateUObject(this, &UOGWhenGameplayTriggerTask::OnTrigger);
+	if (TriggerTypes.IsEmpty())
+	{
+		Handle = TriggerSubsystem->RegisterTriggerListener(TriggerType, TriggerPhase, Delegate, FilterInstigator, FilterTarget, bShouldFireForExistingTriggers, FilterObjects, &WhenListenerRemoved);
+	}
+	else
+	{
+		FOGTriggerListenerOptions Options;
+		Options.FilterInstigator = FilterInstigator;
+		Options.FilterTarget = FilterTarget;
+		Options.bShouldFireForExistingTriggers = bShouldFireForExistingTriggers;
+		Options.Filters = ObjectPtrDecay(FilterObjects);
+		Handle = TriggerSubsystem->RegisterTriggerListener(TriggerTypes, TriggerPhase, Delegate, Options, &WhenListenerRemoved);
+	}
+	WhenListenerRemoved->Then(TOGFuture<void>::FThenDelegate::CreateUObject(this, &UOGWhenGameplayTriggerTask::EndTask));
+}
+
+void UOGWhenGameplayTriggerTask::OnDestroy(bool bInOwnerFinished)
+{
+	//clear the delegate immediately in case there are other triggers pending
+	When.Clear();
+	//Remove the trigger listener if it hasn't been already.
+	Handle.Reset();
+	FilterObjects.Empty();
+	Super::OnDestroy(bInOwnerFinished);
+}
+
+UOGWhenGameplayTriggerTask_MultiPhase* UOGWhenGameplayTriggerTask_MultiPhase::WhenGameplayTrigger_MultiPhase(TScriptInterface<IGameplayTaskOwnerInterface> TaskOwner,
+	const FGameplayTag TriggerType, const bool bShouldFireForExistingTriggers, const UObject* FilterInstigator, const UObject* FilterTarget, const TArray<UOGGameplayTriggerFilter*>& Filters)
+{
+	UOGWhenGameplayTriggerTask_MultiPhase* Task = NewTask<UOGWhenGameplayTriggerTask_MultiPhase>(TaskOwner);
+
+	if (!Task)
+		return nullptr;
+
+	Task->TriggerType = TriggerType;
+	Task->bShouldFireForExistingTriggers = bShouldFireForExistingTriggers;
+	Task->FilterInstigator = FilterInstigator;
+	Task->FilterTarget = FilterTarget;
+	Task->FilterObjects = Filters;
+
+	return Task;
+}
+
+void UOGWhenGameplayTriggerTask_MultiPhase::OnTrigger(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& Phases, const UOGGameplayTriggerContext* TriggerContext) const
+{
+	if (!!(Phases & EOGTriggerListenerPhases::TriggerStart))
+	{
+		WhenStart.Broadcast(TriggerHandle, TriggerContext);
+	}
+	else if (!!(Phases & EOGTriggerListenerPhases::TriggerEnd))
+	{
+		WhenEnd.Broadcast(TriggerHandle, TriggerContext);
+	}
+	else
+	{
+		ensure(!!(Phases & EOGTriggerListenerPhases::TriggerUpdate));
+		WhenUpdate.Broadcast(TriggerHandle, TriggerContext);
+	}
+}
+
+void UOGWhenGameplayTriggerTask_MultiPhase::Activate()
+{
+	UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(this);
+	Handle = TriggerSubsystem->RegisterTriggerListener(TriggerType, EOGTriggerListenerPhases::All, FOGTriggerDelegate::CreateUObject(this, &UOGWhenGameplayTriggerTask_MultiPhase::OnTrigger), FilterInstigator, FilterTarget, bShouldFireForExistingTriggers, FilterObjects, &WhenListenerRemoved);
+	WhenListenerRemoved->Then(TOGFuture<void>::FThenDelegate::CreateUObject(this, &UOGWhenGameplayTriggerTask::EndTask));
+}
+
+void UOGWhenGameplayTriggerTask_MultiPhase::OnDestroy(bool bInOwnerFinished)
+{
+	//clear the delegate immediately in case there are other triggers pending
+	WhenStart.Clear();
+	WhenUpdate.Clear();
+	WhenEnd.Clear();
+	//Remove the trigger listener if it hasn't been already.
+	Handle.Reset();
+	
+	Super::OnDestroy(bInOwnerFinished);
+}
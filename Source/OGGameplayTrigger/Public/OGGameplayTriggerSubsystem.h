@@ -1,180 +1,249 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "OGFuture.h"
-#include "Subsystems/WorldSubsystem.h"
-#include "OGGameplayTriggerTypes.h"
-#include "OGGameplayTriggerSubsystem.generated.h"
-
-DECLARE_DELEGATE_ThreeParams(FOGTriggerDelegate, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*)
-
-class UOGGameplayTriggerSubsystem;
-
-USTRUCT(BlueprintType)
-struct OGGAMEPLAYTRIGGER_API FOGTriggerListenerData
-{
-	GENERATED_BODY()
-
-	FOGTriggerListenerData() {}
-	
-	FOGTriggerListenerData(const FGameplayTag& InTriggerType, EOGTriggerListenerPhases InListenerPhases,
-		const FOGTriggerDelegate& InCallback, const UObject* FilterInstigatorObject = nullptr, const UObject* FilterTargetObject = nullptr,
-		const TArray<UOGGameplayTriggerFilter*>& Filters = TArray<UOGGameplayTriggerFilter*>());
-
-	~FOGTriggerListenerData();
-	
-	FGameplayTag TriggerType = FGameplayTag::EmptyTag;
-
-	EOGTriggerListenerPhases ListenerPhases = EOGTriggerListenerPhases::None;
-
-	bool bFilterOnInstigator = false;
-	TWeakObjectPtr<const UObject> InstigatorObject = nullptr;
-	bool bFilterOnTarget = false;
-	TWeakObjectPtr<const UObject> TargetObject = nullptr;
-	
-	FOGTriggerDelegate Callback;
-	
-	TArray<TStrongObjectPtr<UOGGameplayTriggerFilter>> FilterObjects;
-	
-	TOGPromise<void> WhenListenerRemoved;
-	
-	bool ShouldListenerProcessTrigger(EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& bOutIsFilterStale) const;
-};
-
-/**
- * Central manager for a universal event / trigger system.
- * Triggers are primarily identified by GameplayTag, but can be further filtered based on the data in the event payload
- * Processing callbacks for an event are treated as atomic
- *	- changes to Trigger Listeners and Trigger operations are delayed until after the current callbacks are complete.
- * However, If an event listener is registered with the ShouldFireForExistingTriggers flag and
- * there are existing events that match the type / filters, then the callback will run for those immediately.
- */
-UCLASS(BlueprintType)
-class OGGAMEPLAYTRIGGER_API UOGGameplayTriggerSubsystem : public UWorldSubsystem
-{
-	GENERATED_BODY()
-
-	struct FOGPendingTriggerOperation
-	{
-		FOGPendingTriggerOperation() {}
-		FOGPendingTriggerOperation(const FOGGameplayTriggerHandle& InHandle, const EOGTriggerOperationFlags& InOperation) : Handle(InHandle), Operation(InOperation) {}
-		FOGPendingTriggerOperation(const FOGGameplayTriggerHandle& InHandle, const EOGTriggerOperationFlags& InOperation, UOGGameplayTriggerContext* InTriggerContext)
-			: Handle(InHandle), Operation(InOperation)
-		{
-			ensureMsgf(!!(Operation & (EOGTriggerOperationFlags::Op_AddActiveTrigger | EOGTriggerOperationFlags::Op_UpdateActiveTrigger)), TEXT("Only some operations support containing trigger context"));
-			StoredTriggerContext = TStrongObjectPtr(InTriggerContext);
-		}
-
-		FOGGameplayTriggerHandle Handle = FOGHandleBase::EmptyHandle<FOGGameplayTriggerHandle>();
-		EOGTriggerOperationFlags Operation = EOGTriggerOperationFlags::None;
-		TStrongObjectPtr<UOGGameplayTriggerContext> StoredTriggerContext = nullptr;
-	};
-
-	typedef TMap<FOGTriggerListenerHandle, TSharedRef<FOGTriggerListenerData>> ListenerMap;
-	typedef TMap<FOGGameplayTriggerHandle, TStrongObjectPtr<UOGGameplayTriggerContext>> TriggerMap;
-public:
-
-	static UOGGameplayTriggerSubsystem* Get(const UObject* WorldContextObject);
-
-	UFUNCTION(BlueprintCallable, Category="GameplayTrigger", meta=(AutoCreateRefTerm="TriggerType,TriggerTags"))
-	UOGGameplayTriggerContext* MakeGameplayTriggerContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
-
-	/// Prepares a trigger context for modification before passing to UpdateTrigger. If there is any ongoing trigger processing,
-	/// this will create a deep-copy of the context for the given handle so the pending triggers are not changed before they are processed.
-	/// If there is no ongoing trigger processing, this will simply return the trigger context for the given trigger.
-	/// @param TriggerHandle The handle of the trigger to copy the context for
-	/// @return A trigger context that can be modified and passed to UpdateTrigger
-	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
-	UOGGameplayTriggerContext* GetTriggerContextForUpdate(const FOGGameplayTriggerHandle& TriggerHandle);
-	
-	//TODO: Add filter information
-	FOGTriggerListenerHandle RegisterTriggerListener(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
-		const UObject* FilterInstigator = nullptr, const UObject* FilterTarget = nullptr, const bool bShouldFireForExistingTriggers = false, const TArray<UOGGameplayTriggerFilter*>& Filters = TArray<UOGGameplayTriggerFilter*>(), TOGFuture<void>* OutWhenListenerRemoved = nullptr);
-
-	//Convenience function to make it easier to create listeners with weak lambda callbacks
-	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
-	FOGTriggerListenerHandle RegisterTriggerListener(const UObject* ContextObject, const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, Func Lambda,
-		const UObject* FilterInstigator = nullptr, const UObject* FilterTarget = nullptr, const bool bShouldFireForExistingTriggers = false, const TArray<UOGGameplayTriggerFilter*>& Filters = TArray<UOGGameplayTriggerFilter*>(), TOGFuture<void>* OutWhenListenerRemoved = nullptr)
-	{
-		return RegisterTriggerListener(TriggerType, Phases, FOGTriggerDelegate::CreateWeakLambda(ContextObject, Lambda),
-			FilterInstigator, FilterTarget, bShouldFireForExistingTriggers, Filters, OutWhenListenerRemoved);
-	}
-	
-	void RemoveTriggerListener(const FOGTriggerListenerHandle& Handle);
-	
-	// Start a trigger that does not persist - Takes a TriggerContext that has been created with MakeGameplayTriggerContext
-	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
-	FOGGameplayTriggerHandle InstantaneousTrigger(UOGGameplayTriggerContext* TriggerContext);
-	// Start a trigger that does not persist - Creates the TriggerContext internally
-	UFUNCTION(BlueprintCallable, Category="GameplayTrigger", DisplayName="InstantaneousTriggerSimple", meta=(AutoCreateRefTerm="TriggerType,TriggerTags"))
-	FOGGameplayTriggerHandle InstantaneousTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
-
-	// Start a trigger that will remain active until you call EndTrigger - Takes a TriggerContext that has been created with MakeGameplayTriggerContext
-	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
-	FOGGameplayTriggerHandle StartTrigger(UOGGameplayTriggerContext* TriggerContext);
-	// Start a trigger that will remain active until you call EndTrigger - Creates the TriggerContext internally
-	UFUNCTION(BlueprintCallable, Category="GameplayTrigger", DisplayName="StartTriggerSimple", meta=(AutoCreateRefTerm="TriggerType,TriggerTags"))
-	FOGGameplayTriggerHandle StartTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
-
-	// Update a trigger trigger with 
-	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
-	void UpdateTrigger(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* UpdatedTriggerContext);
-	
-	// End a trigger that was started with StartTrigger
-	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
-	void EndTrigger(const FOGGameplayTriggerHandle& Handle);
-
-	//Checks if the handle references an active trigger, may not be true immediately after a StartTrigger call if the trigger was placed in the pending operations queue
-	bool IsTriggerActive(const FOGGameplayTriggerHandle& Handle);
-	//Checks if the handle references an active trigger, or a trigger that is pending activation (while not also pending removal)
-	bool IsTriggerActiveOrPending(const FOGGameplayTriggerHandle& Handle);
-	//Checks if the listener referenced by that handle is listening for new trigger events
-	bool IsListenerHandleValid(const FOGTriggerListenerHandle& Handle);
-
-	virtual void Deinitialize() override;
-
-protected:
-	FOGGameplayTriggerHandle StartTrigger_Internal(UOGGameplayTriggerContext* TriggerContext, EOGTriggerOperationFlags Operations);
-	
-private:
-
-	FOGTriggerListenerHandle CreateNewListenerHandle(const FGameplayTag& TriggerType);
-	FOGGameplayTriggerHandle CreateNewTriggerHandle(const FGameplayTag& TriggerType);
-
-	void EnqueueAndProcessOperation(const FOGPendingTriggerOperation& Operation);
-	void ProcessTriggerOperation(const FOGPendingTriggerOperation& TriggerOperation);
-	void ProcessTriggerCallbacks(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* TriggerContext);
-	
-	//TODO: real system for replicated event types
-	static bool IsTriggerTypeReplicated(const FGameplayTag& TriggerType) { return false; }
-	
-	void AddActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* Trigger);
-	void UpdateActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* Trigger);
-	void RemoveActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle);
-
-	void AddTriggerListener_Internal(const FOGTriggerListenerHandle& Handle, const TSharedRef<FOGTriggerListenerData>& Listener);
-	void RemoveTriggerListener_Internal(const FOGTriggerListenerHandle& Handle);
-
-	void EnqueueOperation(const FOGPendingTriggerOperation& Operation);
-	bool PeekOperation(FOGPendingTriggerOperation*& OutOperation) const;
-	void PopOperation();
-	
-	TMap<FGameplayTag, ListenerMap> ListenersByType;
-
-	//Used for event replication
-	//TODO: make this a fast array
-	UPROPERTY()
-	TArray<TObjectPtr<UOGGameplayTriggerContext>> ReplicatedTriggers;
-
-	TMap<FGameplayTag, TriggerMap> ActiveTriggersByType;
-	
-	/**
-	 * Data for pending operations
-	 */
-	ListenerMap ListenersPendingAdd;
-	TSet<FOGTriggerListenerHandle> ListenersPendingRemove;
-
-	TDoubleLinkedList<FOGPendingTriggerOperation> OperationQueue;
-};
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OGTriggerEngine.h"
+#include "OGTriggerTelemetry.h"
+#include "OGGameplayTriggerSubsystem.generated.h"
+
+/**
+ * Central manager for a universal event / trigger system.
+ * Triggers are primarily identified by GameplayTag, but can be further filtered based on the data in the event payload
+ * Processing callbacks for an event are treated as atomic
+ *	- changes to Trigger Listeners and Trigger operations are delayed until after the current callbacks are complete.
+ * However, If an event listener is registered with the ShouldFireForExistingTriggers flag and
+ * there are existing events that match the type / filters, then the callback will run for those immediately.
+ * Deferrable listeners are the exception to synchronous processing, their callbacks are run from Tick under a time budget.
+ * Dispatch itself lives in FOGTriggerEngine, the subsystem owns the engine of its world and forwards to it.
+ */
+UCLASS(BlueprintType)
+class OGGAMEPLAYTRIGGER_API UOGGameplayTriggerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UOGGameplayTriggerSubsystem* Get(const UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger", meta=(AutoCreateRefTerm="TriggerType,TriggerTags"))
+	UOGGameplayTriggerContext* MakeGameplayTriggerContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
+
+	/// Prepares a trigger context for modification before passing to UpdateTrigger. If there is any ongoing trigger processing,
+	/// this will create a deep-copy of the context for the given handle so the pending triggers are not changed before they are processed.
+	/// If there is no ongoing trigger processing, this will simply return the trigger context for the given trigger.
+	/// @param TriggerHandle The handle of the trigger to copy the context for
+	/// @return A trigger context that can be modified and passed to UpdateTrigger
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+	UOGGameplayTriggerContext* GetTriggerContextForUpdate(const FOGGameplayTriggerHandle& TriggerHandle);
+	
+	//TODO: Add filter information
+	FOGTriggerListenerHandle RegisterTriggerListener(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
+		const UObject* FilterInstigator = nullptr, const UObject* FilterTarget = nullptr, const bool bShouldFireForExistingTriggers = false, const TArray<UOGGameplayTriggerFilter*>& Filters = TArray<UOGGameplayTriggerFilter*>(), TOGFuture<void>* OutWhenListenerRemoved = nullptr);
+
+	//Convenience function to make it easier to create listeners with weak lambda callbacks
+	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
+	FOGTriggerListenerHandle RegisterTriggerListener(const UObject* ContextObject, const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, Func Lambda,
+		const UObject* FilterInstigator = nullptr, const UObject* FilterTarget = nullptr, const bool bShouldFireForExistingTriggers = false, const TArray<UOGGameplayTriggerFilter*>& Filters = TArray<UOGGameplayTriggerFilter*>(), TOGFuture<void>* OutWhenListenerRemoved = nullptr)
+	{
+		return RegisterTriggerListener(TriggerType, Phases, FOGTriggerDelegate::CreateWeakLambda(ContextObject, Lambda),
+			FilterInstigator, FilterTarget, bShouldFireForExistingTriggers, Filters, OutWhenListenerRemoved);
+	}
+
+	FOGTriggerListenerHandle RegisterTriggerListener(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
+		const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved = nullptr);
+
+	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
+	FOGTriggerListenerHandle RegisterTriggerListener(const UObject* ContextObject, const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, Func Lambda,
+		const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved = nullptr)
+	{
+		return RegisterTriggerListener(TriggerType, Phases, FOGTriggerDelegate::CreateWeakLambda(ContextObject, Lambda), Options, OutWhenListenerRemoved);
+	}
+
+	/// Registers one listener for every trigger type in TriggerTypes, see FOGTriggerEngine::RegisterTriggerListener
+	FOGTriggerListenerHandle RegisterTriggerListener(const FGameplayTagContainer& TriggerTypes, EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
+		const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved = nullptr);
+
+	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
+	FOGTriggerListenerHandle RegisterTriggerListener(const UObject* ContextObject, const FGameplayTagContainer& TriggerTypes, EOGTriggerListenerPhases Phases, Func Lambda,
+		const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved = nullptr)
+	{
+		return RegisterTriggerListener(TriggerTypes, Phases, FOGTriggerDelegate::CreateWeakLambda(ContextObject, Lambda), Options, OutWhenListenerRemoved);
+	}
+
+	/// Registers an AnyThread listener that produces a result for every trigger it receives.
+	/// Work runs on the task graph against a frozen copy of the trigger context, so dispatch never waits for it.
+	/// OnResultPending is called on the game thread during dispatch with a future that is fulfilled on the game thread once Work has finished.
+	template<typename TResult>
+	FOGTriggerListenerHandle RegisterAnyThreadTriggerListener(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases,
+		TFunction<TResult(const FOGGameplayTriggerHandle&, EOGTriggerListenerPhases, const UOGGameplayTriggerContext*)> Work,
+		TFunction<void(const FOGGameplayTriggerHandle&, TOGFuture<TResult>)> OnResultPending,
+		FOGTriggerListenerOptions Options = FOGTriggerListenerOptions(), TOGFuture<void>* OutWhenListenerRemoved = nullptr)
+	{
+		return Engine.RegisterAnyThreadTriggerListener<TResult>(TriggerType, Phases, MoveTemp(Work), MoveTemp(OnResultPending), MoveTemp(Options), OutWhenListenerRemoved);
+	}
+	
+	void RemoveTriggerListener(const FOGTriggerListenerHandle& Handle);
+
+	/// Creates an empty listener group. Listeners join it through FOGTriggerListenerOptions::Group
+	FOGTriggerListenerGroupHandle CreateListenerGroup();
+	/// Removes every listener registered under the group, then the group itself.
+	/// Costs one compaction pass per trigger type the group has listeners for, regardless of how many listeners it holds.
+	void RemoveListenerGroup(const FOGTriggerListenerGroupHandle& Group);
+
+	/// Lightweight alternative to UOGWhenGameplayTriggerTask for C++ and OGAsync flows: waits for the next trigger of TriggerType
+	/// that matches Phases and the filters in Options. Backed by a pooled internal listener that removes itself after firing, no UObject is allocated.
+	/// The future is fulfilled synchronously during dispatch, so the context is only guaranteed to be valid inside the continuation.
+	/// @param OutHandle Optionally receives the handle of the internal listener, so the wait can be cancelled with RemoveTriggerListener
+	TOGFuture<const UOGGameplayTriggerContext*> WaitForTrigger(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases,
+		const FOGTriggerListenerOptions& Options = FOGTriggerListenerOptions(), FOGTriggerListenerHandle* OutHandle = nullptr);
+
+	/// True if a listener of TriggerType, a tap, an aggregate view or a composite trigger would receive a trigger of that type in any of Phases.
+	/// Never visits the listeners, meant to skip building triggers nobody would receive (see FireLazy)
+	bool HasListeners(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases = EOGTriggerListenerPhases::All) const { return Engine.HasListeners(TriggerType, Phases); }
+
+	/// Fires an instantaneous trigger of TriggerType, but only creates its context and runs BuildContext if something could receive it (see HasListeners).
+	/// @param BuildContext Called with the new context to fill in its initiator, target, tags and data bank
+	/// @return The handle of the trigger, or an invalid handle if nothing receives TriggerType
+	template<typename Func UE_REQUIRES(std::is_invocable_v<Func, UOGGameplayTriggerContext&>)>
+	FOGGameplayTriggerHandle FireLazy(const FGameplayTag& TriggerType, Func&& BuildContext)
+	{
+		return Engine.FireLazy(TriggerType, Forward<Func>(BuildContext));
+	}
+
+	/// Stops the trigger that is currently being dispatched from reaching any lower priority listeners.
+	/// Only valid from inside a listener callback. The remaining listeners are skipped without evaluating their filters.
+	void ConsumeTrigger();
+
+	/// Opts a trigger type into same-frame coalescing. Instantaneous triggers of that type with the same instigator and target are merged
+	/// into a single dispatch per frame, which happens from Tick. Every merged trigger returns the handle of the dispatched one.
+	/// @param Merge Folds each incoming trigger into the first one of the frame. If unbound, the first trigger is dispatched unchanged
+	void RegisterTriggerCoalescing(const FGameplayTag& TriggerType, const FOGTriggerMergeDelegate& Merge);
+	/// Dispatches every trigger that is waiting for the end of the frame, then stops coalescing that type
+	void UnregisterTriggerCoalescing(const FGameplayTag& TriggerType);
+	/// Dispatches every coalesced trigger now instead of waiting for Tick
+	void FlushCoalescedTriggers();
+	int32 GetNumPendingCoalescedTriggers() const { return Engine.GetNumPendingCoalescedTriggers(); }
+	
+	// Start a trigger that does not persist - Takes a TriggerContext that has been created with MakeGameplayTriggerContext
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+	FOGGameplayTriggerHandle InstantaneousTrigger(UOGGameplayTriggerContext* TriggerContext);
+	// Start a trigger that does not persist - Creates the TriggerContext internally
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger", DisplayName="InstantaneousTriggerSimple", meta=(AutoCreateRefTerm="TriggerType,TriggerTags"))
+	FOGGameplayTriggerHandle InstantaneousTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
+
+	// Start a trigger that will remain active until you call EndTrigger - Takes a TriggerContext that has been created with MakeGameplayTriggerContext
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+	FOGGameplayTriggerHandle StartTrigger(UOGGameplayTriggerContext* TriggerContext);
+	// Start a trigger that will remain active until you call EndTrigger - Creates the TriggerContext internally
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger", DisplayName="StartTriggerSimple", meta=(AutoCreateRefTerm="TriggerType,TriggerTags"))
+	FOGGameplayTriggerHandle StartTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
+	// Start a trigger that can end itself after a duration and fire periodic updates while it is active
+	FOGGameplayTriggerHandle StartTrigger(UOGGameplayTriggerContext* TriggerContext, const FOGTriggerStartOptions& Options);
+	// Start a trigger that ends itself after Duration seconds and fires TriggerUpdate every UpdateInterval seconds, 0 disables either
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+	FOGGameplayTriggerHandle StartTimedTrigger(UOGGameplayTriggerContext* TriggerContext, float Duration, float UpdateInterval = 0.f);
+	// Start a timed trigger - Creates the TriggerContext internally
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger", DisplayName="StartTimedTriggerSimple", meta=(AutoCreateRefTerm="TriggerType,TriggerTags"))
+	FOGGameplayTriggerHandle StartTimedTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, float Duration, float UpdateInterval = 0.f,
+		UObject* Initiator = nullptr, UObject* Target = nullptr);
+
+	// Update a trigger trigger with 
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+	void UpdateTrigger(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* UpdatedTriggerContext);
+	
+	// End a trigger that was started with StartTrigger
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+	void EndTrigger(const FOGGameplayTriggerHandle& Handle);
+
+	//Checks if the handle references an active trigger, may not be true immediately after a StartTrigger call if the trigger was placed in the pending operations queue
+	bool IsTriggerActive(const FOGGameplayTriggerHandle& Handle);
+	//Checks if the handle references an active trigger, or a trigger that is pending activation (while not also pending removal)
+	bool IsTriggerActiveOrPending(const FOGGameplayTriggerHandle& Handle);
+	//Checks if the listener referenced by that handle is listening for new trigger events
+	bool IsListenerHandleValid(const FOGTriggerListenerHandle& Handle);
+	//Checks if the group has been created and not removed yet
+	bool IsListenerGroupValid(const FOGTriggerListenerGroupHandle& Group) const { return Engine.IsListenerGroupValid(Group); }
+	/// Adds a tap that sees every dispatched trigger, whatever its type, see FOGTriggerEngine::AddTriggerTap
+	FOGTriggerTapHandle AddTriggerTap(const FOGTriggerDelegate& Delegate, const FOGTriggerTapOptions& Options = FOGTriggerTapOptions()) { return Engine.AddTriggerTap(Delegate, Options); }
+	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
+	FOGTriggerTapHandle AddTriggerTap(const UObject* ContextObject, Func Lambda, const FOGTriggerTapOptions& Options = FOGTriggerTapOptions())
+	{
+		return Engine.AddTriggerTap(ContextObject, MoveTemp(Lambda), Options);
+	}
+	void RemoveTriggerTap(const FOGTriggerTapHandle& Handle) { Engine.RemoveTriggerTap(Handle); }
+	bool IsTriggerTapValid(const FOGTriggerTapHandle& Handle) const { return Engine.IsTriggerTapValid(Handle); }
+	/// Creates a view that keeps an aggregate of the active triggers of a type, see FOGTriggerEngine::CreateAggregateView
+	FOGTriggerAggregateViewHandle CreateAggregateView(const FOGTriggerAggregateViewOptions& Options) { return Engine.CreateAggregateView(Options); }
+	void RemoveAggregateView(const FOGTriggerAggregateViewHandle& Handle) { Engine.RemoveAggregateView(Handle); }
+	bool IsAggregateViewValid(const FOGTriggerAggregateViewHandle& Handle) const { return Engine.IsAggregateViewValid(Handle); }
+	double ReadAggregateView(const FOGTriggerAggregateViewHandle& Handle, const UObject* Key = nullptr, double DefaultValue = 0.0) const
+	{
+		return Engine.ReadAggregateView(Handle, Key, DefaultValue);
+	}
+	int32 GetAggregateViewCount(const FOGTriggerAggregateViewHandle& Handle, const UObject* Key = nullptr) const { return Engine.GetAggregateViewCount(Handle, Key); }
+	/// Creates a trigger derived from a condition over the active triggers of other types, see FOGTriggerEngine::CreateCompositeTrigger
+	FOGTriggerCompositeHandle CreateCompositeTrigger(const FOGTriggerCompositeOptions& Options) { return Engine.CreateCompositeTrigger(Options); }
+	void RemoveCompositeTrigger(const FOGTriggerCompositeHandle& Handle) { Engine.RemoveCompositeTrigger(Handle); }
+	bool IsCompositeTriggerValid(const FOGTriggerCompositeHandle& Handle) const { return Engine.IsCompositeTriggerValid(Handle); }
+	bool IsCompositeTriggerActive(const FOGTriggerCompositeHandle& Handle, const UObject* Key = nullptr) const { return Engine.IsCompositeTriggerActive(Handle, Key); }
+	//Number of deferrable listener callbacks waiting for a future tick
+	int32 GetNumPendingDeferredCallbacks() const { return Engine.GetNumPendingDeferredCallbacks(); }
+	//Number of active triggers with an auto-end duration or periodic updates
+	int32 GetNumTimedTriggers() const { return Engine.GetNumTimedTriggers(); }
+	//Number of spatial listeners that follow an actor
+	int32 GetNumTrackedListeners() const { return Engine.GetNumTrackedListeners(); }
+	//Seconds the trigger engine has been ticked for, the clock of timed triggers and trigger history
+	double GetEngineTime() const { return Engine.GetEngineTime(); }
+
+	/// Keeps the last Capacity instantaneous triggers of TriggerType, so listeners registered later can replay them (see FOGTriggerListenerOptions::ReplayHistorySince).
+	/// Each slot of the ring owns a context that is reused for the triggers recorded into it, so memory stays bounded per type
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+	void EnableTriggerHistory(const FGameplayTag& TriggerType, int32 Capacity);
+	UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+	void DisableTriggerHistory(const FGameplayTag& TriggerType);
+	bool IsTriggerHistoryEnabled(const FGameplayTag& TriggerType) const { return Engine.IsTriggerHistoryEnabled(TriggerType); }
+	int32 GetNumTriggersInHistory(const FGameplayTag& TriggerType) const { return Engine.GetNumTriggersInHistory(TriggerType); }
+	const FOGTriggerSweepStats& GetSweepStats() const { return Engine.GetSweepStats(); }
+	const FOGTriggerMemoryStats& GetMemoryStats() const { return Engine.GetMemoryStats(); }
+	/// Releases per-type tables that have been empty, and shrinks the ones that have been oversized, since the previous trim pass.
+	/// Runs from Tick every OG.GameplayTrigger.TrimIdleSeconds, only exposed to force a pass (e.g. after a level transition)
+	void TrimTables();
+
+	/// Serializes every active trigger (handle, context and data bank) into a compact, versioned binary blob.
+	/// Object references are stored as paths so the blob can be restored after level transitions, seamless travel or a load.
+	/// @param OutBytes Receives the snapshot
+	/// @return false if the snapshot could not be written, e.g. because trigger operations are still being processed
+	bool SaveActiveTriggers(TArray<uint8>& OutBytes) const;
+
+	/// Bulk-rebuilds the active trigger tables from a blob written by SaveActiveTriggers, without replaying any game logic.
+	/// Restored triggers get new handles, the handles of the session that was saved could collide with the ones generated in this one.
+	/// @param Bytes A snapshot written by SaveActiveTriggers
+	/// @param RestoreMode Whether TriggerStart should be fired for the restored triggers
+	/// @param OutRestoredHandles If set, receives the new handle of every restored trigger, keyed by the handle it was saved with
+	/// @return false if the snapshot is malformed or from a newer version, in which case nothing is restored
+	bool RestoreActiveTriggers(const TArray<uint8>& Bytes, EOGTriggerRestoreMode RestoreMode = EOGTriggerRestoreMode::Silent,
+		TMap<FOGGameplayTriggerHandle, FOGGameplayTriggerHandle>* OutRestoredHandles = nullptr);
+
+	FOGTriggerEngine& GetEngine() { return Engine; }
+	const FOGTriggerEngine& GetEngine() const { return Engine; }
+	// Set while OG.GameplayTrigger.Telemetry was enabled when the world started
+	FOGTriggerTelemetrySink* GetTelemetrySink() const { return TelemetrySink.Get(); }
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	FOGGameplayTriggerHandle StartTrigger_Internal(UOGGameplayTriggerContext* TriggerContext, EOGTriggerOperationFlags Operations);
+
+private:
+	UFUNCTION()
+	void HandleBoundActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	FOGTriggerEngine Engine{this};
+	TUniquePtr<FOGTriggerTelemetrySink> TelemetrySink;
+};
@@ -1,151 +1,261 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UObject/Object.h"
-#include "GameplayTagContainer.h"
-#include "OGHandleBase.h"
-#include "OGPolymorphicDataBank.h"
-#include "OGGameplayTriggerTypes.generated.h"
-
-class UOGGameplayTriggerSubsystem;
-
-UENUM(meta = (BitFlags))
-enum class EOGTriggerOperationFlags : uint8
-{
-    None                        = 0,
-    Op_AddActiveTrigger         = 1 << 0,
-    Op_UpdateActiveTrigger      = 1 << 1,
-    Op_ProcessCallbacks         = 1 << 2,
-    Op_NetworkRPC               = 1 << 3,
-    Op_RemoveActiveTrigger      = 1 << 4,
-    
-    InstantaneousTrigger        = Op_AddActiveTrigger | Op_ProcessCallbacks | Op_RemoveActiveTrigger,
-    NetworkedInstantaneous      = InstantaneousTrigger | Op_NetworkRPC,
-    OpenTrigger                 = Op_AddActiveTrigger | Op_ProcessCallbacks,
-    UpdateTrigger               = Op_UpdateActiveTrigger | Op_ProcessCallbacks,
-    CloseTrigger                = Op_ProcessCallbacks | Op_RemoveActiveTrigger
-};
-ENUM_CLASS_FLAGS(EOGTriggerOperationFlags)
-
-UENUM(BlueprintType, meta = (BitFlags, UseEnumValuesAsMaskValuesInEditor = "true"))
-enum class EOGTriggerListenerPhases : uint8
-{
-    None            = 0 UMETA(Hidden),
-    TriggerStart    = EOGTriggerOperationFlags::Op_AddActiveTrigger,
-    TriggerUpdate   = EOGTriggerOperationFlags::Op_UpdateActiveTrigger,
-    TriggerEnd      = EOGTriggerOperationFlags::Op_RemoveActiveTrigger,
-
-    All             = TriggerStart | TriggerUpdate | TriggerEnd UMETA(Hidden)
-};
-ENUM_CLASS_FLAGS(EOGTriggerListenerPhases)
-
-USTRUCT(NotBlueprintType)
-struct OGGAMEPLAYTRIGGER_API FOGTriggerDataType : public FOGPolymorphicStructBase
-{
-    GENERATED_BODY()
-};
-
-USTRUCT(BlueprintType)
-struct OGGAMEPLAYTRIGGER_API FOGTriggerDataBank : public FOGPolymorphicDataBankBase
-{
-    GENERATED_BODY();
-
-    virtual UScriptStruct* GetInnerStruct() const override {return FOGTriggerDataType::StaticStruct();}
-};
-
-template<>
-struct TStructOpsTypeTraits<FOGTriggerDataBank> : public TStructOpsTypeTraitsBase2<FOGTriggerDataBank>
-{
-    enum
-    {
-        WithAddStructReferencedObjects = true,
-        //WithNetSerializer = true,
-        WithNetDeltaSerializer = true,
-    };
-};
-
-USTRUCT()
-struct OGGAMEPLAYTRIGGER_API FOGGameplayTriggerHandle : public FOGHandleBase
-{
-    GENERATED_BODY()
-
-    FOGGameplayTriggerHandle() : FOGHandleBase() {}
-    FOGGameplayTriggerHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
-
-    bool IsActive() const;
-    virtual bool IsValid() const override;
-    virtual void Reset() override;
-
-    UPROPERTY()
-    FGameplayTag TriggerType;
-
-    TWeakObjectPtr<UOGGameplayTriggerSubsystem> TriggerSubsystem = nullptr;
-};
-
-USTRUCT()
-struct OGGAMEPLAYTRIGGER_API FOGTriggerListenerHandle : public FOGHandleBase
-{
-    GENERATED_BODY()
-
-    FOGTriggerListenerHandle() : FOGHandleBase() {}
-    FOGTriggerListenerHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
-
-    virtual bool IsValid() const override;
-    virtual void Reset() override;
-
-    UPROPERTY()
-    FGameplayTag TriggerType;
-
-    TWeakObjectPtr<UOGGameplayTriggerSubsystem> TriggerSubsystem = nullptr;
-};
-
-UCLASS(BlueprintType)
-class OGGAMEPLAYTRIGGER_API UOGGameplayTriggerContext : public UObject
-{
-    GENERATED_BODY()
-
-public:
-
-    virtual void GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const override;
-    
-    UPROPERTY(Replicated)
-    FGameplayTag TriggerType = FGameplayTag::EmptyTag;
-
-    UPROPERTY(Replicated)
-    TObjectPtr<UObject> InitiatorObject = nullptr;
-    
-    UPROPERTY(Replicated)
-    TObjectPtr<UObject> TargetObject = nullptr;
-
-    UPROPERTY(Replicated, BlueprintReadWrite)
-    FGameplayTagContainer TriggerTags = FGameplayTagContainer::EmptyContainer;
-    
-    UPROPERTY(Replicated, BlueprintReadWrite)
-    FOGTriggerDataBank DataBank;
-};
-
-UCLASS(Blueprintable, Abstract)
-class OGGAMEPLAYTRIGGER_API UOGGameplayTriggerFilter : public UObject
-{
-    GENERATED_BODY()
-
-public:
-    // If a trigger fails to pass any of the filters registered on the filter, the listener will not be called for that trigger.
-    bool DoesTriggerPassFilter(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const;
-
-protected:
-
-    // Setting IsTriggerBlocked true will prevent the trigger from firing the listener this filter is attached to.
-    // Setting IsFilterStale true will cause the listener this filter is attached to be cleaned up.
-    // IsFilterStale should only be true if the filter detects that it will block all triggers from this point on
-    // This could happen because an object that the filter needs is no longer valid
-    UFUNCTION(BlueprintImplementableEvent, DisplayName="DoesFilterBlockTrigger")
-    void DoesTriggerPassFilter_BP(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& bDoesTriggerPass, bool& bIsFilterStale) const;
-    // Returning true will prevent the trigger from firing on the listener this filter is attached to.
-    // Setting IsFilterStale true will cause the listener this filter is attached to be cleaned up.
-    // IsFilterStale should only be true if the filter detects that it will block all triggers from this point on
-    // This could happen because an object that the filter needs is no longer valid
-    virtual bool DoesTriggerPassFilter_Native(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const {return true;}
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameplayTagContainer.h"
+#include "OGHandleBase.h"
+#include "OGPolymorphicDataBank.h"
+#include "OGTriggerTagSet.h"
+#include "OGGameplayTriggerTypes.generated.h"
+
+class UOGGameplayTriggerSubsystem;
+
+UENUM(meta = (BitFlags))
+enum class EOGTriggerOperationFlags : uint8
+{
+    None                        = 0,
+    Op_AddActiveTrigger         = 1 << 0,
+    Op_UpdateActiveTrigger      = 1 << 1,
+    Op_ProcessCallbacks         = 1 << 2,
+    Op_NetworkRPC               = 1 << 3,
+    Op_RemoveActiveTrigger      = 1 << 4,
+    
+    InstantaneousTrigger        = Op_AddActiveTrigger | Op_ProcessCallbacks | Op_RemoveActiveTrigger,
+    NetworkedInstantaneous      = InstantaneousTrigger | Op_NetworkRPC,
+    OpenTrigger                 = Op_AddActiveTrigger | Op_ProcessCallbacks,
+    UpdateTrigger               = Op_UpdateActiveTrigger | Op_ProcessCallbacks,
+    CloseTrigger                = Op_ProcessCallbacks | Op_RemoveActiveTrigger
+};
+ENUM_CLASS_FLAGS(EOGTriggerOperationFlags)
+
+UENUM(BlueprintType, meta = (BitFlags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EOGTriggerListenerPhases : uint8
+{
+    None            = 0 UMETA(Hidden),
+    TriggerStart    = EOGTriggerOperationFlags::Op_AddActiveTrigger,
+    TriggerUpdate   = EOGTriggerOperationFlags::Op_UpdateActiveTrigger,
+    TriggerEnd      = EOGTriggerOperationFlags::Op_RemoveActiveTrigger,
+
+    All             = TriggerStart | TriggerUpdate | TriggerEnd UMETA(Hidden)
+};
+ENUM_CLASS_FLAGS(EOGTriggerListenerPhases)
+
+USTRUCT(NotBlueprintType)
+struct OGGAMEPLAYTRIGGER_API FOGTriggerDataType : public FOGPolymorphicStructBase
+{
+    GENERATED_BODY()
+};
+
+USTRUCT(BlueprintType)
+struct OGGAMEPLAYTRIGGER_API FOGTriggerDataBank : public FOGPolymorphicDataBankBase
+{
+    GENERATED_BODY();
+
+    virtual UScriptStruct* GetInnerStruct() const override {return FOGTriggerDataType::StaticStruct();}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTriggerDataBank> : public TStructOpsTypeTraitsBase2<FOGTriggerDataBank>
+{
+    enum
+    {
+        WithAddStructReferencedObjects = true,
+        //WithNetSerializer = true,
+        WithNetDeltaSerializer = true,
+    };
+};
+
+USTRUCT()
+struct OGGAMEPLAYTRIGGER_API FOGGameplayTriggerHandle : public FOGHandleBase
+{
+    GENERATED_BODY()
+
+    FOGGameplayTriggerHandle() : FOGHandleBase() {}
+    FOGGameplayTriggerHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+
+    bool IsActive() const;
+    virtual bool IsValid() const override;
+    virtual void Reset() override;
+
+    UPROPERTY()
+    FGameplayTag TriggerType;
+
+    TWeakObjectPtr<UOGGameplayTriggerSubsystem> TriggerSubsystem = nullptr;
+};
+
+USTRUCT()
+struct OGGAMEPLAYTRIGGER_API FOGTriggerListenerHandle : public FOGHandleBase
+{
+    GENERATED_BODY()
+
+    FOGTriggerListenerHandle() : FOGHandleBase() {}
+    FOGTriggerListenerHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+
+    virtual bool IsValid() const override;
+    virtual void Reset() override;
+
+    UPROPERTY()
+    FGameplayTag TriggerType;
+
+    TWeakObjectPtr<UOGGameplayTriggerSubsystem> TriggerSubsystem = nullptr;
+};
+
+// Identifies a set of listeners that can be removed together with UOGGameplayTriggerSubsystem::RemoveListenerGroup
+USTRUCT()
+struct OGGAMEPLAYTRIGGER_API FOGTriggerListenerGroupHandle : public FOGHandleBase
+{
+    GENERATED_BODY()
+
+    FOGTriggerListenerGroupHandle() : FOGHandleBase() {}
+    FOGTriggerListenerGroupHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+
+    virtual bool IsValid() const override;
+    // Removes every listener in the group
+    virtual void Reset() override;
+
+    TWeakObjectPtr<UOGGameplayTriggerSubsystem> TriggerSubsystem = nullptr;
+};
+
+// Identifies a tap added with UOGGameplayTriggerSubsystem::AddTriggerTap
+USTRUCT()
+struct OGGAMEPLAYTRIGGER_API FOGTriggerTapHandle : public FOGHandleBase
+{
+    GENERATED_BODY()
+
+    FOGTriggerTapHandle() : FOGHandleBase() {}
+    FOGTriggerTapHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+
+    virtual bool IsValid() const override;
+    // Removes the tap
+    virtual void Reset() override;
+
+    TWeakObjectPtr<UOGGameplayTriggerSubsystem> TriggerSubsystem = nullptr;
+};
+
+// Identifies an aggregate view created with UOGGameplayTriggerSubsystem::CreateAggregateView
+USTRUCT()
+struct OGGAMEPLAYTRIGGER_API FOGTriggerAggregateViewHandle : public FOGHandleBase
+{
+    GENERATED_BODY()
+
+    FOGTriggerAggregateViewHandle() : FOGHandleBase() {}
+    FOGTriggerAggregateViewHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+
+    virtual bool IsValid() const override;
+    // Removes the view
+    virtual void Reset() override;
+
+    TWeakObjectPtr<UOGGameplayTriggerSubsystem> TriggerSubsystem = nullptr;
+};
+
+// Identifies a composite trigger created with UOGGameplayTriggerSubsystem::CreateCompositeTrigger
+USTRUCT()
+struct OGGAMEPLAYTRIGGER_API FOGTriggerCompositeHandle : public FOGHandleBase
+{
+    GENERATED_BODY()
+
+    FOGTriggerCompositeHandle() : FOGHandleBase() {}
+    FOGTriggerCompositeHandle(OGHandleIdType InHandle) : FOGHandleBase(InHandle) {}
+
+    virtual bool IsValid() const override;
+    // Removes the composite, ending its derived triggers
+    virtual void Reset() override;
+
+    TWeakObjectPtr<UOGGameplayTriggerSubsystem> TriggerSubsystem = nullptr;
+};
+
+UCLASS(BlueprintType)
+class OGGAMEPLAYTRIGGER_API UOGGameplayTriggerContext : public UObject
+{
+    GENERATED_BODY()
+
+public:
+
+    virtual void GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const override;
+    
+    UPROPERTY(Replicated)
+    FGameplayTag TriggerType = FGameplayTag::EmptyTag;
+
+    UPROPERTY(Replicated)
+    TObjectPtr<UObject> InitiatorObject = nullptr;
+    
+    UPROPERTY(Replicated)
+    TObjectPtr<UObject> TargetObject = nullptr;
+
+    // Interned, so contexts with the same tags share them. GetTriggerTags and SetTriggerTags are the only way to read and write the tags
+    UPROPERTY(Replicated)
+    FOGTriggerTagSetId TriggerTagSet;
+
+    const FOGTriggerTagSet& GetTriggerTagSet() const { return TriggerTagSet.Get(); }
+    UFUNCTION(BlueprintPure, Category="GameplayTrigger")
+    const FGameplayTagContainer& GetTriggerTags() const { return TriggerTagSet->Tags; }
+    UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+    void SetTriggerTags(const FGameplayTagContainer& InTriggerTags) { TriggerTagSet = FOGTriggerTagSetId(InTriggerTags); }
+    
+    UPROPERTY(Replicated, BlueprintReadWrite)
+    FOGTriggerDataBank DataBank;
+
+    // Adds the payload of a typed trigger (see TOGTypedTrigger) to the data bank
+    template<typename T>
+    T& SetTypedPayload(const T& Payload)
+    {
+        T& StoredPayload = DataBank.AddUnique<T>();
+        StoredPayload = Payload;
+        return StoredPayload;
+    }
+    // Looked up in the data bank every time, the bank is the only copy of the payload and adding data to it may move the payload
+    template<typename T>
+    const T* GetTypedPayload() const
+    {
+        return DataBank.FindConst<T>();
+    }
+
+    // Located triggers only reach spatial listeners within Radius (plus the listener's own radius) of Location.
+    // Listeners registered without a location receive them like any other trigger.
+    // Transient because active trigger snapshots write them separately, so older snapshots still load
+    UPROPERTY(Transient, Replicated, BlueprintReadOnly)
+    bool bHasLocation = false;
+    UPROPERTY(Transient, Replicated, BlueprintReadOnly)
+    FVector Location = FVector::ZeroVector;
+    UPROPERTY(Transient, Replicated, BlueprintReadOnly)
+    float Radius = 0.f;
+
+    UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+    void SetLocation(const FVector& InLocation, float InRadius);
+    UFUNCTION(BlueprintCallable, Category="GameplayTrigger")
+    void ClearLocation();
+};
+
+UCLASS(Blueprintable, Abstract)
+class OGGAMEPLAYTRIGGER_API UOGGameplayTriggerFilter : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    // If a trigger fails to pass any of the filters registered on the filter, the listener will not be called for that trigger.
+    bool DoesTriggerPassFilter(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const;
+    // Checked by the background listener sweep, so stale filters are released even if their trigger type never fires again
+    bool IsFilterStale() const;
+
+protected:
+
+    // Setting IsTriggerBlocked true will prevent the trigger from firing the listener this filter is attached to.
+    // Setting IsFilterStale true will cause the listener this filter is attached to be cleaned up.
+    // IsFilterStale should only be true if the filter detects that it will block all triggers from this point on
+    // This could happen because an object that the filter needs is no longer valid
+    UFUNCTION(BlueprintImplementableEvent, DisplayName="DoesFilterBlockTrigger")
+    void DoesTriggerPassFilter_BP(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& bDoesTriggerPass, bool& bIsFilterStale) const;
+    // Returning true will prevent the trigger from firing on the listener this filter is attached to.
+    // Setting IsFilterStale true will cause the listener this filter is attached to be cleaned up.
+    // IsFilterStale should only be true if the filter detects that it will block all triggers from this point on
+    // This could happen because an object that the filter needs is no longer valid
+    virtual bool DoesTriggerPassFilter_Native(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const {return true;}
+
+    // Setting IsFilterStale true will cause the listener this filter is attached to be cleaned up, without waiting for a trigger.
+    // Same rules as the IsFilterStale output of DoesFilterBlockTrigger
+    UFUNCTION(BlueprintImplementableEvent, DisplayName="IsFilterStale")
+    void IsFilterStale_BP(bool& bIsFilterStale) const;
+    virtual bool IsFilterStale_Native() const {return false;}
 };
\ No newline at end of file
@@ -0,0 +1,1095 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "OGFuture.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/ObjectKey.h"
+#include "OGGameplayTriggerTypes.h"
+#include "OGTriggerTimerWheel.h"
+#include "OGTriggerEngine.generated.h"
+
+DECLARE_DELEGATE_ThreeParams(FOGTriggerDelegate, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*)
+// Folds the incoming trigger (e.g. its damage) into the trigger that will be dispatched for the frame
+DECLARE_DELEGATE_TwoParams(FOGTriggerMergeDelegate, UOGGameplayTriggerContext* /*MergedTrigger*/, const UOGGameplayTriggerContext* /*IncomingTrigger*/)
+
+class AActor;
+class UOGGameplayTriggerSubsystem;
+
+/**
+ * Read-only copy of a trigger context handed to AnyThread listeners.
+ * The copy is never modified after dispatch, so its fields can be read from any thread while the callback holds an FGCScopeGuard.
+ * Object pointers held by the copy (initiator, target...) must still not be dereferenced off the game thread.
+ */
+struct FOGFrozenTriggerContext
+{
+	explicit FOGFrozenTriggerContext(UOGGameplayTriggerContext* InContext) : Context(InContext) {}
+
+	const UOGGameplayTriggerContext* Get() const { return Context.Get(); }
+
+private:
+	//Strong references have to be released on the game thread, so the last reference to a frozen context is always handed back to it
+	TStrongObjectPtr<UOGGameplayTriggerContext> Context;
+};
+typedef TSharedPtr<FOGFrozenTriggerContext, ESPMode::ThreadSafe> FOGFrozenTriggerContextPtr;
+
+typedef TFunction<void(const FOGGameplayTriggerHandle&, EOGTriggerListenerPhases, const FOGFrozenTriggerContextPtr&)> FOGTriggerAnyThreadDispatch;
+
+enum class EOGTriggerRunOn : uint8
+{
+	// The callback runs synchronously during dispatch (or in Tick if the listener is deferrable)
+	GameThread,
+	// The callback runs on the task graph with a frozen copy of the context, dispatch does not wait for it
+	AnyThread
+};
+
+UENUM()
+enum class EOGTriggerRestoreMode : uint8
+{
+	// Rebuild the active trigger tables without firing any callbacks
+	Silent,
+	// Start every restored trigger like StartTrigger does, in a single operation batch
+	FireTriggerStart
+};
+
+/**
+ * Optional settings for a trigger listener.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerListenerOptions
+{
+	// Only receive triggers initiated by this object
+	const UObject* FilterInstigator = nullptr;
+	// Only receive triggers targeting this object
+	const UObject* FilterTarget = nullptr;
+	// Immediately run the callback for matching triggers that are already active. Requires listening to TriggerStart
+	bool bShouldFireForExistingTriggers = false;
+	// Every filter has to pass for the callback to run
+	TArray<UOGGameplayTriggerFilter*> Filters;
+	// Listeners with a higher priority are called first, listeners with equal priority are called in registration order
+	int32 Priority = 0;
+	// Deferrable callbacks (VFX, UI, audio...) run in the engine tick under a per-frame time budget instead of synchronously.
+	// Callbacks that don't fit in the budget spill over into the next frame. Deferred callbacks cannot consume triggers.
+	bool bDeferrable = false;
+	// AnyThread callbacks (analytics, telemetry...) are handed a frozen copy of the context and run on the task graph.
+	// Their delegate can't be bound to a UObject (weak lambdas included), it would be resolved off the game thread
+	EOGTriggerRunOn RunOn = EOGTriggerRunOn::GameThread;
+	// Minimum number of seconds of engine time between two calls of the listener, triggers in between are ignored before any filter runs
+	float MinInterval = 0.f;
+	// Maximum number of calls of the listener per engine tick, 0 for no limit
+	int32 MaxPerFrame = 0;
+	// The trigger has to have all of these tags (or children of them) for the listener to be called
+	FGameplayTagContainer RequiredTags;
+	// The listener is not called if the trigger has any of these tags (or children of them)
+	FGameplayTagContainer BlockedTags;
+	// Spatial listeners only receive located triggers that reach them (see UOGGameplayTriggerContext::SetLocation), and are skipped by
+	// dispatch without being visited otherwise. Either a fixed location, or an actor whose location is refreshed once per frame
+	TOptional<FVector> Location;
+	const AActor* TrackedActor = nullptr;
+	// Extra distance at which located triggers still reach a spatial listener (e.g. hearing range)
+	float Radius = 0.f;
+	// Immediately runs the callback for the instantaneous triggers kept in the type's history (see EnableTriggerHistory) that fired at or after this time,
+	// oldest first. Uses the engine clock, see GetEngineTime. Requires listening to TriggerStart or TriggerEnd
+	TOptional<double> ReplayHistorySince;
+	// Registers the listener as part of a group created with CreateListenerGroup, so it is removed along with the rest of the group
+	FOGTriggerListenerGroupHandle Group;
+	// The listener is removed as soon as its owner ends play (actors) or is garbage collected (other objects).
+	// Defaults to the object the callback is bound to. FilterInstigator and FilterTarget bind the listener the same way.
+	const UObject* Owner = nullptr;
+};
+
+/**
+ * Optional settings for a trigger started with StartTrigger.
+ * Timed triggers are driven by a timer wheel inside the engine, so they don't need an FTimerHandle each.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerStartOptions
+{
+	// Ends the trigger after this many seconds (game time), 0 keeps it active until EndTrigger is called
+	float Duration = 0.f;
+	// Fires TriggerUpdate with the current context every this many seconds while the trigger is active, 0 disables periodic updates
+	float UpdateInterval = 0.f;
+};
+
+/**
+ * Optional settings for a trigger tap added with AddTriggerTap.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerTapOptions
+{
+	// Phases the tap is called for. Instantaneous triggers are dispatched once with both TriggerStart and TriggerEnd set
+	EOGTriggerListenerPhases Phases = EOGTriggerListenerPhases::All;
+	// Fraction of the matching triggers the tap is called for, between 0 and 1. Sampling is deterministic (a rate of 0.25 calls the tap
+	// for every fourth trigger), so the cost of a tap is fixed by its rate rather than by the traffic
+	float SampleRate = 1.f;
+};
+
+enum class EOGTriggerAggregateOp : uint8
+{
+	// Number of active triggers
+	Count,
+	// Sum of the values of the active triggers
+	Sum,
+	// Smallest value of the active triggers
+	Min,
+	// Largest value of the active triggers
+	Max,
+};
+
+enum class EOGTriggerAggregateKey : uint8
+{
+	// A single aggregate over every active trigger of the type
+	None,
+	// One aggregate per instigator
+	Instigator,
+	// One aggregate per target
+	Target,
+};
+
+/**
+ * Declaration of an aggregate view created with CreateAggregateView.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerAggregateViewOptions
+{
+	FGameplayTag TriggerType;
+	EOGTriggerAggregateOp Op = EOGTriggerAggregateOp::Count;
+	EOGTriggerAggregateKey KeyBy = EOGTriggerAggregateKey::None;
+	// Value of a trigger for Sum, Min and Max, see DataField. Triggers it returns no value for are left out of the view.
+	// Called whenever a trigger of the type starts or is updated, so it should only read the context
+	TFunction<TOptional<double>(const UOGGameplayTriggerContext&)> Value;
+
+	/// Reads a numeric field of a data type in the trigger's data bank, e.g. DataField(&FSlowData::Magnitude).
+	/// Triggers without the data type have no value
+	template<typename TData, typename TField>
+	static TFunction<TOptional<double>(const UOGGameplayTriggerContext&)> DataField(TField TData::*Field)
+	{
+		static_assert(std::is_arithmetic_v<TField>, "Aggregate views can only read numeric fields");
+		return [Field](const UOGGameplayTriggerContext& Trigger) -> TOptional<double>
+		{
+			const TData* Data = Trigger.DataBank.FindConst<TData>();
+			return Data ? TOptional<double>(double(Data->*Field)) : TOptional<double>();
+		};
+	}
+};
+
+/**
+ * Condition on the number of active triggers of a type, see FOGTriggerCompositeOptions.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerCompositeTerm
+{
+	FGameplayTag TriggerType;
+	// Holds while at least MinCount triggers of the type are active
+	int32 MinCount = 1;
+	// Holds while fewer than MinCount triggers of the type are active instead
+	bool bNegated = false;
+};
+
+/**
+ * Declaration of a composite trigger created with CreateCompositeTrigger: a conjunction of terms over the active triggers of other types.
+ *
+ *	FOGTriggerCompositeOptions Options;
+ *	Options.OutputType = TAG_Trigger_Exposed;
+ *	Options.KeyBy = EOGTriggerAggregateKey::Target;
+ *	Options.Require(TAG_Trigger_Stunned).Require(TAG_Trigger_Burning).Exclude(TAG_Trigger_Shielded);
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerCompositeOptions
+{
+	// Type of the trigger started while every term holds, and ended as soon as one doesn't
+	FGameplayTag OutputType;
+	FGameplayTagContainer OutputTags;
+	// Evaluates the terms per instigator or target, the derived trigger then has that object as its instigator or target.
+	// Triggers without the object are left out
+	EOGTriggerAggregateKey KeyBy = EOGTriggerAggregateKey::None;
+	TArray<FOGTriggerCompositeTerm> Terms;
+
+	FOGTriggerCompositeOptions& Require(const FGameplayTag& TriggerType, int32 MinCount = 1)
+	{
+		Terms.Add({TriggerType, MinCount, false});
+		return *this;
+	}
+	FOGTriggerCompositeOptions& Exclude(const FGameplayTag& TriggerType)
+	{
+		Terms.Add({TriggerType, 1, true});
+		return *this;
+	}
+};
+
+/**
+ * Totals of the incremental stale listener sweep since the engine was created.
+ */
+struct FOGTriggerSweepStats
+{
+	int64 NumListenersVisited = 0;
+	int64 NumListenersReclaimed = 0;
+	// Filter references dropped by reclaimed listeners. A filter shared by several listeners is counted once per listener,
+	// and is only freed once nothing else references it
+	int64 NumFilterReferencesReleased = 0;
+	int32 NumCompletedPasses = 0;
+};
+
+/**
+ * Time and tick count of a trigger engine. Both only advance when the engine ticks, so rate limits follow the engine rather than the wall clock.
+ */
+struct FOGTriggerClock
+{
+	double Time = 0.0;
+	uint64 Frame = 0;
+};
+
+/**
+ * Size of the listener and active trigger tables. Peaks are kept for the lifetime of the engine,
+ * allocated sizes are sampled at every trim pass and don't include the trigger context objects themselves.
+ */
+struct FOGTriggerMemoryStats
+{
+	int32 NumListeners = 0;
+	int32 PeakListeners = 0;
+	int32 NumActiveTriggers = 0;
+	int32 PeakActiveTriggers = 0;
+	SIZE_T AllocatedBytes = 0;
+	SIZE_T PeakAllocatedBytes = 0;
+	// Per-type tables released or shrunk by the trim pass
+	int32 NumTrimmedTables = 0;
+};
+
+USTRUCT(BlueprintType)
+struct OGGAMEPLAYTRIGGER_API FOGTriggerListenerData
+{
+	GENERATED_BODY()
+
+	FOGTriggerListenerData() {}
+	
+	FOGTriggerListenerData(const FGameplayTag& InTriggerType, EOGTriggerListenerPhases InListenerPhases,
+		const FOGTriggerDelegate& InCallback, const UObject* FilterInstigatorObject = nullptr, const UObject* FilterTargetObject = nullptr,
+		const TArray<UOGGameplayTriggerFilter*>& Filters = TArray<UOGGameplayTriggerFilter*>());
+
+	FOGTriggerListenerData(const FGameplayTag& InTriggerType, EOGTriggerListenerPhases InListenerPhases,
+		const FOGTriggerDelegate& InCallback, const FOGTriggerListenerOptions& Options);
+
+	~FOGTriggerListenerData();
+
+	// Puts a pooled listener back in the state of a new one registered without a callback, reusing its allocations
+	void Reinit(const FGameplayTag& InTriggerType, EOGTriggerListenerPhases InListenerPhases, const FOGTriggerListenerOptions& Options);
+
+	FOGTriggerListenerHandle Handle;
+	
+	FGameplayTag TriggerType = FGameplayTag::EmptyTag;
+	// Further types of a listener registered against several trigger types. The listener is shared by the tables of every type,
+	// TriggerType is the one stamped on its handle
+	TArray<FGameplayTag> AdditionalTriggerTypes;
+
+	EOGTriggerListenerPhases ListenerPhases = EOGTriggerListenerPhases::None;
+
+	int32 Priority = 0;
+	bool bDeferrable = false;
+	EOGTriggerRunOn RunOn = EOGTriggerRunOn::GameThread;
+	// Set for AnyThread listeners, launches the callback on the task graph with the frozen context
+	FOGTriggerAnyThreadDispatch AnyThreadDispatch;
+
+	FOGTriggerListenerGroupHandle Group;
+
+	float MinInterval = 0.f;
+	int32 MaxPerFrame = 0;
+	double LastCallTime = TNumericLimits<double>::Lowest();
+	uint64 LastCallFrame = 0;
+	int32 NumCallsInFrame = 0;
+
+	FOGTriggerTagSetId RequiredTags;
+	FOGTriggerTagSetId BlockedTags;
+
+	bool bIsSpatial = false;
+	FVector Location = FVector::ZeroVector;
+	float Radius = 0.f;
+	TWeakObjectPtr<const AActor> TrackedActor;
+	// Still matches the tracked actor once it has been garbage collected, so the listener can be unbound from it
+	FObjectKey TrackedActorKey;
+	// Position in the listener list that was last edited, only maintained for spatial listeners. A hint for dispatch, which checks it against the pinned list
+	int32 SpatialListIndex = INDEX_NONE;
+
+	FObjectKey OwnerKey;
+
+	bool bFilterOnInstigator = false;
+	FObjectKey InstigatorKey;
+	bool bFilterOnTarget = false;
+	FObjectKey TargetKey;
+	
+	FOGTriggerDelegate Callback;
+	
+	TArray<TStrongObjectPtr<UOGGameplayTriggerFilter>> FilterObjects;
+	
+	TOGPromise<void> WhenListenerRemoved;
+
+	// Listeners created by WaitForTrigger fulfill this instead of running a callback, then remove themselves
+	bool bIsAwaiter = false;
+	bool bHasFired = false;
+	TOGPromise<const UOGGameplayTriggerContext*> AwaiterPromise = TOGPromise<const UOGGameplayTriggerContext*>(nullptr);
+
+	bool IsBoundTo(const FObjectKey& Object) const;
+	template<typename Func>
+	void ForEachTriggerType(Func&& Visitor) const
+	{
+		Visitor(TriggerType);
+		for (const FGameplayTag& AdditionalTriggerType : AdditionalTriggerTypes)
+		{
+			Visitor(AdditionalTriggerType);
+		}
+	}
+	bool IsInRangeOf(const UOGGameplayTriggerContext* Trigger) const
+	{
+		return !bIsSpatial || !Trigger->bHasLocation || FVector::DistSquared(Location, Trigger->Location) <= FMath::Square(Trigger->Radius + Radius);
+	}
+	// Only timestamp compares, so throttled listeners are rejected before anything else is looked at
+	bool IsRateLimited(const FOGTriggerClock& Clock) const
+	{
+		return (MinInterval > 0.f && Clock.Time < LastCallTime + MinInterval)
+			|| (MaxPerFrame > 0 && LastCallFrame == Clock.Frame && NumCallsInFrame >= MaxPerFrame);
+	}
+	void RecordCall(const FOGTriggerClock& Clock)
+	{
+		LastCallTime = Clock.Time;
+		NumCallsInFrame = LastCallFrame == Clock.Frame ? NumCallsInFrame + 1 : 1;
+		LastCallFrame = Clock.Frame;
+	}
+	// Full staleness check used by the background sweep. Too expensive for dispatch, which relies on owner tracking instead
+	bool IsStale() const;
+	
+	bool ShouldListenerProcessTrigger(EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, const FOGTriggerClock& Clock, bool& bOutIsFilterStale) const;
+
+private:
+	void SetFilters(const TArray<UOGGameplayTriggerFilter*>& Filters);
+	void ApplyOptions(const FOGTriggerListenerOptions& Options);
+};
+
+/**
+ * Trigger queue, listener storage and dispatch, without any dependency on a world.
+ * UOGGameplayTriggerSubsystem wraps one per world. Engines can also be created on their own, e.g. to simulate or benchmark trigger
+ * traffic without spinning up a world, and any number of them can run side by side since they share no state.
+ * Headless engines (without a subsystem) hand out handles whose convenience functions (EndTrigger, RemoveTriggerListener...) do nothing,
+ * calls have to go through the engine itself.
+ */
+class OGGAMEPLAYTRIGGER_API FOGTriggerEngine : public FNoncopyable
+{
+	struct FOGPendingTriggerOperation
+	{
+		FOGPendingTriggerOperation() {}
+		FOGPendingTriggerOperation(const FOGGameplayTriggerHandle& InHandle, const EOGTriggerOperationFlags& InOperation) : Handle(InHandle), Operation(InOperation) {}
+		FOGPendingTriggerOperation(const FOGGameplayTriggerHandle& InHandle, const EOGTriggerOperationFlags& InOperation, UOGGameplayTriggerContext* InTriggerContext)
+			: Handle(InHandle), Operation(InOperation)
+		{
+			ensureMsgf(!!(Operation & (EOGTriggerOperationFlags::Op_AddActiveTrigger | EOGTriggerOperationFlags::Op_UpdateActiveTrigger)), TEXT("Only some operations support containing trigger context"));
+			StoredTriggerContext = TStrongObjectPtr(InTriggerContext);
+		}
+
+		FOGGameplayTriggerHandle Handle = FOGHandleBase::EmptyHandle<FOGGameplayTriggerHandle>();
+		EOGTriggerOperationFlags Operation = EOGTriggerOperationFlags::None;
+		TStrongObjectPtr<UOGGameplayTriggerContext> StoredTriggerContext = nullptr;
+	};
+
+	struct FOGDeferredTriggerCallback
+	{
+		TWeakPtr<FOGTriggerListenerData> Listener;
+		FOGGameplayTriggerHandle TriggerHandle;
+		EOGTriggerListenerPhases TriggerPhase = EOGTriggerListenerPhases::None;
+		//Keeps the context alive until the callback has run. Persistent triggers may have been updated in place by then
+		TStrongObjectPtr<UOGGameplayTriggerContext> TriggerContext = nullptr;
+	};
+
+	typedef TArray<TSharedRef<FOGTriggerListenerData>> ListenerArray;
+
+	/**
+	 * The listeners of a single trigger type, sorted by descending priority. Listeners with equal priority are kept in registration order.
+	 * What dispatch needs to reject a listener (phases, tag requirements) is kept in arrays parallel to the listeners,
+	 * so rejecting listeners is a linear SIMD scan that never touches the listeners themselves.
+	 */
+	struct FOGTriggerListenerSnapshot
+	{
+		ListenerArray Listeners;
+		TArray<EOGTriggerListenerPhases> Phases;
+		TArray<FOGTriggerTagMask> RequiredTagMasks;
+		// Zero unless the blocked tags fold into the mask without collisions
+		TArray<FOGTriggerTagMask> BlockedTagMasks;
+		// Spatial listeners are only candidates for located triggers if the spatial grid finds them
+		TArray<bool> IsSpatial;
+		// Union of Phases, so HasListeners doesn't have to visit the listeners
+		EOGTriggerListenerPhases ListenedPhases = EOGTriggerListenerPhases::None;
+
+		int32 Num() const { return Listeners.Num(); }
+		int32 Max() const { return Listeners.Max(); }
+		bool IsEmpty() const { return Listeners.IsEmpty(); }
+		const TSharedRef<FOGTriggerListenerData>& operator[](int32 Index) const { return Listeners[Index]; }
+		ListenerArray::RangedForConstIteratorType begin() const { return Listeners.begin(); }
+		ListenerArray::RangedForConstIteratorType end() const { return Listeners.end(); }
+		template<typename Predicate>
+		int32 IndexOfByPredicate(Predicate Pred) const { return Listeners.IndexOfByPredicate(Pred); }
+		template<typename Predicate>
+		bool ContainsByPredicate(Predicate Pred) const { return Listeners.ContainsByPredicate(Pred); }
+		SIZE_T GetAllocatedSize() const;
+
+		void Insert(int32 Index, const TSharedRef<FOGTriggerListenerData>& Listener);
+		void RemoveAt(int32 Index);
+		// Stable, single pass over every parallel array
+		template<typename Predicate>
+		int32 RemoveAll(Predicate Pred)
+		{
+			int32 NumKept = 0;
+			for (int32 Index = 0; Index < Listeners.Num(); ++Index)
+			{
+				if (Pred(Listeners[Index]))
+					continue;
+				if (NumKept != Index)
+				{
+					Listeners[NumKept] = Listeners[Index];
+					Phases[NumKept] = Phases[Index];
+					RequiredTagMasks[NumKept] = RequiredTagMasks[Index];
+					BlockedTagMasks[NumKept] = BlockedTagMasks[Index];
+					IsSpatial[NumKept] = IsSpatial[Index];
+				}
+				if (IsSpatial[NumKept])
+				{
+					Listeners[NumKept]->SpatialListIndex = NumKept;
+				}
+				NumKept++;
+			}
+			const int32 NumRemoved = Listeners.Num() - NumKept;
+			Listeners.SetNum(NumKept, EAllowShrinking::No);
+			Phases.SetNum(NumKept, EAllowShrinking::No);
+			RequiredTagMasks.SetNum(NumKept, EAllowShrinking::No);
+			BlockedTagMasks.SetNum(NumKept, EAllowShrinking::No);
+			IsSpatial.SetNum(NumKept, EAllowShrinking::No);
+			UpdateListenedPhases();
+			return NumRemoved;
+		}
+		void Shrink();
+
+		// Sets the bit of every listener that may accept the trigger. Cleared bits are certain rejections,
+		// set bits still have to go through ShouldListenerProcessTrigger since tag masks can collide
+		void FindCandidates(EOGTriggerListenerPhases TriggerPhase, const FOGTriggerTagSet& TriggerTags, bool bTriggerHasLocation,
+			TBitArray<TInlineAllocator<4>>& OutCandidates) const;
+
+	private:
+		void UpdateSpatialListIndices(int32 FirstIndex);
+		void UpdateListenedPhases();
+	};
+
+	/**
+	 * Spatial hash of the spatial listeners of a single trigger type, listeners are bucketed by the cell their location is in.
+	 * Located triggers only visit the cells within their radius (plus the largest listener radius) instead of every listener of the type.
+	 */
+	struct FOGTriggerSpatialGrid
+	{
+		typedef TArray<FOGTriggerListenerData*, TInlineAllocator<4>> FCell;
+
+		// Takes the cell size from OG.GameplayTrigger.SpatialCellSize
+		FOGTriggerSpatialGrid();
+
+		// Fixed for the lifetime of the grid, so listeners are always looked for in the cell they were added to
+		double CellSize;
+		TMap<FIntVector, FCell> Cells;
+		// Listeners following an actor, their cell is refreshed once per frame
+		TArray<FOGTriggerListenerData*> TrackedListeners;
+		float MaxListenerRadius = 0.f;
+		int32 NumListeners = 0;
+
+		void Add(FOGTriggerListenerData& Listener);
+		void Remove(FOGTriggerListenerData& Listener);
+		void Move(FOGTriggerListenerData& Listener, const FVector& NewLocation);
+		// Calls Visitor for every listener in a cell the sphere overlaps, the listeners still have to check their actual distance
+		void ForEachListenerNear(const FVector& Location, float Radius, TFunctionRef<void(FOGTriggerListenerData&)> Visitor) const;
+		SIZE_T GetAllocatedSize() const;
+		FIntVector GetCell(const FVector& Location) const;
+	};
+
+	/**
+	 * Copy-on-write listener list for a single trigger type.
+	 * Dispatch pins the current snapshot and iterates it without any locking or pending sets.
+	 * Edits made while a snapshot is pinned go to a private copy that replaces it, so the dispatch keeps seeing the list it started with.
+	 */
+	struct FOGTriggerListenerList
+	{
+		TSharedRef<FOGTriggerListenerSnapshot> Snapshot = MakeShared<FOGTriggerListenerSnapshot>();
+		// Set while an aggregate view or a composite trigger watches the type, so HasListeners doesn't have to look them up
+		bool bIsObserved = false;
+		// Set while the type keeps a history, so FireLazy doesn't have to look it up
+		bool bKeepsHistory = false;
+
+		TSharedRef<const FOGTriggerListenerSnapshot> Pin() const { return Snapshot; }
+		const FOGTriggerListenerSnapshot& Get() const { return *Snapshot; }
+		FOGTriggerListenerSnapshot& Edit()
+		{
+			if (!Snapshot.IsUnique())
+			{
+				Snapshot = MakeShared<FOGTriggerListenerSnapshot>(*Snapshot);
+			}
+			return *Snapshot;
+		}
+	};
+	typedef TMap<FOGGameplayTriggerHandle, TStrongObjectPtr<UOGGameplayTriggerContext>> TriggerMap;
+public:
+
+	/// @param InSubsystem The subsystem that owns the engine, stamped on every handle and used as the outer of the trigger contexts. Null for headless engines
+	explicit FOGTriggerEngine(UOGGameplayTriggerSubsystem* InSubsystem = nullptr);
+	~FOGTriggerEngine();
+
+	UOGGameplayTriggerContext* MakeGameplayTriggerContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
+
+	/// Prepares a trigger context for modification before passing to UpdateTrigger. If there is any ongoing trigger processing,
+	/// this will create a deep-copy of the context for the given handle so the pending triggers are not changed before they are processed.
+	/// If there is no ongoing trigger processing, this will simply return the trigger context for the given trigger.
+	/// @param TriggerHandle The handle of the trigger to copy the context for
+	/// @return A trigger context that can be modified and passed to UpdateTrigger
+	UOGGameplayTriggerContext* GetTriggerContextForUpdate(const FOGGameplayTriggerHandle& TriggerHandle);
+	
+	//TODO: Add filter information
+	FOGTriggerListenerHandle RegisterTriggerListener(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
+		const UObject* FilterInstigator = nullptr, const UObject* FilterTarget = nullptr, const bool bShouldFireForExistingTriggers = false, const TArray<UOGGameplayTriggerFilter*>& Filters = TArray<UOGGameplayTriggerFilter*>(), TOGFuture<void>* OutWhenListenerRemoved = nullptr);
+
+	//Convenience function to make it easier to create listeners with weak lambda callbacks
+	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
+	FOGTriggerListenerHandle RegisterTriggerListener(const UObject* ContextObject, const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, Func Lambda,
+		const UObject* FilterInstigator = nullptr, const UObject* FilterTarget = nullptr, const bool bShouldFireForExistingTriggers = false, const TArray<UOGGameplayTriggerFilter*>& Filters = TArray<UOGGameplayTriggerFilter*>(), TOGFuture<void>* OutWhenListenerRemoved = nullptr)
+	{
+		return RegisterTriggerListener(TriggerType, Phases, FOGTriggerDelegate::CreateWeakLambda(ContextObject, Lambda),
+			FilterInstigator, FilterTarget, bShouldFireForExistingTriggers, Filters, OutWhenListenerRemoved);
+	}
+
+	FOGTriggerListenerHandle RegisterTriggerListener(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
+		const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved = nullptr);
+
+	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
+	FOGTriggerListenerHandle RegisterTriggerListener(const UObject* ContextObject, const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, Func Lambda,
+		const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved = nullptr)
+	{
+		return RegisterTriggerListener(TriggerType, Phases, FOGTriggerDelegate::CreateWeakLambda(ContextObject, Lambda), Options, OutWhenListenerRemoved);
+	}
+
+	/// Registers one listener for every trigger type in TriggerTypes (exact types, parents don't match their children).
+	/// The types share a single listener, so there is one handle and one WhenListenerRemoved future, and removing the listener
+	/// (or its owner going away) removes it from every type at once. Spatial listeners are indexed per type and can't listen to several types.
+	FOGTriggerListenerHandle RegisterTriggerListener(const FGameplayTagContainer& TriggerTypes, EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
+		const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved = nullptr);
+
+	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
+	FOGTriggerListenerHandle RegisterTriggerListener(const UObject* ContextObject, const FGameplayTagContainer& TriggerTypes, EOGTriggerListenerPhases Phases, Func Lambda,
+		const FOGTriggerListenerOptions& Options, TOGFuture<void>* OutWhenListenerRemoved = nullptr)
+	{
+		return RegisterTriggerListener(TriggerTypes, Phases, FOGTriggerDelegate::CreateWeakLambda(ContextObject, Lambda), Options, OutWhenListenerRemoved);
+	}
+
+	/// Registers an AnyThread listener that produces a result for every trigger it receives.
+	/// Work runs on the task graph against a frozen copy of the trigger context, so dispatch never waits for it.
+	/// OnResultPending is called on the game thread during dispatch with a future that is fulfilled on the game thread once Work has finished.
+	template<typename TResult>
+	FOGTriggerListenerHandle RegisterAnyThreadTriggerListener(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases,
+		TFunction<TResult(const FOGGameplayTriggerHandle&, EOGTriggerListenerPhases, const UOGGameplayTriggerContext*)> Work,
+		TFunction<void(const FOGGameplayTriggerHandle&, TOGFuture<TResult>)> OnResultPending,
+		FOGTriggerListenerOptions Options = FOGTriggerListenerOptions(), TOGFuture<void>* OutWhenListenerRemoved = nullptr)
+	{
+		typedef TFunction<TResult(const FOGGameplayTriggerHandle&, EOGTriggerListenerPhases, const UOGGameplayTriggerContext*)> FWork;
+		if (!ensure(Work) || !ensure(OnResultPending))
+			return FOGHandleBase::EmptyHandle<FOGTriggerListenerHandle>();
+		
+		Options.RunOn = EOGTriggerRunOn::AnyThread;
+		TSharedRef<FWork, ESPMode::ThreadSafe> SharedWork = MakeShared<FWork, ESPMode::ThreadSafe>(MoveTemp(Work));
+		FOGTriggerAnyThreadDispatch Dispatch = [SharedWork, OnResultPending = MoveTemp(OnResultPending)]
+			(const FOGGameplayTriggerHandle& TriggerHandle, EOGTriggerListenerPhases TriggerPhase, const FOGFrozenTriggerContextPtr& FrozenContext)
+		{
+			TOGPromise<TResult> Promise;
+			OnResultPending(TriggerHandle, Promise);
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [SharedWork, TriggerHandle, TriggerPhase, FrozenContext, Promise = MoveTemp(Promise)]() mutable
+			{
+				TResult Result = [&]()
+				{
+					//Keeps GC from running while Work reads the frozen context
+					FGCScopeGuard GCGuard;
+					return (*SharedWork)(TriggerHandle, TriggerPhase, FrozenContext->Get());
+				}();
+				AsyncTask(ENamedThreads::GameThread, [FrozenContext = MoveTemp(FrozenContext), Promise = MoveTemp(Promise), Result = MoveTemp(Result)]() mutable
+				{
+					Promise->Fulfill(MoveTemp(Result));
+				});
+			});
+		};
+		const TSharedRef<FOGTriggerListenerData> ListenerData = MakeShared<FOGTriggerListenerData>(TriggerType, Phases, FOGTriggerDelegate(), Options);
+		ListenerData->AnyThreadDispatch = MoveTemp(Dispatch);
+		return RegisterTriggerListener_Internal(ListenerData, Options, OutWhenListenerRemoved);
+	}
+	
+	void RemoveTriggerListener(const FOGTriggerListenerHandle& Handle);
+
+	/// Creates an empty listener group. Listeners join it through FOGTriggerListenerOptions::Group
+	FOGTriggerListenerGroupHandle CreateListenerGroup();
+	/// Removes every listener registered under the group, then the group itself.
+	/// Costs one compaction pass per trigger type the group has listeners for, regardless of how many listeners it holds.
+	void RemoveListenerGroup(const FOGTriggerListenerGroupHandle& Group);
+
+	/// Lightweight alternative to UOGWhenGameplayTriggerTask for C++ and OGAsync flows: waits for the next trigger of TriggerType
+	/// that matches Phases and the filters in Options. Backed by a pooled internal listener that removes itself after firing, no UObject is allocated.
+	/// The future is fulfilled synchronously during dispatch, so the context is only guaranteed to be valid inside the continuation.
+	/// @param OutHandle Optionally receives the handle of the internal listener, so the wait can be cancelled with RemoveTriggerListener
+	TOGFuture<const UOGGameplayTriggerContext*> WaitForTrigger(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases,
+		const FOGTriggerListenerOptions& Options = FOGTriggerListenerOptions(), FOGTriggerListenerHandle* OutHandle = nullptr);
+
+	/// True if anything would receive a trigger of TriggerType in any of Phases: a listener of that type, a tap of those phases,
+	/// or an aggregate view or composite trigger watching that type. Costs a bit test on the tap phases and at most one table lookup,
+	/// meant to skip building triggers nobody would receive (see FireLazy)
+	bool HasListeners(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases = EOGTriggerListenerPhases::All) const
+	{
+		return HasReceivers(TriggerType, Phases, false);
+	}
+
+	/// Fires an instantaneous trigger of TriggerType, but only creates its context and runs BuildContext if a listener, tap, aggregate view
+	/// or composite trigger could receive it, or if the type keeps a history.
+	/// @param BuildContext Called with the new context to fill in its initiator, target, tags and data bank
+	/// @return The handle of the trigger, or an invalid handle if nothing receives TriggerType
+	template<typename Func UE_REQUIRES(std::is_invocable_v<Func, UOGGameplayTriggerContext&>)>
+	FOGGameplayTriggerHandle FireLazy(const FGameplayTag& TriggerType, Func&& BuildContext)
+	{
+		//Instantaneous triggers are dispatched as start and end at once
+		if (!HasReceivers(TriggerType, EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd, true))
+			return FOGGameplayTriggerHandle();
+		UOGGameplayTriggerContext* Context = MakeGameplayTriggerContext(TriggerType, FGameplayTagContainer::EmptyContainer);
+		Invoke(Forward<Func>(BuildContext), *Context);
+		return InstantaneousTrigger(Context);
+	}
+
+	/// Stops the trigger that is currently being dispatched from reaching any lower priority listeners.
+	/// Only valid from inside a listener callback. The remaining listeners are skipped without evaluating their filters.
+	void ConsumeTrigger();
+
+	/// Opts a trigger type into same-frame coalescing. Instantaneous triggers of that type with the same instigator and target are merged
+	/// into a single dispatch per frame, which happens from Tick. Every merged trigger returns the handle of the dispatched one.
+	/// @param Merge Folds each incoming trigger into the first one of the frame. If unbound, the first trigger is dispatched unchanged
+	void RegisterTriggerCoalescing(const FGameplayTag& TriggerType, const FOGTriggerMergeDelegate& Merge);
+	/// Dispatches every trigger that is waiting for the end of the frame, then stops coalescing that type
+	void UnregisterTriggerCoalescing(const FGameplayTag& TriggerType);
+	/// Dispatches every coalesced trigger now instead of waiting for Tick
+	void FlushCoalescedTriggers();
+	int32 GetNumPendingCoalescedTriggers() const { return PendingCoalescedTriggers.Num(); }
+	
+	// Start a trigger that does not persist - Takes a TriggerContext that has been created with MakeGameplayTriggerContext
+	FOGGameplayTriggerHandle InstantaneousTrigger(UOGGameplayTriggerContext* TriggerContext);
+	// Start a trigger that does not persist - Creates the TriggerContext internally
+	FOGGameplayTriggerHandle InstantaneousTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
+
+	// Start a trigger that will remain active until you call EndTrigger - Takes a TriggerContext that has been created with MakeGameplayTriggerContext
+	FOGGameplayTriggerHandle StartTrigger(UOGGameplayTriggerContext* TriggerContext);
+	// Start a trigger that will remain active until you call EndTrigger - Creates the TriggerContext internally
+	FOGGameplayTriggerHandle StartTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, UObject* Initiator = nullptr, UObject* Target = nullptr);
+	// Start a trigger that can end itself after a duration and fire periodic updates while it is active
+	FOGGameplayTriggerHandle StartTrigger(UOGGameplayTriggerContext* TriggerContext, const FOGTriggerStartOptions& Options);
+	// Start a trigger that ends itself after Duration seconds and fires TriggerUpdate every UpdateInterval seconds, 0 disables either
+	FOGGameplayTriggerHandle StartTimedTrigger(UOGGameplayTriggerContext* TriggerContext, float Duration, float UpdateInterval = 0.f);
+	// Start a timed trigger - Creates the TriggerContext internally
+	FOGGameplayTriggerHandle StartTimedTriggerImplicitContext(const FGameplayTag& TriggerType, const FGameplayTagContainer& TriggerTags, float Duration, float UpdateInterval = 0.f,
+		UObject* Initiator = nullptr, UObject* Target = nullptr);
+
+	// Update a trigger trigger with 
+	void UpdateTrigger(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* UpdatedTriggerContext);
+	
+	// End a trigger that was started with StartTrigger
+	void EndTrigger(const FOGGameplayTriggerHandle& Handle);
+
+	//Checks if the handle references an active trigger, may not be true immediately after a StartTrigger call if the trigger was placed in the pending operations queue
+	bool IsTriggerActive(const FOGGameplayTriggerHandle& Handle);
+	//Checks if the handle references an active trigger, or a trigger that is pending activation (while not also pending removal)
+	bool IsTriggerActiveOrPending(const FOGGameplayTriggerHandle& Handle);
+	//Checks if the listener referenced by that handle is listening for new trigger events
+	bool IsListenerHandleValid(const FOGTriggerListenerHandle& Handle);
+	//Checks if the group has been created and not removed yet
+	bool IsListenerGroupValid(const FOGTriggerListenerGroupHandle& Group) const { return ListenerGroups.Contains(Group); }
+	//Number of deferrable listener callbacks waiting for a future tick
+	int32 GetNumPendingDeferredCallbacks() const { return DeferredCallbacks.Num(); }
+	//Number of active triggers with an auto-end duration or periodic updates
+	int32 GetNumTimedTriggers() const { return TriggerTimers.Num(); }
+	//Number of spatial listeners that follow an actor, moved by every tick
+	int32 GetNumTrackedListeners() const;
+	//Seconds the engine has been ticked for, the clock of timed triggers and trigger history
+	double GetEngineTime() const { return TimerWheel.GetTime(); }
+	//Number of times the engine has been ticked, the frame MaxPerFrame rate limits count against
+	uint64 GetEngineFrame() const { return EngineFrame; }
+	FOGTriggerClock GetClock() const { return {TimerWheel.GetTime(), EngineFrame}; }
+
+	/// Keeps the last Capacity instantaneous triggers of TriggerType, so listeners registered later can replay them (see FOGTriggerListenerOptions::ReplayHistorySince).
+	/// Each slot of the ring owns a context that is reused for the triggers recorded into it, so memory stays bounded per type.
+	/// Enabling it again with a different capacity keeps the newest triggers that fit
+	void EnableTriggerHistory(const FGameplayTag& TriggerType, int32 Capacity);
+	void DisableTriggerHistory(const FGameplayTag& TriggerType);
+	bool IsTriggerHistoryEnabled(const FGameplayTag& TriggerType) const { return HistoryByType.Contains(TriggerType); }
+	int32 GetNumTriggersInHistory(const FGameplayTag& TriggerType) const
+	{
+		const FOGTriggerHistory* History = HistoryByType.Find(TriggerType);
+		return History ? History->Entries.Num() : 0;
+	}
+	const FOGTriggerSweepStats& GetSweepStats() const { return SweepStats; }
+	const FOGTriggerMemoryStats& GetMemoryStats() const { return MemoryStats; }
+	/// Releases per-type tables that have been empty, and shrinks the ones that have been oversized, since the previous trim pass.
+	/// Runs from Tick every OG.GameplayTrigger.TrimIdleSeconds, only exposed to force a pass (e.g. after a level transition)
+	void TrimTables();
+
+	/// Serializes every active trigger (handle, context and data bank) into a compact, versioned binary blob.
+	/// Object references are stored as paths so the blob can be restored after level transitions, seamless travel or a load.
+	/// @param OutBytes Receives the snapshot
+	/// @return false if the snapshot could not be written, e.g. because trigger operations are still being processed
+	bool SaveActiveTriggers(TArray<uint8>& OutBytes) const;
+
+	/// Bulk-rebuilds the active trigger tables from a blob written by SaveActiveTriggers, without replaying any game logic.
+	/// Restored triggers get new handles, the handles of the session that was saved could collide with the ones generated in this one.
+	/// @param Bytes A snapshot written by SaveActiveTriggers
+	/// @param RestoreMode Whether TriggerStart should be fired for the restored triggers
+	/// @param OutRestoredHandles If set, receives the new handle of every restored trigger, keyed by the handle it was saved with
+	/// @return false if the snapshot is malformed or from a newer version, in which case nothing is restored
+	bool RestoreActiveTriggers(const TArray<uint8>& Bytes, EOGTriggerRestoreMode RestoreMode = EOGTriggerRestoreMode::Silent,
+		TMap<FOGGameplayTriggerHandle, FOGGameplayTriggerHandle>* OutRestoredHandles = nullptr);
+
+	/// Runs the per-frame work: tracked listeners, timers, coalesced triggers, deferred callbacks, the stale listener sweep, table trimming and OnTicked.
+	/// The subsystem calls this from its own tick, headless engines have to be ticked by whoever owns them
+	void Tick(float DeltaTime);
+	/// Drops every listener, trigger and pending operation
+	void Reset();
+
+	FOGGameplayTriggerHandle StartTrigger_Internal(UOGGameplayTriggerContext* TriggerContext, EOGTriggerOperationFlags Operations);
+	// Removes every listener owned by, or filtering on, Object
+	void RemoveListenersBoundToObject(const FObjectKey& Object);
+
+	/// Adds a tap that sees every dispatched trigger, whatever its type. Taps are kept apart from the per-type listener tables,
+	/// so they never make a type's listener scan longer, and run after the typed listeners of each trigger.
+	/// Taps observe triggers, they see the ones consumed by a typed listener and can't consume them themselves.
+	/// The tap is removed once its delegate is no longer bound (e.g. the object it was bound to is gone)
+	FOGTriggerTapHandle AddTriggerTap(const FOGTriggerDelegate& Delegate, const FOGTriggerTapOptions& Options = FOGTriggerTapOptions());
+	template<typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*>>)>
+	FOGTriggerTapHandle AddTriggerTap(const UObject* ContextObject, Func Lambda, const FOGTriggerTapOptions& Options = FOGTriggerTapOptions())
+	{
+		return AddTriggerTap(FOGTriggerDelegate::CreateWeakLambda(ContextObject, Lambda), Options);
+	}
+	void RemoveTriggerTap(const FOGTriggerTapHandle& Handle);
+	bool IsTriggerTapValid(const FOGTriggerTapHandle& Handle) const
+	{
+		return Taps.ContainsByPredicate([&Handle](const FOGTriggerTap& Tap) { return Tap.Handle == Handle && !Tap.bIsRemoved; });
+	}
+	int32 GetNumTriggerTaps() const { return Taps.Num(); }
+	// Listeners kept for reuse by WaitForTrigger
+	int32 GetNumPooledAwaiters() const { return AwaiterPool.Num(); }
+
+	/// Creates a view that keeps an aggregate (count, sum, min or max) of the active triggers of a type, optionally per instigator or target.
+	/// Views are updated as triggers start, update and end, so reading them never scans the active triggers.
+	/// Count and Sum updates are O(1), Min and Max updates O(log n) in the number of triggers the view holds for the key.
+	/// Triggers that are already active when the view is created are included
+	FOGTriggerAggregateViewHandle CreateAggregateView(const FOGTriggerAggregateViewOptions& Options);
+	void RemoveAggregateView(const FOGTriggerAggregateViewHandle& Handle);
+	bool IsAggregateViewValid(const FOGTriggerAggregateViewHandle& Handle) const { return AggregateViews.Contains(Handle); }
+	/// Current aggregate of the view, for the given instigator or target if the view is keyed by one.
+	/// @return DefaultValue if no active trigger contributes to the view (Min / Max), the count or sum otherwise
+	double ReadAggregateView(const FOGTriggerAggregateViewHandle& Handle, const UObject* Key = nullptr, double DefaultValue = 0.0) const;
+	/// Number of active triggers contributing to the view, for the given instigator or target if the view is keyed by one
+	int32 GetAggregateViewCount(const FOGTriggerAggregateViewHandle& Handle, const UObject* Key = nullptr) const;
+
+	/// Creates a composite trigger, which starts a trigger of its output type when every one of its terms holds and ends it when one stops holding.
+	/// Terms are counts of active triggers kept up to date as triggers start and end, so only the composites that have a term on the type of
+	/// a trigger are looked at, and listeners of the output type are only called when the condition flips.
+	/// Instantaneous triggers are never counted. Conditions that already hold when the composite is created start its output right away
+	FOGTriggerCompositeHandle CreateCompositeTrigger(const FOGTriggerCompositeOptions& Options);
+	/// Removes the composite and ends the triggers it started
+	void RemoveCompositeTrigger(const FOGTriggerCompositeHandle& Handle);
+	bool IsCompositeTriggerValid(const FOGTriggerCompositeHandle& Handle) const { return CompositeTriggers.Contains(Handle); }
+	/// True while the condition of the composite holds, for the given instigator or target if the composite is keyed by one
+	bool IsCompositeTriggerActive(const FOGTriggerCompositeHandle& Handle, const UObject* Key = nullptr) const;
+
+	// Called the first time a listener is bound to an actor, and for every bound actor on Reset, so the owner can track when the actor ends play.
+	// Without them, listeners bound to actors are only removed once the actor is garbage collected
+	TFunction<void(AActor*)> OnActorBound;
+	TFunction<void(AActor*)> OnActorUnbound;
+	// Broadcast at the end of every Tick, once the engine time has advanced, for work that has to happen on time even when no trigger comes in
+	FSimpleMulticastDelegate OnTicked;
+
+private:
+
+	bool HasReceivers(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, bool bIncludeHistory) const
+	{
+		if (!!(TapPhases & Phases))
+			return true;
+		const FOGTriggerListenerList* Listeners = ListenersByType.Find(TriggerType);
+		return Listeners && (!!(Listeners->Get().ListenedPhases & Phases) || Listeners->bIsObserved || (bIncludeHistory && Listeners->bKeepsHistory));
+	}
+	// Mirrors whether views, composites or a history watch TriggerType onto its listener list, called whenever one is added or removed
+	void UpdateObservedFlags(const FGameplayTag& TriggerType);
+	void UpdateTapPhases();
+
+	static bool IsDelegateAllowedToRunOn(const FOGTriggerDelegate& Delegate, EOGTriggerRunOn RunOn);
+	static TSharedRef<FOGTriggerListenerData> MakeListenerData(const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, const FOGTriggerDelegate& Delegate,
+		const FOGTriggerListenerOptions& Options);
+	FOGTriggerListenerHandle RegisterTriggerListener_Internal(const TSharedRef<FOGTriggerListenerData>& ListenerData, const FOGTriggerListenerOptions& Options,
+		TOGFuture<void>* OutWhenListenerRemoved);
+	TSharedRef<FOGTriggerListenerData> AcquireAwaiterListener();
+	void ReleaseListener(const TSharedRef<FOGTriggerListenerData>& Listener);
+
+	// Outer of the trigger contexts created by the engine
+	UObject* GetContextOuter() const;
+	UOGGameplayTriggerContext* DuplicateTriggerContext(const UOGGameplayTriggerContext* TriggerContext);
+
+	FOGTriggerListenerHandle CreateNewListenerHandle(const FGameplayTag& TriggerType);
+	FOGGameplayTriggerHandle CreateNewTriggerHandle(const FGameplayTag& TriggerType);
+
+	void EnqueueAndProcessOperation(const FOGPendingTriggerOperation& Operation);
+	void ProcessOperationQueue();
+	// Holds the operation queue open so operations raised by callbacks during the batch are queued behind it instead of processed inline
+	void BeginOperationBatch();
+	// Releases the batch and processes every operation that was queued while it was open
+	void EndOperationBatch();
+	void ProcessTriggerOperation(const FOGPendingTriggerOperation& TriggerOperation);
+	void ProcessTriggerCallbacks(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases TriggerPhase, UOGGameplayTriggerContext* TriggerContext);
+	// Runs, defers or schedules the callback of a listener that has passed its filters.
+	// FrozenContext is created on demand and shared between every AnyThread listener of the same dispatch
+	void ExecuteListenerCallback(const TSharedRef<FOGTriggerListenerData>& Listener, const FOGGameplayTriggerHandle& TriggerHandle, EOGTriggerListenerPhases TriggerPhase,
+		UOGGameplayTriggerContext* TriggerContext, FOGFrozenTriggerContextPtr& FrozenContext);
+	// Calls the taps after the typed listeners of a dispatch
+	void ProcessTriggerTaps(const FOGGameplayTriggerHandle& TriggerHandle, EOGTriggerListenerPhases TriggerPhase, UOGGameplayTriggerContext* TriggerContext);
+	void ProcessDeferredCallbacks();
+	// Returns the handle the trigger was merged into, or an invalid handle if its type isn't coalesced
+	FOGGameplayTriggerHandle CoalesceInstantaneousTrigger(UOGGameplayTriggerContext* TriggerContext);
+	// Advances the timer wheel and ends / updates every timed trigger that is due, in a single operation batch
+	void ProcessTriggerTimers(float DeltaTime);
+	// Copies an instantaneous trigger that was just dispatched into the history ring of its type, if it has one
+	void RecordTriggerHistory(const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext* Trigger);
+	void ReplayTriggerHistory(const TSharedRef<FOGTriggerListenerData>& Listener, double Since);
+	// Moves the listeners that follow an actor to the actor's current location
+	void UpdateTrackedListeners();
+	void RemoveFromSpatialGrid(FOGTriggerListenerData& Listener);
+	// Visits up to OG.GameplayTrigger.SweepListenersPerFrame listeners, continuing where the previous frame stopped, and removes the stale ones
+	void SweepStaleListeners();
+	SIZE_T GetTablesAllocatedSize() const;
+	
+	//TODO: real system for replicated event types
+	static bool IsTriggerTypeReplicated(const FGameplayTag& TriggerType) { return false; }
+	
+	// Adds or removes the contribution of an active trigger to the aggregate views of its type
+	void AddToAggregateViews(const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext* Trigger);
+	void RemoveFromAggregateViews(const FOGGameplayTriggerHandle& Handle);
+
+	// Counts a trigger of a type that composites have a term on in (+1) or out (-1) of them, queuing the derived triggers of the conditions that flip
+	void UpdateCompositeTriggers(const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext& Trigger, int32 Delta);
+
+	void AddActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* Trigger);
+	void UpdateActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle, UOGGameplayTriggerContext* Trigger);
+	void RemoveActiveTrigger_Internal(const FOGGameplayTriggerHandle& Handle);
+
+	void AddTriggerListener_Internal(const FOGTriggerListenerHandle& Handle, const TSharedRef<FOGTriggerListenerData>& Listener);
+	void RemoveTriggerListener_Internal(const FOGTriggerListenerHandle& Handle);
+	// Removes a listener of several types from the tables of its types that still hold it
+	void RemoveFromRemainingTypes(const TSharedRef<FOGTriggerListenerData>& Listener);
+	void ReleaseRetiredListeners();
+	// Removes the listeners of the given trigger types that match the predicate, in a single stable pass per type
+	void RemoveTriggerListeners_Internal(TConstArrayView<FGameplayTag> TriggerTypes, TFunctionRef<bool(const FOGTriggerListenerData&)> Predicate);
+
+	// Records that a listener of TriggerType has to be removed when Object goes away
+	void BindListenerToObject(const FObjectKey& Object, const FGameplayTag& TriggerType);
+	void HandlePostGarbageCollect();
+
+	void EnqueueOperation(const FOGPendingTriggerOperation& Operation);
+	bool PeekOperation(FOGPendingTriggerOperation*& OutOperation) const;
+	void PopOperation();
+	
+	TMap<FGameplayTag, FOGTriggerListenerList> ListenersByType;
+	TMap<FGameplayTag, FOGTriggerSpatialGrid> SpatialGridsByType;
+
+	typedef TArray<FGameplayTag, TInlineAllocator<4>> TriggerTypeArray;
+	//Trigger types each group has registered listeners for, the listeners themselves only live in ListenersByType
+	TMap<FOGTriggerListenerGroupHandle, TriggerTypeArray> ListenerGroups;
+	//Trigger types that have listeners owned by, or filtering on, each object
+	TMap<FObjectKey, TriggerTypeArray> ListenerTypesByBoundObject;
+	FDelegateHandle PostGarbageCollectHandle;
+	UOGGameplayTriggerSubsystem* Subsystem = nullptr;
+
+	//Used for event replication, the contexts are kept alive by ActiveTriggersByType
+	//TODO: make this a fast array
+	TArray<UOGGameplayTriggerContext*> ReplicatedTriggers;
+
+	TMap<FGameplayTag, TriggerMap> ActiveTriggersByType;
+	
+	TDoubleLinkedList<FOGPendingTriggerOperation> OperationQueue;
+
+	//Recycled WaitForTrigger listeners
+	TArray<TSharedRef<FOGTriggerListenerData>> AwaiterPool;
+	//Awaiters removed while something still had them pinned, pooled once it has let go (after a dispatch, a WaitForTrigger call, or on Tick)
+	TArray<TSharedRef<FOGTriggerListenerData>> RetiredListeners;
+
+	//FIFO of deferrable callbacks, drained from the front in Tick
+	TArray<FOGDeferredTriggerCallback> DeferredCallbacks;
+
+	struct FOGTriggerCoalescingKey
+	{
+		FGameplayTag TriggerType;
+		FObjectKey Initiator;
+		FObjectKey Target;
+
+		bool operator==(const FOGTriggerCoalescingKey& Other) const
+		{
+			return TriggerType == Other.TriggerType && Initiator == Other.Initiator && Target == Other.Target;
+		}
+		friend uint32 GetTypeHash(const FOGTriggerCoalescingKey& Key)
+		{
+			return HashCombineFast(GetTypeHash(Key.TriggerType), HashCombineFast(GetTypeHash(Key.Initiator), GetTypeHash(Key.Target)));
+		}
+	};
+	struct FOGCoalescedTrigger
+	{
+		FOGGameplayTriggerHandle Handle;
+		TStrongObjectPtr<UOGGameplayTriggerContext> Context;
+	};
+	TMap<FGameplayTag, FOGTriggerMergeDelegate> CoalescingMergeByType;
+	//Merged triggers waiting for the end of the frame, dispatched in the order their key was first seen
+	TArray<FOGCoalescedTrigger> PendingCoalescedTriggers;
+	TMap<FOGTriggerCoalescingKey, int32> PendingCoalescedIndices;
+
+	struct FOGTriggerTimerState
+	{
+		//Timers on the wheel with another serial are stale
+		uint32 Serial = 0;
+		float UpdateInterval = 0.f;
+		//Wheel time the next periodic update is due, late updates don't shift the ones after them
+		double NextUpdateTime = 0.0;
+		//Wheel time at which the trigger ends, or a negative value if it doesn't end by itself
+		double EndTime = -1.0;
+	};
+	//Timed triggers, removed when the trigger ends so the timers left on the wheel are cancelled lazily
+	TMap<FOGGameplayTriggerHandle, FOGTriggerTimerState> TriggerTimers;
+	// Puts the auto-end and first periodic update of an active or pending trigger on the wheel, times are wheel times and EndTime is negative for no auto-end
+	void ScheduleTriggerTimers(const FOGGameplayTriggerHandle& Handle, double EndTime, float UpdateInterval, double NextUpdateTime);
+	FOGTriggerTimerWheel TimerWheel;
+	uint32 NextTimerSerial = 0;
+	uint64 EngineFrame = 0;
+
+	/**
+	 * Fixed capacity ring of the last instantaneous triggers of a type.
+	 * Entries grows up to Capacity, after that the oldest entry is overwritten and its context reused.
+	 */
+	struct FOGTriggerHistory
+	{
+		struct FEntry
+		{
+			FOGGameplayTriggerHandle Handle;
+			double Time = 0.0;
+			TStrongObjectPtr<UOGGameplayTriggerContext> Context;
+		};
+		TArray<FEntry> Entries;
+		int32 Capacity = 0;
+		// Oldest entry once the ring is full, the next one to be overwritten
+		int32 Oldest = 0;
+
+		// Visits the entries oldest first
+		template<typename Func>
+		void ForEach(Func Visitor) const
+		{
+			for (int32 i = 0; i < Entries.Num(); ++i)
+			{
+				Visitor(Entries[(Oldest + i) % Entries.Num()]);
+			}
+		}
+	};
+	TMap<FGameplayTag, FOGTriggerHistory> HistoryByType;
+	//Set while history is replayed, recorded triggers get a fresh context instead of overwriting one a replay may still hand out
+	bool bIsReplayingHistory = false;
+
+	struct FOGTriggerAggregateView
+	{
+		struct FBucket
+		{
+			int32 Count = 0;
+			double Sum = 0.0;
+			// Only kept by Min and Max views: a min-heap of the values (negated for Max), whose top is always a value still in the view.
+			// Values taken out from below the top are only counted in RemovedValues and dropped once they surface,
+			// so adding and removing a value is O(log n) and reading the top O(1)
+			TArray<double> Heap;
+			TMap<double, int32> RemovedValues;
+			int32 NumRemovedValues = 0;
+
+			void PushValue(double HeapValue);
+			void RemoveValue(double HeapValue);
+		};
+		// What an active trigger added to the view, so it can be taken out again even after its context was updated in place
+		struct FContribution
+		{
+			FObjectKey Key;
+			double Value = 0.0;
+		};
+
+		FGameplayTag TriggerType;
+		EOGTriggerAggregateOp Op = EOGTriggerAggregateOp::Count;
+		EOGTriggerAggregateKey KeyBy = EOGTriggerAggregateKey::None;
+		TFunction<TOptional<double>(const UOGGameplayTriggerContext&)> Value;
+		TMap<FObjectKey, FBucket> Buckets;
+		TMap<FOGGameplayTriggerHandle, FContribution> Contributions;
+
+		void Add(const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext& Trigger);
+		void Remove(const FOGGameplayTriggerHandle& Handle);
+		// Max views keep their values negated so both ops share a min-heap, zero is normalized so it is a single RemovedValues key
+		double ToHeapValue(double InValue) const { return InValue == 0.0 ? 0.0 : Op == EOGTriggerAggregateOp::Max ? -InValue : InValue; }
+	};
+	TMap<FOGTriggerAggregateViewHandle, FOGTriggerAggregateView> AggregateViews;
+	TMap<FGameplayTag, TArray<FOGTriggerAggregateViewHandle, TInlineAllocator<2>>> AggregateViewsByType;
+
+	struct FOGTriggerComposite
+	{
+		// Term counts of the whole composite, or of a single instigator or target
+		struct FState
+		{
+			TArray<int32, TInlineAllocator<4>> Counts;
+			int32 NumSatisfiedTerms = 0;
+			// Keyed states are removed once no counted trigger has their key
+			int32 NumTriggers = 0;
+			TWeakObjectPtr<UObject> KeyObject;
+			FOGGameplayTriggerHandle Output;
+			bool bIsOutputActive = false;
+		};
+
+		FGameplayTag OutputType;
+		FGameplayTagContainer OutputTags;
+		EOGTriggerAggregateKey KeyBy = EOGTriggerAggregateKey::None;
+		TArray<FOGTriggerCompositeTerm> Terms;
+		TMap<FObjectKey, FState> States;
+		// Key each counted trigger was counted under, so it is taken out of the same state even if its context was updated in place
+		TMap<FOGGameplayTriggerHandle, FObjectKey> TriggerKeys;
+
+		FState MakeState(UObject* KeyObject) const;
+		bool IsTermSatisfied(const FState& State, int32 TermIndex) const
+		{
+			return (State.Counts[TermIndex] >= Terms[TermIndex].MinCount) != Terms[TermIndex].bNegated;
+		}
+	};
+	void UpdateCompositeTrigger(FOGTriggerComposite& Composite, const FOGGameplayTriggerHandle& Handle, const UOGGameplayTriggerContext& Trigger, int32 Delta);
+	// Starts or ends the derived trigger of a state whose condition no longer matches it
+	void EvaluateCompositeState(const FOGTriggerComposite& Composite, FOGTriggerComposite::FState& State);
+	TMap<FOGTriggerCompositeHandle, FOGTriggerComposite> CompositeTriggers;
+	TMap<FGameplayTag, TArray<FOGTriggerCompositeHandle, TInlineAllocator<2>>> CompositeTriggersByType;
+
+	struct FOGTriggerTap
+	{
+		FOGTriggerTapHandle Handle;
+		FOGTriggerDelegate Callback;
+		EOGTriggerListenerPhases Phases = EOGTriggerListenerPhases::All;
+		float SampleRate = 1.f;
+		// Fraction of a call owed to the tap, it is called whenever this reaches 1
+		float SampleCredit = 0.f;
+		// Taps removed while taps are running are only flagged, and compacted once the outermost tap dispatch is done
+		bool bIsRemoved = false;
+	};
+	TArray<FOGTriggerTap> Taps;
+	// Union of the phases of the taps that aren't removed
+	EOGTriggerListenerPhases TapPhases = EOGTriggerListenerPhases::None;
+	bool bIsDispatchingTaps = false;
+	bool bHasRemovedTaps = false;
+
+	//Trigger types of the current sweep pass, refreshed when the pass completes
+	TArray<FGameplayTag> SweepTriggerTypes;
+	int32 SweepTypeIndex = 0;
+	int32 SweepListenerIndex = 0;
+	FOGTriggerSweepStats SweepStats;
+	FOGTriggerSweepStats SweepStatsAtPassStart;
+
+	//Tables that were already empty or oversized at the previous trim pass, anything still in that state at the next pass gets trimmed
+	TSet<FGameplayTag> IdleListenerTypes;
+	TSet<FGameplayTag> IdleTriggerTypes;
+	float TimeSinceTrim = 0.f;
+	FOGTriggerMemoryStats MemoryStats;
+
+	bool bIsDispatchingCallbacks = false;
+	bool bIsTriggerConsumed = false;
+};
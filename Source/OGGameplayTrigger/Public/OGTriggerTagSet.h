@@ -0,0 +1,97 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "OGTriggerTagSet.generated.h"
+
+/**
+ * Fixed width fold of a tag bitset, tag N maps to bit N % 128.
+ * A bit that is clear in the mask is clear in the full bitset, so masks can prove a tag is missing but not that it is present.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerTagMask
+{
+	static constexpr int32 NumWords = 4;
+
+	alignas(16) uint32 Words[NumWords] = {0, 0, 0, 0};
+};
+
+/**
+ * Immutable, interned combination of gameplay tags.
+ * Trigger contexts only reference these, so contexts that share a combination of tags share a single copy.
+ * Every set also carries precomputed bitsets over a process-wide tag index, so set to set queries are word-wise bit operations.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerTagSet
+{
+	typedef TArray<uint32, TInlineAllocator<4>> FWords;
+
+	// Explicit tags, with the parent tags cached like any other container
+	FGameplayTagContainer Tags;
+	// Bits of the explicit tags
+	FWords ExplicitBits;
+	// Bits of the explicit tags and all of their parents
+	FWords AllBits;
+	FOGTriggerTagMask ExplicitMask;
+	FOGTriggerTagMask AllMask;
+	// Index in the interning table, 0 is always the empty set
+	uint32 Id = 0;
+
+	// Same semantics as FGameplayTagContainer, parents of the tags in this set match
+	bool HasTag(const FGameplayTag& Tag) const;
+	bool HasTagExact(const FGameplayTag& Tag) const;
+	// True if every tag in Other is in this set, parents of the tags in this set match
+	bool HasAll(const FOGTriggerTagSet& Other) const;
+	// True if any tag in Other is in this set, parents of the tags in this set match
+	bool HasAny(const FOGTriggerTagSet& Other) const;
+	bool IsEmpty() const { return Tags.IsEmpty(); }
+	// True if the masks hold the same bits as the full bitsets
+	bool IsMaskExact() const { return AllBits.Num() <= FOGTriggerTagMask::NumWords; }
+
+	/// Returns the interned set for the given tags. Thread safe, returned references stay valid for the lifetime of the process.
+	/// Sets are never freed, so the table grows with every distinct combination ever interned. That is fine for tags picked from
+	/// a fixed design-time vocabulary, but tags built from runtime data (one tag per spawned actor, per item id...) would grow it
+	/// without bound and should go in the data bank instead.
+	static const FOGTriggerTagSet& Intern(const FGameplayTagContainer& Tags);
+	static const FOGTriggerTagSet& Empty();
+
+	// Bit index of a tag in the process-wide tag index, or INDEX_NONE if no interned set has used the tag yet
+	static int32 FindTagIndex(const FGameplayTag& Tag);
+};
+
+/**
+ * Reference to an interned FOGTriggerTagSet.
+ * Serialized and replicated as a regular tag container, and interned again on load.
+ */
+USTRUCT()
+struct OGGAMEPLAYTRIGGER_API FOGTriggerTagSetId
+{
+	GENERATED_BODY()
+
+	FOGTriggerTagSetId() : Set(&FOGTriggerTagSet::Empty()) {}
+	explicit FOGTriggerTagSetId(const FGameplayTagContainer& Tags) : Set(&FOGTriggerTagSet::Intern(Tags)) {}
+
+	const FOGTriggerTagSet& Get() const { return *Set; }
+	const FOGTriggerTagSet* operator->() const { return Set; }
+
+	bool operator==(const FOGTriggerTagSetId& Other) const { return Set == Other.Set; }
+	bool operator!=(const FOGTriggerTagSetId& Other) const { return Set != Other.Set; }
+	friend uint32 GetTypeHash(const FOGTriggerTagSetId& Id) { return Id.Set->Id; }
+
+	bool Serialize(FArchive& Ar);
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+private:
+	const FOGTriggerTagSet* Set;
+};
+
+template<>
+struct TStructOpsTypeTraits<FOGTriggerTagSetId> : public TStructOpsTypeTraitsBase2<FOGTriggerTagSetId>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -0,0 +1,106 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGTriggerEngine.h"
+#include "Tasks/Pipe.h"
+
+/**
+ * Settings of an FOGTriggerTelemetrySink.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerTelemetryOptions
+{
+	// Directory the telemetry files are written to, defaults to Saved/Telemetry/GameplayTriggers
+	FString Directory;
+	// Files are named <FilePrefix>_<Index>.ogtt, the index keeps growing across sessions
+	FString FilePrefix = TEXT("Triggers");
+	// Length of a counting window, in seconds of engine time (see FOGTriggerEngine::GetEngineTime)
+	double WindowSeconds = 10.0;
+	// Windows go to a new file once the current one has reached this size
+	int64 MaxFileBytes = 1024 * 1024;
+	// Older files are deleted so that at most this many are kept
+	int32 MaxFiles = 8;
+};
+
+/**
+ * Number of triggers of a single (type, tag set, instigator class) combination in a window, as read back from a telemetry file.
+ */
+struct OGGAMEPLAYTRIGGER_API FOGTriggerTelemetryRow
+{
+	FString TriggerType;
+	FString TriggerTags;
+	// Empty for triggers without an instigator
+	FString InstigatorClass;
+	uint32 Count = 0;
+};
+
+struct OGGAMEPLAYTRIGGER_API FOGTriggerTelemetryWindow
+{
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+	TArray<FOGTriggerTelemetryRow> Rows;
+};
+
+/**
+ * Counts the triggers started on an engine per (type, tag set, instigator class) over fixed windows, and writes every finished window
+ * to rotating local files from a background pipe. Windows are closed from the engine tick, so the last one before a quiet period isn't held back.
+ * Counting is a map increment in an engine tap. Taps only run during dispatch on the game thread, which is also the only thread that touches
+ * the counters, so they are plain counters rather than lock-free ones: there is no other thread to share them with.
+ * A finished window is moved to the pipe as a whole, so the game thread never waits on a lock or on file I/O.
+ * Windows are stored as self-contained blocks: a string table followed by one packed column per field, see ReadTelemetryFile.
+ * The engine has to outlive the sink.
+ */
+class OGGAMEPLAYTRIGGER_API FOGTriggerTelemetrySink : public FNoncopyable
+{
+public:
+	explicit FOGTriggerTelemetrySink(FOGTriggerEngine& InEngine, const FOGTriggerTelemetryOptions& InOptions = FOGTriggerTelemetryOptions());
+	// Writes the current window and waits for every write to finish
+	~FOGTriggerTelemetrySink();
+
+	/// Ends the current window early and hands it to the writer. Windows without any trigger are never written
+	void Flush();
+	/// Blocks until every window handed to the writer is on disk
+	void WaitForWrites() const;
+
+	int32 GetNumCountersInWindow() const { return Counters.Num(); }
+	int64 GetNumWindowsWritten() const;
+	const FString& GetDirectory() const;
+
+	/// Reads every window stored in a telemetry file, oldest first
+	/// @return false if the file can't be read or holds a block that isn't a telemetry window, OutWindows keeps the windows read until then
+	static bool ReadTelemetryFile(const FString& Path, TArray<FOGTriggerTelemetryWindow>& OutWindows);
+
+private:
+	struct FCounterKey
+	{
+		FGameplayTag TriggerType;
+		FOGTriggerTagSetId TriggerTags;
+		FName InstigatorClass;
+
+		bool operator==(const FCounterKey& Other) const
+		{
+			return TriggerType == Other.TriggerType && TriggerTags == Other.TriggerTags && InstigatorClass == Other.InstigatorClass;
+		}
+		friend uint32 GetTypeHash(const FCounterKey& Key)
+		{
+			return HashCombineFast(GetTypeHash(Key.TriggerType), HashCombineFast(GetTypeHash(Key.TriggerTags), GetTypeHash(Key.InstigatorClass)));
+		}
+	};
+	// Owns the files, only used from the write pipe once the sink is constructed
+	class FWriter;
+
+	void HandleTrigger(const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* Trigger);
+	// Submits the current window if it is over at the current engine time
+	void CloseElapsedWindow();
+	void SubmitWindow(double EndTime);
+
+	FOGTriggerEngine& Engine;
+	FOGTriggerTapHandle Tap;
+	FDelegateHandle TickHandle;
+	double WindowSeconds;
+	double WindowStart;
+	TMap<FCounterKey, uint32> Counters;
+	TSharedRef<FWriter, ESPMode::ThreadSafe> Writer;
+	mutable UE::Tasks::FPipe WritePipe;
+};
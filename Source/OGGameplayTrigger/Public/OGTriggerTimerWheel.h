@@ -0,0 +1,60 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGGameplayTriggerTypes.h"
+
+/**
+ * A timer scheduled on the trigger timer wheel.
+ * Timers are never removed from the wheel, the subsystem ignores the ones whose serial no longer matches the trigger's timer state.
+ */
+struct FOGTriggerTimer
+{
+	FOGGameplayTriggerHandle Handle;
+	uint32 Serial = 0;
+	// Periodic update instead of the auto-end
+	bool bIsUpdate = false;
+};
+
+/**
+ * Hierarchical timer wheel with 4 levels of 256 slots.
+ * Level N slots span 256^N ticks, timers start in the level matching how far away they are and cascade down as time advances,
+ * so scheduling and expiring are O(1) per timer no matter how many timers are pending.
+ */
+class OGGAMEPLAYTRIGGER_API FOGTriggerTimerWheel
+{
+public:
+	static constexpr int32 NumLevels = 4;
+	static constexpr int32 SlotBits = 8;
+	static constexpr int32 NumSlots = 1 << SlotBits;
+
+	explicit FOGTriggerTimerWheel(double InTickSeconds = 0.01);
+
+	/// Schedules a timer to expire once the wheel has advanced past Time. Times in the past expire on the next advance.
+	void Schedule(const FOGTriggerTimer& Timer, double Time);
+	/// Moves the wheel to Time and appends every timer that expired on the way, in expiry order
+	void Advance(double Time, TArray<FOGTriggerTimer>& OutExpired);
+	void Reset();
+
+	double GetTime() const { return Time; }
+	int32 Num() const { return NumTimers; }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FEntry
+	{
+		FOGTriggerTimer Timer;
+		uint64 ExpiryTick;
+	};
+	typedef TArray<FEntry> FSlot;
+
+	void ScheduleAtTick(const FEntry& Entry);
+	void Cascade(int32 Level);
+
+	FSlot Slots[NumLevels][NumSlots];
+	double TickSeconds;
+	double Time = 0.0;
+	uint64 CurrentTick = 0;
+	int32 NumTimers = 0;
+};
@@ -0,0 +1,82 @@
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OGGameplayTriggerTypes.h"
+#include "OGTriggerEngine.h"
+
+/**
+ * Binds a trigger type to a payload struct at compile time.
+ * TPayload is an FOGTriggerDataType that declares its trigger type with a static GetTriggerType() function.
+ * Fire stores the payload in the context's data bank like any other data, so untyped listeners, snapshots and replication still see it,
+ * while Listen callbacks receive the payload as a typed reference instead of searching the bank themselves.
+ * The payload has a single copy, in the data bank, so each typed callback still finds it there (one FindConst per callback).
+ * Keeping a second copy or a pointer next to the bank would let the two diverge, and the bank may move its entries as data is added.
+ * Works with both UOGGameplayTriggerSubsystem and FOGTriggerEngine.
+ *
+ *	USTRUCT()
+ *	struct FDamagePayload : public FOGTriggerDataType
+ *	{
+ *		GENERATED_BODY()
+ *		static FGameplayTag GetTriggerType() { return TAG_Trigger_Damage; }
+ *		UPROPERTY()
+ *		float Amount = 0.f;
+ *	};
+ *	TOGTypedTrigger<FDamagePayload>::Listen(*Subsystem, this, EOGTriggerListenerPhases::TriggerStart,
+ *		[](const FDamagePayload& Damage, const UOGGameplayTriggerContext* Trigger) { ... });
+ *	TOGTypedTrigger<FDamagePayload>::Fire(*Subsystem, FDamagePayload{...}, Instigator, Target);
+ */
+template<typename TPayload>
+class TOGTypedTrigger
+{
+	static_assert(TIsDerivedFrom<TPayload, FOGTriggerDataType>::Value, "Typed trigger payloads have to derive from FOGTriggerDataType");
+
+public:
+	static FGameplayTag GetTriggerType() { return TPayload::GetTriggerType(); }
+
+	/// Creates a context carrying Payload, without dispatching it. For triggers that need more data, tags or a location before being fired
+	template<typename TTriggers>
+	static UOGGameplayTriggerContext* MakeContext(TTriggers& Triggers, const TPayload& Payload, UObject* Initiator = nullptr, UObject* Target = nullptr,
+		const FGameplayTagContainer& TriggerTags = FGameplayTagContainer::EmptyContainer)
+	{
+		UOGGameplayTriggerContext* Context = Triggers.MakeGameplayTriggerContext(GetTriggerType(), TriggerTags, Initiator, Target);
+		Context->SetTypedPayload(Payload);
+		return Context;
+	}
+
+	/// Fires an instantaneous trigger carrying Payload
+	template<typename TTriggers>
+	static FOGGameplayTriggerHandle Fire(TTriggers& Triggers, const TPayload& Payload, UObject* Initiator = nullptr, UObject* Target = nullptr,
+		const FGameplayTagContainer& TriggerTags = FGameplayTagContainer::EmptyContainer)
+	{
+		return Triggers.InstantaneousTrigger(MakeContext(Triggers, Payload, Initiator, Target, TriggerTags));
+	}
+
+	/// Starts a persistent trigger carrying Payload, ended with EndTrigger like any other trigger
+	template<typename TTriggers>
+	static FOGGameplayTriggerHandle Start(TTriggers& Triggers, const TPayload& Payload, UObject* Initiator = nullptr, UObject* Target = nullptr,
+		const FGameplayTagContainer& TriggerTags = FGameplayTagContainer::EmptyContainer)
+	{
+		return Triggers.StartTrigger(MakeContext(Triggers, Payload, Initiator, Target, TriggerTags));
+	}
+
+	/// Registers a listener whose callback receives the payload. Triggers of the type that don't carry the payload are skipped.
+	/// The callback is bound weakly to ContextObject, like the lambda overloads of RegisterTriggerListener
+	template<typename TTriggers, typename Func UE_REQUIRES(std::is_void_v<TInvokeResult_T<Func, const TPayload&, const UOGGameplayTriggerContext*>>)>
+	static FOGTriggerListenerHandle Listen(TTriggers& Triggers, const UObject* ContextObject, EOGTriggerListenerPhases Phases, Func Callback,
+		const FOGTriggerListenerOptions& Options = FOGTriggerListenerOptions())
+	{
+		return Triggers.RegisterTriggerListener(GetTriggerType(), Phases, FOGTriggerDelegate::CreateWeakLambda(ContextObject,
+			[Callback = MoveTemp(Callback)](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* Trigger)
+			{
+				if (const TPayload* Payload = Trigger->GetTypedPayload<TPayload>())
+				{
+					Callback(*Payload, Trigger);
+				}
+			}), Options);
+	}
+
+	/// The payload of a trigger of this type, or null if it doesn't carry one. Found in the data bank on every call
+	static const TPayload* GetPayload(const UOGGameplayTriggerContext* Trigger) { return Trigger->GetTypedPayload<TPayload>(); }
+};
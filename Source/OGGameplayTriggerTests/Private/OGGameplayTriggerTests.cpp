@@ -1,833 +1,3006 @@
-﻿#include "OGGameplayTriggerTests.h"
-
-#include "CoreMinimal.h"
-#include "Misc/AutomationTest.h"
-#include "OGGameplayTriggerSubsystem.h"
-#include "OGGameplayTriggerTypes.h"
-#include "Tests/AutomationCommon.h"
-
-IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemBasicTest, "OccamsGamekit.OGGameplayTrigger.BasicFunctionality",
-                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
-
-bool FOGTriggerSubsystemBasicTest::RunTest(const FString& Parameters)
-{
-    // This will get cleaned up when it leaves scope
-    FTestWorldWrapper WorldWrapper;
-    WorldWrapper.CreateTestWorld(EWorldType::Game);
-    UWorld* World = WorldWrapper.GetTestWorld();
-    if (!World)
-        return false;
-
-    // Get the trigger subsystem
-    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
-    if (!TriggerSubsystem)
-    {
-        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
-        return false;
-    }
-
-    // Test 1: Basic registration and triggering
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        bool bCallbackReceived = false;
-        AActor* ReceivedInitiator = nullptr;
-        AActor* ReceivedTarget = nullptr;
-        FGameplayTagContainer ReceivedTriggerTags;
-
-        // Create a test delegate
-        FOGTriggerDelegate TriggerDelegate;
-        TriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            bCallbackReceived = true;
-            ReceivedInitiator = Cast<AActor>(ActiveTrigger->InitiatorObject);
-            ReceivedTarget = Cast<AActor>(ActiveTrigger->TargetObject);
-            ReceivedTriggerTags = ActiveTrigger->TriggerTags;
-        });
-
-        // Register the listener
-        FOGTriggerListenerHandle ListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate);
-        TestTrue(TEXT("Listener handle should be valid"), ListenerHandle.IsValid());
-
-        // Create test objects for initiator and target
-        AActor* TestInitiator = World->SpawnActor<AActor>();
-        AActor* TestTarget = World->SpawnActor<AActor>();
-
-        // Create test trigger tags
-        FGameplayTagContainer TestTriggerTags;
-        TestTriggerTags.AddTag(FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1")));
-        TestTriggerTags.AddTag(FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2")));
-
-        // Fire the trigger
-        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, TestTriggerTags, TestInitiator, TestTarget);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-
-        // Verify the callback was received with correct parameters
-        TestTrue(TEXT("Callback should have been received"), bCallbackReceived);
-        TestEqual(TEXT("Initiator should match"), ReceivedInitiator, TestInitiator);
-        TestEqual(TEXT("Target should match"), ReceivedTarget, TestTarget);
-        TestEqual(TEXT("Trigger tags should match"), ReceivedTriggerTags, TestTriggerTags);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(ListenerHandle);
-    }
-
-    // Test 2: Multiple listeners for the same trigger type
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        int32 CallbackCount1 = 0;
-        int32 CallbackCount2 = 0;
-
-        // Create test delegates
-        FOGTriggerDelegate TriggerDelegate1;
-        TriggerDelegate1.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            CallbackCount1++;
-        });
-
-        FOGTriggerDelegate TriggerDelegate2;
-        TriggerDelegate2.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            CallbackCount2++;
-        });
-
-        // Register the listeners
-        FOGTriggerListenerHandle ListenerHandle1 = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate1);
-        FOGTriggerListenerHandle ListenerHandle2 = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate2);
-
-        // Fire the trigger
-        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-
-        // Verify both callbacks were received
-        TestEqual(TEXT("First callback should have been received once"), CallbackCount1, 1);
-        TestEqual(TEXT("Second callback should have been received once"), CallbackCount2, 1);
-
-        // Remove one listener and fire again
-        TriggerSubsystem->RemoveTriggerListener(ListenerHandle1);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-
-        // Verify only the second callback was received
-        TestEqual(TEXT("First callback should still have been received once"), CallbackCount1, 1);
-        TestEqual(TEXT("Second callback should have been received twice"), CallbackCount2, 2);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(ListenerHandle2);
-    }
-
-    // Test 3: Test bShouldFireForExistingTriggers parameter
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        int32 CallbackCount = 0;
-
-        // Fire a trigger before registering any listeners
-        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
-        FOGGameplayTriggerHandle ActiveTriggerHandle = TriggerSubsystem->StartTrigger(TriggerContext);
-
-        // Create a test delegate
-        FOGTriggerDelegate TriggerDelegate;
-        TriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            CallbackCount++;
-        });
-
-        // Register with bShouldFireForExistingTriggers = false (default)
-        FOGTriggerListenerHandle ListenerHandle1 = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate);
-        
-        // Verify no callback was received for the pre-existing trigger
-        TestEqual(TEXT("No callback should have been received"), CallbackCount, 0);
-        
-        FOGTriggerListenerHandle ListenerHandle2 = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate, nullptr, nullptr, true);
-        
-        // Verify a callback was received for the pre-existing trigger
-        TestEqual(TEXT("One callback should have been received"), CallbackCount, 1);
-        
-        // Clean up
-        TriggerSubsystem->EndTrigger(ActiveTriggerHandle);
-        TriggerSubsystem->RemoveTriggerListener(ListenerHandle1);
-        TriggerSubsystem->RemoveTriggerListener(ListenerHandle2);
-    }
-
-    // Test 4: Removing a listener
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        int32 CallbackCount = 0;
-
-        // Create a test delegate
-        FOGTriggerDelegate TriggerDelegate;
-        TriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            CallbackCount++;
-        });
-
-        // Register the listener
-        FOGTriggerListenerHandle ListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate);
-
-        // Fire the trigger
-        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-        TestEqual(TEXT("Callback should have been received once"), CallbackCount, 1);
-
-        // Remove the listener
-        TriggerSubsystem->RemoveTriggerListener(ListenerHandle);
-
-        // Fire the trigger again
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-        TestEqual(TEXT("Callback count should still be 1"), CallbackCount, 1);
-    }
-
-    // Test 5: Verify TriggerPhase is set correctly for InstantaneousTrigger
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        EOGTriggerListenerPhases ReceivedPhase = EOGTriggerListenerPhases::None;
-
-        // Register the listener
-        FOGTriggerListenerHandle ListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, FOGTriggerDelegate::CreateLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            ReceivedPhase = TriggerPhase;
-        }));
-
-        // Fire the trigger
-        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-        
-        // For instantaneous triggers, we would expect the phase to be both start and end
-        TestEqual(TEXT("Trigger phase should be Instantaneous"), ReceivedPhase, EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(ListenerHandle);
-    }
-
-    // Test 6: Invalid handle removal
-    {
-        // Create an invalid handle
-        FOGTriggerListenerHandle InvalidHandle;
-
-        // This should not crash
-        TriggerSubsystem->RemoveTriggerListener(InvalidHandle);
-        
-        TestTrue(TEXT("Test completed without crashing"), true);
-    }
-
-    // Test 7: Test StartTrigger, UpdateTrigger, and EndTrigger flow with proper phases
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        EOGTriggerListenerPhases ReceivedStartPhase = EOGTriggerListenerPhases::None;
-        EOGTriggerListenerPhases ReceivedUpdatePhase = EOGTriggerListenerPhases::None;
-        EOGTriggerListenerPhases ReceivedEndPhase = EOGTriggerListenerPhases::None;
-        int32 StartCallCount = 0;
-        int32 UpdateCallCount = 0;
-        int32 EndCallCount = 0;
-
-        // Create test delegates
-        FOGTriggerDelegate StartDelegate;
-        StartDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            ReceivedStartPhase = TriggerPhase;
-            StartCallCount++;
-            TestEqual(TEXT("Data at Trigger Start"),ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 123);
-        });
-
-        // Create test delegates
-        FOGTriggerDelegate UpdateDelegate;
-        UpdateDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            ReceivedStartPhase = TriggerPhase;
-            UpdateCallCount++;
-            TestEqual(TEXT("Data at Trigger Update"),ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 456);
-        });
-
-        FOGTriggerDelegate EndDelegate;
-        EndDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            ReceivedEndPhase = TriggerPhase;
-            EndCallCount++;
-            TestEqual(TEXT("Data at Trigger End"),ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 456);
-        });
-
-        // Register separate listeners for start and end phases
-        FOGTriggerListenerHandle StartListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, StartDelegate);
-        FOGTriggerListenerHandle UpdateListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerUpdate, UpdateDelegate);
-        FOGTriggerListenerHandle EndListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerEnd, EndDelegate);
-
-        // Create and start the trigger
-        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
-        TriggerContext->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 123;
-        FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTrigger(TriggerContext);
-
-        // Verify only start phase was fired
-        TestEqual(TEXT("Start callback should have been called once"), StartCallCount, 1);
-        TestEqual(TEXT("Update callback should not have been called yet"), UpdateCallCount, 0);
-        TestEqual(TEXT("End callback should not have been called yet"), EndCallCount, 0);
-        TestEqual(TEXT("Start phase should be TriggerStart"), ReceivedStartPhase, EOGTriggerListenerPhases::TriggerStart);
-
-        UOGGameplayTriggerContext* ContextToUpdate = TriggerSubsystem->GetTriggerContextForUpdate(TriggerHandle);
-        ContextToUpdate->DataBank.GetChecked<FTestTriggerData_Int>().TestInt = 456;
-        TriggerSubsystem->UpdateTrigger(TriggerHandle, ContextToUpdate);
-        
-        // Verify update was called 
-        TestEqual(TEXT("Start callback should have been called once"), StartCallCount, 1);
-        TestEqual(TEXT("Update callback should have been called once"), UpdateCallCount, 1);
-        TestEqual(TEXT("End callback should not have been called yet"), EndCallCount, 0);
-        TestEqual(TEXT("Update phase should be TriggerUpdate"), ReceivedStartPhase, EOGTriggerListenerPhases::TriggerUpdate);
-        
-        // End the trigger and verify end phase was fired
-        TriggerSubsystem->EndTrigger(TriggerHandle);
-        TestEqual(TEXT("Start callback should still be called once"), StartCallCount, 1);
-        TestEqual(TEXT("Update callback should have been called once"), UpdateCallCount, 1);
-        TestEqual(TEXT("End callback should have been called once"), EndCallCount, 1);
-        TestEqual(TEXT("End phase should be TriggerEnd"), ReceivedEndPhase, EOGTriggerListenerPhases::TriggerEnd);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(StartListenerHandle);
-        TriggerSubsystem->RemoveTriggerListener(UpdateListenerHandle);
-        TriggerSubsystem->RemoveTriggerListener(EndListenerHandle);
-    }
-
-    // Test 8: Testing filter functionality for initiator and target
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        
-        // Create test objects for initiator and target
-        AActor* TestInitiator1 = World->SpawnActor<AActor>();
-        AActor* TestInitiator2 = World->SpawnActor<AActor>();
-        AActor* TestTarget1 = World->SpawnActor<AActor>();
-        AActor* TestTarget2 = World->SpawnActor<AActor>();
-        
-        int32 UnfilteredCallCount = 0;
-        int32 InitiatorFilteredCallCount = 0;
-        int32 TargetFilteredCallCount = 0;
-        int32 BothFilteredCallCount = 0;
-        
-        // Create test delegates
-        FOGTriggerDelegate UnfilteredDelegate;
-        UnfilteredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            UnfilteredCallCount++;
-        });
-        
-        FOGTriggerDelegate InitiatorFilteredDelegate;
-        InitiatorFilteredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            InitiatorFilteredCallCount++;
-        });
-        
-        FOGTriggerDelegate TargetFilteredDelegate;
-        TargetFilteredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            TargetFilteredCallCount++;
-        });
-        
-        FOGTriggerDelegate BothFilteredDelegate;
-        BothFilteredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            BothFilteredCallCount++;
-        });
-
-        // Register listeners with different filter combinations
-        FOGTriggerListenerHandle UnfilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, UnfilteredDelegate);
-        
-        FOGTriggerListenerHandle InitiatorFilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, InitiatorFilteredDelegate, TestInitiator1, nullptr);
-        
-        FOGTriggerListenerHandle TargetFilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, TargetFilteredDelegate, nullptr, TestTarget1);
-        
-        FOGTriggerListenerHandle BothFilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, BothFilteredDelegate, TestInitiator1, TestTarget1);
-
-        // Test Case 1: Should hit all but target-filtered and both-filtered
-        UOGGameplayTriggerContext* TriggerContext1 = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer, TestInitiator1, TestTarget2);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext1);
-        
-        TestEqual(TEXT("Unfiltered callback should have been called once"), UnfilteredCallCount, 1);
-        TestEqual(TEXT("Initiator-filtered callback should have been called once"), InitiatorFilteredCallCount, 1);
-        TestEqual(TEXT("Target-filtered callback should not have been called"), TargetFilteredCallCount, 0);
-        TestEqual(TEXT("Both-filtered callback should not have been called"), BothFilteredCallCount, 0);
-
-        // Test Case 2: Should hit all but initiator-filtered and both-filtered
-        UOGGameplayTriggerContext* TriggerContext2 = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer, TestInitiator2, TestTarget1);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext2);
-        
-        TestEqual(TEXT("Unfiltered callback should have been called twice"), UnfilteredCallCount, 2);
-        TestEqual(TEXT("Initiator-filtered callback should still have been called once"), InitiatorFilteredCallCount, 1);
-        TestEqual(TEXT("Target-filtered callback should have been called once"), TargetFilteredCallCount, 1);
-        TestEqual(TEXT("Both-filtered callback should not have been called"), BothFilteredCallCount, 0);
-
-        // Test Case 3: Should hit all callbacks
-        UOGGameplayTriggerContext* TriggerContext3 = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer, TestInitiator1, TestTarget1);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext3);
-        
-        TestEqual(TEXT("Unfiltered callback should have been called three times"), UnfilteredCallCount, 3);
-        TestEqual(TEXT("Initiator-filtered callback should have been called twice"), InitiatorFilteredCallCount, 2);
-        TestEqual(TEXT("Target-filtered callback should have been called twice"), TargetFilteredCallCount, 2);
-        TestEqual(TEXT("Both-filtered callback should have been called once"), BothFilteredCallCount, 1);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(UnfilteredHandle);
-        TriggerSubsystem->RemoveTriggerListener(InitiatorFilteredHandle);
-        TriggerSubsystem->RemoveTriggerListener(TargetFilteredHandle);
-        TriggerSubsystem->RemoveTriggerListener(BothFilteredHandle);
-    }
-
-    // Test 9: Test multiple phases in a single listener
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        TArray<EOGTriggerListenerPhases> ReceivedPhases;
-        
-        // Create test delegate that records all received phases
-        FOGTriggerDelegate MultiPhaseDelegate;
-        MultiPhaseDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            ReceivedPhases.Add(TriggerPhase);
-        });
-        
-        // Register a listener for both start and end phases
-        FOGTriggerListenerHandle MultiPhaseHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd, MultiPhaseDelegate);
-        
-        // Test instantaneous trigger (should get one callback with both phases)
-        ReceivedPhases.Empty();
-        UOGGameplayTriggerContext* InstantTriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(InstantTriggerContext);
-        
-        TestEqual(TEXT("Should receive 1 callback for instantaneous trigger"), ReceivedPhases.Num(), 1);
-        TestEqual(TEXT("Phase for instantaneous trigger should be Start|End"), 
-            ReceivedPhases[0], EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd);
-        
-        // Test separate start/end triggers (should get two separate callbacks)
-        ReceivedPhases.Empty();
-        UOGGameplayTriggerContext* DurationTriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTrigger(DurationTriggerContext);
-        
-        TestEqual(TEXT("Should receive 1 callback after StartTrigger"), ReceivedPhases.Num(), 1);
-        TestEqual(TEXT("First phase should be TriggerStart"), ReceivedPhases[0], EOGTriggerListenerPhases::TriggerStart);
-        
-        TriggerSubsystem->EndTrigger(TriggerHandle);
-        TestEqual(TEXT("Should receive 2 callbacks total after EndTrigger"), ReceivedPhases.Num(), 2);
-        TestEqual(TEXT("Second phase should be TriggerEnd"), ReceivedPhases[1], EOGTriggerListenerPhases::TriggerEnd);
-        
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(MultiPhaseHandle);
-    }
-
-    // Test 10: test filters
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        int ReceivedFilteredCount = 0;
-        int ReceivedUnfilteredCount = 0;
-
-        // Create test delegates that record filtered and unfiltered counts
-        FOGTriggerDelegate FilteredTriggerDelegate;
-        FilteredTriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            ReceivedFilteredCount++;
-        });
-        
-        // Create test delegates that record filtered and unfiltered counts
-        FOGTriggerDelegate UnfilteredTriggerDelegate;
-        UnfilteredTriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            ReceivedUnfilteredCount++;
-        });
-        
-        // Register a listener for both start and end phases
-        FOGTriggerListenerHandle FilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, FilteredTriggerDelegate, nullptr, nullptr, false, {UOGTestTriggerFilter_DataIsPositive::StaticClass()->GetDefaultObject<UOGTestTriggerFilter_DataIsPositive>()});
-
-        FOGTriggerListenerHandle UnfilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, UnfilteredTriggerDelegate);
-
-        UOGGameplayTriggerContext* InstantTriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(InstantTriggerContext);
-
-        TestEqual(TEXT("Trigger with no data should not pass the filter"), ReceivedFilteredCount, 0);
-        TestEqual(TEXT("Unfiltered count should be 1"), ReceivedUnfilteredCount, 1);
-
-        InstantTriggerContext->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = -123;
-        TriggerSubsystem->InstantaneousTrigger(InstantTriggerContext);
-
-        TestEqual(TEXT("Trigger with negative value in data should not pass the filter"), ReceivedFilteredCount, 0);
-        TestEqual(TEXT("Unfiltered count should be 2"), ReceivedUnfilteredCount, 2);
-
-        InstantTriggerContext->DataBank.GetChecked<FTestTriggerData_Int>().TestInt = 456;
-        TriggerSubsystem->InstantaneousTrigger(InstantTriggerContext);
-
-        TestEqual(TEXT("Trigger with positive value in data should pass the filter"), ReceivedFilteredCount, 1);
-        TestEqual(TEXT("Unfiltered count should be 3"), ReceivedUnfilteredCount, 3);
-
-        //Clean up
-        FilteredHandle.Reset();
-        UnfilteredHandle.Reset();
-    }
-
-    return true;
-}
-
-IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemPendingOperationsTest, "OccamsGamekit.OGGameplayTrigger.PendingOperationsQueue",
-                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
-
-bool FOGTriggerSubsystemPendingOperationsTest::RunTest(const FString& Parameters)
-{
-    // Setup test environment
-    FTestWorldWrapper WorldWrapper;
-    WorldWrapper.CreateTestWorld(EWorldType::Game);
-    UWorld* World = WorldWrapper.GetTestWorld();
-    if (!World)
-        return false;
-
-    // Get the trigger subsystem
-    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
-    if (!TriggerSubsystem)
-    {
-        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
-        return false;
-    }
-
-    // Test 1: Adding a listener during trigger processing
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        int32 PrimaryCallbackCount = 0;
-        int32 SecondaryCallbackCount = 0;
-        FOGTriggerListenerHandle SecondaryHandle;
-
-        // Create a primary delegate that will register a new listener during execution
-        FOGTriggerDelegate PrimaryDelegate;
-        PrimaryDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            PrimaryCallbackCount++;
-
-            if (SecondaryHandle.IsValid())
-                return;
-            // Register a secondary listener during the primary callback
-            FOGTriggerDelegate SecondaryDelegate;
-            SecondaryDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-            {
-                SecondaryCallbackCount++;
-            });
-            
-            SecondaryHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-                EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd, 
-                SecondaryDelegate);
-        });
-
-        // Register the primary listener
-        FOGTriggerListenerHandle PrimaryHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, PrimaryDelegate);
-
-        // Fire the trigger
-        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-
-        // Verify that the primary callback was called, but not the secondary (should be pending)
-        TestEqual(TEXT("Primary callback should have been called once"), PrimaryCallbackCount, 1);
-        TestEqual(TEXT("Secondary callback should not have been called for the current trigger"), SecondaryCallbackCount, 0);
-
-        // Fire another trigger to verify the secondary listener is now active
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-        TestEqual(TEXT("Primary callback should have been called twice"), PrimaryCallbackCount, 2);
-        TestEqual(TEXT("Secondary callback should have been called once"), SecondaryCallbackCount, 1);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(PrimaryHandle);
-        TriggerSubsystem->RemoveTriggerListener(SecondaryHandle);
-    }
-
-    // Test 2: Removing a listener during trigger processing
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        int32 FirstCallbackCount = 0;
-        int32 SecondCallbackCount = 0;
-        int32 ThirdCallbackCount = 0;
-        FOGTriggerListenerHandle SecondHandle;
-        FOGTriggerListenerHandle ThirdHandle;
-
-        // Create delegates
-        FOGTriggerDelegate FirstDelegate;
-        FirstDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            FirstCallbackCount++;
-            
-            // Remove the second listener during the first callback
-            if (SecondHandle.IsValid())
-            {
-                TriggerSubsystem->RemoveTriggerListener(SecondHandle);
-            }
-        });
-
-        FOGTriggerDelegate SecondDelegate;
-        SecondDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            SecondCallbackCount++;
-        });
-
-        FOGTriggerDelegate ThirdDelegate;
-        ThirdDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            ThirdCallbackCount++;
-        });
-
-        // Register the listeners in a specific order
-        FOGTriggerListenerHandle FirstHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, FirstDelegate);
-        SecondHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, SecondDelegate);
-        ThirdHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, ThirdDelegate);
-
-        // Fire the trigger
-        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-
-        // Verify that all callbacks were called for the current trigger despite the removal
-        TestEqual(TEXT("First callback should have been called once"), FirstCallbackCount, 1);
-        TestEqual(TEXT("Second callback should have been called once"), SecondCallbackCount, 1);
-        TestEqual(TEXT("Third callback should have been called once"), ThirdCallbackCount, 1);
-
-        // Fire another trigger to verify the second listener is now inactive
-        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
-        TestEqual(TEXT("First callback should have been called twice"), FirstCallbackCount, 2);
-        TestEqual(TEXT("Second callback should still have been called only once"), SecondCallbackCount, 1);
-        TestEqual(TEXT("Third callback should have been called twice"), ThirdCallbackCount, 2);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(FirstHandle);
-        TriggerSubsystem->RemoveTriggerListener(ThirdHandle);
-    }
-
-    // Test 3: Starting a trigger during trigger processing
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        FGameplayTag NestedTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Nested"));
-        int32 OuterCallbackCount = 0;
-        int32 NestedCallbackCount = 0;
-        FOGGameplayTriggerHandle NestedTriggerHandle;
-
-        // Create delegates
-        FOGTriggerDelegate OuterDelegate;
-        OuterDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            OuterCallbackCount++;
-            
-            // Start a nested trigger during the outer callback
-            UOGGameplayTriggerContext* NestedContext = TriggerSubsystem->MakeGameplayTriggerContext(NestedTriggerType, 
-                FGameplayTagContainer::EmptyContainer);
-            NestedTriggerHandle = TriggerSubsystem->StartTrigger(NestedContext);
-        });
-
-        FOGTriggerDelegate NestedDelegate;
-        NestedDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            NestedCallbackCount++;
-        });
-
-        // Register the listeners
-        FOGTriggerListenerHandle OuterHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, OuterDelegate);
-        FOGTriggerListenerHandle NestedHandle = TriggerSubsystem->RegisterTriggerListener(NestedTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, NestedDelegate);
-
-        // Fire the outer trigger
-        UOGGameplayTriggerContext* OuterContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(OuterContext);
-
-        // Verify that the outer callback was called, and the nested trigger was processed after
-        TestEqual(TEXT("Outer callback should have been called once"), OuterCallbackCount, 1);
-        TestEqual(TEXT("Nested callback should have been called once"), NestedCallbackCount, 1);
-        TestTrue(TEXT("Nested trigger handle should be valid"), NestedTriggerHandle.IsValid());
-
-        // Clean up
-        TriggerSubsystem->EndTrigger(NestedTriggerHandle);
-        TriggerSubsystem->RemoveTriggerListener(OuterHandle);
-        TriggerSubsystem->RemoveTriggerListener(NestedHandle);
-    }
-
-    // Test 4: Ending a trigger during trigger processing
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        FGameplayTag TestTriggerType2 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Nested"));
-        int32 StartCallbackCount = 0;
-        int32 EndCallbackCount = 0;
-        FOGGameplayTriggerHandle TriggerToEndHandle;
-
-        // Create a trigger to end before testing
-        UOGGameplayTriggerContext* PreExistingContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType2, 
-            FGameplayTagContainer::EmptyContainer);
-        TriggerToEndHandle = TriggerSubsystem->StartTrigger(PreExistingContext);
-
-        // Create delegates
-        FOGTriggerDelegate StartDelegate;
-        StartDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            StartCallbackCount++;
-            // End the pre-existing trigger during a callback
-            TriggerSubsystem->EndTrigger(TriggerToEndHandle);
-            TestEqual(TEXT("End callback should not run until after the Start callback is finished"), EndCallbackCount, 0);
-        });
-
-        FOGTriggerDelegate EndDelegate;
-        EndDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            EndCallbackCount++;
-        });
-
-        // Register listeners for both start and end phases
-        FOGTriggerListenerHandle StartHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, StartDelegate);
-        FOGTriggerListenerHandle EndHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType2, 
-            EOGTriggerListenerPhases::TriggerEnd, EndDelegate);
-
-        // Fire a trigger to trigger the start callback
-        UOGGameplayTriggerContext* NewContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(NewContext);
-
-        // Verify that the start callback was called, and the end callback was processed after
-        TestEqual(TEXT("Start callback should have been called once"), StartCallbackCount, 1);
-        TestEqual(TEXT("End callback should have been called once"), EndCallbackCount, 1);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(StartHandle);
-        TriggerSubsystem->RemoveTriggerListener(EndHandle);
-    }
-
-    // Test 5: Queuing multiple operations during trigger processing
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        int32 MainCallbackCount = 0;
-        int32 SecondCallbackCount = 0;
-        FOGTriggerListenerHandle SecondHandle;
-        FOGGameplayTriggerHandle TriggerHandleA;
-        FOGGameplayTriggerHandle TriggerHandleB;
-
-        // Create delegates
-        FOGTriggerDelegate MainDelegate;
-        MainDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            MainCallbackCount++;
-            
-            if (MainCallbackCount > 1)
-                return;
-            
-            // Queue multiple operations during the main callback
-            // 1. Start a trigger
-            UOGGameplayTriggerContext* ContextA = TriggerSubsystem->MakeGameplayTriggerContext(
-                TestTriggerType, FGameplayTagContainer::EmptyContainer);
-            TriggerHandleA = TriggerSubsystem->StartTrigger(ContextA);
-            
-            // 2. Register a new listener
-            FOGTriggerDelegate SecondDelegate;
-            SecondDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-            {
-                SecondCallbackCount++;
-                
-                // 3. Start another trigger from the second callback
-                UOGGameplayTriggerContext* ContextB = TriggerSubsystem->MakeGameplayTriggerContext(
-                    TestTriggerType, FGameplayTagContainer::EmptyContainer);
-                TriggerHandleB = TriggerSubsystem->StartTrigger(ContextB);
-
-                TriggerSubsystem->RemoveTriggerListener(SecondHandle);
-            });
-            
-            SecondHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-                EOGTriggerListenerPhases::TriggerStart, SecondDelegate);
-        });
-
-        // Register the main listener
-        FOGTriggerListenerHandle MainHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, MainDelegate);
-
-        // Initial trigger fire
-        UOGGameplayTriggerContext* InitialContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        TriggerSubsystem->InstantaneousTrigger(InitialContext);
-
-        // Verify operation ordering
-        TestEqual(TEXT("Main callback should have been called three times"), MainCallbackCount, 3);
-        TestEqual(TEXT("Second callback should have been called once"), SecondCallbackCount, 1);
-        TestTrue(TEXT("TriggerHandleA should be valid"), TriggerHandleA.IsActive());
-        TestTrue(TEXT("TriggerHandleB should be valid"), TriggerHandleB.IsActive());
-
-        // Clean up
-        TriggerSubsystem->EndTrigger(TriggerHandleA);
-        TriggerSubsystem->EndTrigger(TriggerHandleB);
-        TriggerSubsystem->RemoveTriggerListener(MainHandle);
-        TriggerSubsystem->RemoveTriggerListener(SecondHandle);
-    }
-
-    // Test 6: Multiple 'simultaneous' updates to a trigger
-    {
-        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
-        int32 StartCallbackCount = 0;
-        int32 UpdateCallbackCount = 0;
-
-        // Create delegates
-        FOGTriggerDelegate MainDelegate;
-        MainDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            StartCallbackCount++;
-
-            TestEqual(TEXT("Data On Start"), ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 789);
-
-            UOGGameplayTriggerContext* ContextForUpdate = TriggerSubsystem->GetTriggerContextForUpdate(TriggerHandle);
-            ContextForUpdate->DataBank.GetChecked<FTestTriggerData_Int>().TestInt++;
-            TriggerSubsystem->UpdateTrigger(TriggerHandle, ContextForUpdate);
-        });
-
-        // Create delegates
-        FOGTriggerDelegate UpdateDelegate;
-        UpdateDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
-        {
-            TestEqual(TEXT("Start should be called twice before any updates"), StartCallbackCount, 2);
-            
-            UpdateCallbackCount++;
-            
-            TestEqual(TEXT("Data On Update in first update should be one more than data at start, and in second update should be one higher again"),
-                ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 789 + UpdateCallbackCount);
-        });
-
-        // Register two listeners that will update the trigger on start
-        FOGTriggerListenerHandle StartHandleOne = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, MainDelegate);
-        FOGTriggerListenerHandle StartHandleTwo = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
-            EOGTriggerListenerPhases::TriggerStart, MainDelegate);
-
-        FOGTriggerListenerHandle UpdateHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType,
-            EOGTriggerListenerPhases::TriggerUpdate, UpdateDelegate);
-        
-        // Initial trigger fire
-        UOGGameplayTriggerContext* InitialContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
-            FGameplayTagContainer::EmptyContainer);
-        InitialContext->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 789;
-        FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTrigger(InitialContext);
-
-        // Verify operation ordering
-        TestEqual(TEXT("Main callback should have been called twice"), StartCallbackCount, 2);
-        TestEqual(TEXT("Update callback should have been called twice"), UpdateCallbackCount, 2);
-
-        // Clean up
-        TriggerSubsystem->RemoveTriggerListener(StartHandleOne);
-        TriggerSubsystem->RemoveTriggerListener(StartHandleTwo);
-        TriggerSubsystem->RemoveTriggerListener(UpdateHandle);
-        TriggerHandle.Reset();
-    }
-
-    return true;
-}
-
-bool UOGTestTriggerFilter_DataIsPositive::DoesTriggerPassFilter_Native(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const
-{
-    const FTestTriggerData_Int* Data = Trigger->DataBank.FindConst<FTestTriggerData_Int>();
-    if (!Data)
-        return false;
-    return Data->TestInt > 0;
-}
+﻿#include "OGGameplayTriggerTests.h"
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OGGameplayTriggerSubsystem.h"
+#include "OGGameplayTriggerTypes.h"
+#include "OGTriggerEngine.h"
+#include "OGTriggerTagSet.h"
+#include "OGTriggerTelemetry.h"
+#include "OGTypedTrigger.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tests/AutomationCommon.h"
+
+// Registers a listener that only counts its calls. Works with the subsystem and with headless engines
+template<typename TTriggers>
+static FOGTriggerListenerHandle RegisterCountingListener(TTriggers& Triggers, const FGameplayTag& TriggerType, EOGTriggerListenerPhases Phases, int32& Counter,
+                                                         const FOGTriggerListenerOptions& Options = FOGTriggerListenerOptions())
+{
+    FOGTriggerDelegate Delegate;
+    Delegate.BindLambda([&Counter](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        Counter++;
+    });
+    return Triggers.RegisterTriggerListener(TriggerType, Phases, Delegate, Options);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemBasicTest, "OccamsGamekit.OGGameplayTrigger.BasicFunctionality",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemBasicTest::RunTest(const FString& Parameters)
+{
+    // This will get cleaned up when it leaves scope
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    // Get the trigger subsystem
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    // Test 1: Basic registration and triggering
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        bool bCallbackReceived = false;
+        AActor* ReceivedInitiator = nullptr;
+        AActor* ReceivedTarget = nullptr;
+        FGameplayTagContainer ReceivedTriggerTags;
+
+        // Create a test delegate
+        FOGTriggerDelegate TriggerDelegate;
+        TriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            bCallbackReceived = true;
+            ReceivedInitiator = Cast<AActor>(ActiveTrigger->InitiatorObject);
+            ReceivedTarget = Cast<AActor>(ActiveTrigger->TargetObject);
+            ReceivedTriggerTags = ActiveTrigger->GetTriggerTags();
+        });
+
+        // Register the listener
+        FOGTriggerListenerHandle ListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate);
+        TestTrue(TEXT("Listener handle should be valid"), ListenerHandle.IsValid());
+
+        // Create test objects for initiator and target
+        AActor* TestInitiator = World->SpawnActor<AActor>();
+        AActor* TestTarget = World->SpawnActor<AActor>();
+
+        // Create test trigger tags
+        FGameplayTagContainer TestTriggerTags;
+        TestTriggerTags.AddTag(FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1")));
+        TestTriggerTags.AddTag(FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2")));
+
+        // Fire the trigger
+        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, TestTriggerTags, TestInitiator, TestTarget);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+
+        // Verify the callback was received with correct parameters
+        TestTrue(TEXT("Callback should have been received"), bCallbackReceived);
+        TestEqual(TEXT("Initiator should match"), ReceivedInitiator, TestInitiator);
+        TestEqual(TEXT("Target should match"), ReceivedTarget, TestTarget);
+        TestEqual(TEXT("Trigger tags should match"), ReceivedTriggerTags, TestTriggerTags);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(ListenerHandle);
+    }
+
+    // Test 2: Multiple listeners for the same trigger type
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int32 CallbackCount1 = 0;
+        int32 CallbackCount2 = 0;
+
+        // Create test delegates
+        FOGTriggerDelegate TriggerDelegate1;
+        TriggerDelegate1.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            CallbackCount1++;
+        });
+
+        FOGTriggerDelegate TriggerDelegate2;
+        TriggerDelegate2.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            CallbackCount2++;
+        });
+
+        // Register the listeners
+        FOGTriggerListenerHandle ListenerHandle1 = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate1);
+        FOGTriggerListenerHandle ListenerHandle2 = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate2);
+
+        // Fire the trigger
+        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+
+        // Verify both callbacks were received
+        TestEqual(TEXT("First callback should have been received once"), CallbackCount1, 1);
+        TestEqual(TEXT("Second callback should have been received once"), CallbackCount2, 1);
+
+        // Remove one listener and fire again
+        TriggerSubsystem->RemoveTriggerListener(ListenerHandle1);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+
+        // Verify only the second callback was received
+        TestEqual(TEXT("First callback should still have been received once"), CallbackCount1, 1);
+        TestEqual(TEXT("Second callback should have been received twice"), CallbackCount2, 2);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(ListenerHandle2);
+    }
+
+    // Test 3: Test bShouldFireForExistingTriggers parameter
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int32 CallbackCount = 0;
+
+        // Fire a trigger before registering any listeners
+        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        FOGGameplayTriggerHandle ActiveTriggerHandle = TriggerSubsystem->StartTrigger(TriggerContext);
+
+        // Create a test delegate
+        FOGTriggerDelegate TriggerDelegate;
+        TriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            CallbackCount++;
+        });
+
+        // Register with bShouldFireForExistingTriggers = false (default)
+        FOGTriggerListenerHandle ListenerHandle1 = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate);
+        
+        // Verify no callback was received for the pre-existing trigger
+        TestEqual(TEXT("No callback should have been received"), CallbackCount, 0);
+        
+        FOGTriggerListenerHandle ListenerHandle2 = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate, nullptr, nullptr, true);
+        
+        // Verify a callback was received for the pre-existing trigger
+        TestEqual(TEXT("One callback should have been received"), CallbackCount, 1);
+        
+        // Clean up
+        TriggerSubsystem->EndTrigger(ActiveTriggerHandle);
+        TriggerSubsystem->RemoveTriggerListener(ListenerHandle1);
+        TriggerSubsystem->RemoveTriggerListener(ListenerHandle2);
+    }
+
+    // Test 4: Removing a listener
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int32 CallbackCount = 0;
+
+        // Create a test delegate
+        FOGTriggerDelegate TriggerDelegate;
+        TriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            CallbackCount++;
+        });
+
+        // Register the listener
+        FOGTriggerListenerHandle ListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, TriggerDelegate);
+
+        // Fire the trigger
+        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+        TestEqual(TEXT("Callback should have been received once"), CallbackCount, 1);
+
+        // Remove the listener
+        TriggerSubsystem->RemoveTriggerListener(ListenerHandle);
+
+        // Fire the trigger again
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+        TestEqual(TEXT("Callback count should still be 1"), CallbackCount, 1);
+    }
+
+    // Test 5: Verify TriggerPhase is set correctly for InstantaneousTrigger
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        EOGTriggerListenerPhases ReceivedPhase = EOGTriggerListenerPhases::None;
+
+        // Register the listener
+        FOGTriggerListenerHandle ListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, FOGTriggerDelegate::CreateLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ReceivedPhase = TriggerPhase;
+        }));
+
+        // Fire the trigger
+        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+        
+        // For instantaneous triggers, we would expect the phase to be both start and end
+        TestEqual(TEXT("Trigger phase should be Instantaneous"), ReceivedPhase, EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(ListenerHandle);
+    }
+
+    // Test 6: Invalid handle removal
+    {
+        // Create an invalid handle
+        FOGTriggerListenerHandle InvalidHandle;
+
+        // This should not crash
+        TriggerSubsystem->RemoveTriggerListener(InvalidHandle);
+        
+        TestTrue(TEXT("Test completed without crashing"), true);
+    }
+
+    // Test 7: Test StartTrigger, UpdateTrigger, and EndTrigger flow with proper phases
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        EOGTriggerListenerPhases ReceivedStartPhase = EOGTriggerListenerPhases::None;
+        EOGTriggerListenerPhases ReceivedUpdatePhase = EOGTriggerListenerPhases::None;
+        EOGTriggerListenerPhases ReceivedEndPhase = EOGTriggerListenerPhases::None;
+        int32 StartCallCount = 0;
+        int32 UpdateCallCount = 0;
+        int32 EndCallCount = 0;
+
+        // Create test delegates
+        FOGTriggerDelegate StartDelegate;
+        StartDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ReceivedStartPhase = TriggerPhase;
+            StartCallCount++;
+            TestEqual(TEXT("Data at Trigger Start"),ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 123);
+        });
+
+        // Create test delegates
+        FOGTriggerDelegate UpdateDelegate;
+        UpdateDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ReceivedStartPhase = TriggerPhase;
+            UpdateCallCount++;
+            TestEqual(TEXT("Data at Trigger Update"),ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 456);
+        });
+
+        FOGTriggerDelegate EndDelegate;
+        EndDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ReceivedEndPhase = TriggerPhase;
+            EndCallCount++;
+            TestEqual(TEXT("Data at Trigger End"),ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 456);
+        });
+
+        // Register separate listeners for start and end phases
+        FOGTriggerListenerHandle StartListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, StartDelegate);
+        FOGTriggerListenerHandle UpdateListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerUpdate, UpdateDelegate);
+        FOGTriggerListenerHandle EndListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerEnd, EndDelegate);
+
+        // Create and start the trigger
+        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        TriggerContext->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 123;
+        FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTrigger(TriggerContext);
+
+        // Verify only start phase was fired
+        TestEqual(TEXT("Start callback should have been called once"), StartCallCount, 1);
+        TestEqual(TEXT("Update callback should not have been called yet"), UpdateCallCount, 0);
+        TestEqual(TEXT("End callback should not have been called yet"), EndCallCount, 0);
+        TestEqual(TEXT("Start phase should be TriggerStart"), ReceivedStartPhase, EOGTriggerListenerPhases::TriggerStart);
+
+        UOGGameplayTriggerContext* ContextToUpdate = TriggerSubsystem->GetTriggerContextForUpdate(TriggerHandle);
+        ContextToUpdate->DataBank.GetChecked<FTestTriggerData_Int>().TestInt = 456;
+        TriggerSubsystem->UpdateTrigger(TriggerHandle, ContextToUpdate);
+        
+        // Verify update was called 
+        TestEqual(TEXT("Start callback should have been called once"), StartCallCount, 1);
+        TestEqual(TEXT("Update callback should have been called once"), UpdateCallCount, 1);
+        TestEqual(TEXT("End callback should not have been called yet"), EndCallCount, 0);
+        TestEqual(TEXT("Update phase should be TriggerUpdate"), ReceivedStartPhase, EOGTriggerListenerPhases::TriggerUpdate);
+        
+        // End the trigger and verify end phase was fired
+        TriggerSubsystem->EndTrigger(TriggerHandle);
+        TestEqual(TEXT("Start callback should still be called once"), StartCallCount, 1);
+        TestEqual(TEXT("Update callback should have been called once"), UpdateCallCount, 1);
+        TestEqual(TEXT("End callback should have been called once"), EndCallCount, 1);
+        TestEqual(TEXT("End phase should be TriggerEnd"), ReceivedEndPhase, EOGTriggerListenerPhases::TriggerEnd);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(StartListenerHandle);
+        TriggerSubsystem->RemoveTriggerListener(UpdateListenerHandle);
+        TriggerSubsystem->RemoveTriggerListener(EndListenerHandle);
+    }
+
+    // Test 8: Testing filter functionality for initiator and target
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        
+        // Create test objects for initiator and target
+        AActor* TestInitiator1 = World->SpawnActor<AActor>();
+        AActor* TestInitiator2 = World->SpawnActor<AActor>();
+        AActor* TestTarget1 = World->SpawnActor<AActor>();
+        AActor* TestTarget2 = World->SpawnActor<AActor>();
+        
+        int32 UnfilteredCallCount = 0;
+        int32 InitiatorFilteredCallCount = 0;
+        int32 TargetFilteredCallCount = 0;
+        int32 BothFilteredCallCount = 0;
+        
+        // Create test delegates
+        FOGTriggerDelegate UnfilteredDelegate;
+        UnfilteredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            UnfilteredCallCount++;
+        });
+        
+        FOGTriggerDelegate InitiatorFilteredDelegate;
+        InitiatorFilteredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            InitiatorFilteredCallCount++;
+        });
+        
+        FOGTriggerDelegate TargetFilteredDelegate;
+        TargetFilteredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            TargetFilteredCallCount++;
+        });
+        
+        FOGTriggerDelegate BothFilteredDelegate;
+        BothFilteredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            BothFilteredCallCount++;
+        });
+
+        // Register listeners with different filter combinations
+        FOGTriggerListenerHandle UnfilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, UnfilteredDelegate);
+        
+        FOGTriggerListenerHandle InitiatorFilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, InitiatorFilteredDelegate, TestInitiator1, nullptr);
+        
+        FOGTriggerListenerHandle TargetFilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, TargetFilteredDelegate, nullptr, TestTarget1);
+        
+        FOGTriggerListenerHandle BothFilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, BothFilteredDelegate, TestInitiator1, TestTarget1);
+
+        // Test Case 1: Should hit all but target-filtered and both-filtered
+        UOGGameplayTriggerContext* TriggerContext1 = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer, TestInitiator1, TestTarget2);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext1);
+        
+        TestEqual(TEXT("Unfiltered callback should have been called once"), UnfilteredCallCount, 1);
+        TestEqual(TEXT("Initiator-filtered callback should have been called once"), InitiatorFilteredCallCount, 1);
+        TestEqual(TEXT("Target-filtered callback should not have been called"), TargetFilteredCallCount, 0);
+        TestEqual(TEXT("Both-filtered callback should not have been called"), BothFilteredCallCount, 0);
+
+        // Test Case 2: Should hit all but initiator-filtered and both-filtered
+        UOGGameplayTriggerContext* TriggerContext2 = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer, TestInitiator2, TestTarget1);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext2);
+        
+        TestEqual(TEXT("Unfiltered callback should have been called twice"), UnfilteredCallCount, 2);
+        TestEqual(TEXT("Initiator-filtered callback should still have been called once"), InitiatorFilteredCallCount, 1);
+        TestEqual(TEXT("Target-filtered callback should have been called once"), TargetFilteredCallCount, 1);
+        TestEqual(TEXT("Both-filtered callback should not have been called"), BothFilteredCallCount, 0);
+
+        // Test Case 3: Should hit all callbacks
+        UOGGameplayTriggerContext* TriggerContext3 = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer, TestInitiator1, TestTarget1);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext3);
+        
+        TestEqual(TEXT("Unfiltered callback should have been called three times"), UnfilteredCallCount, 3);
+        TestEqual(TEXT("Initiator-filtered callback should have been called twice"), InitiatorFilteredCallCount, 2);
+        TestEqual(TEXT("Target-filtered callback should have been called twice"), TargetFilteredCallCount, 2);
+        TestEqual(TEXT("Both-filtered callback should have been called once"), BothFilteredCallCount, 1);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(UnfilteredHandle);
+        TriggerSubsystem->RemoveTriggerListener(InitiatorFilteredHandle);
+        TriggerSubsystem->RemoveTriggerListener(TargetFilteredHandle);
+        TriggerSubsystem->RemoveTriggerListener(BothFilteredHandle);
+    }
+
+    // Test 9: Test multiple phases in a single listener
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        TArray<EOGTriggerListenerPhases> ReceivedPhases;
+        
+        // Create test delegate that records all received phases
+        FOGTriggerDelegate MultiPhaseDelegate;
+        MultiPhaseDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ReceivedPhases.Add(TriggerPhase);
+        });
+        
+        // Register a listener for both start and end phases
+        FOGTriggerListenerHandle MultiPhaseHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd, MultiPhaseDelegate);
+        
+        // Test instantaneous trigger (should get one callback with both phases)
+        ReceivedPhases.Empty();
+        UOGGameplayTriggerContext* InstantTriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(InstantTriggerContext);
+        
+        TestEqual(TEXT("Should receive 1 callback for instantaneous trigger"), ReceivedPhases.Num(), 1);
+        TestEqual(TEXT("Phase for instantaneous trigger should be Start|End"), 
+            ReceivedPhases[0], EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd);
+        
+        // Test separate start/end triggers (should get two separate callbacks)
+        ReceivedPhases.Empty();
+        UOGGameplayTriggerContext* DurationTriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTrigger(DurationTriggerContext);
+        
+        TestEqual(TEXT("Should receive 1 callback after StartTrigger"), ReceivedPhases.Num(), 1);
+        TestEqual(TEXT("First phase should be TriggerStart"), ReceivedPhases[0], EOGTriggerListenerPhases::TriggerStart);
+        
+        TriggerSubsystem->EndTrigger(TriggerHandle);
+        TestEqual(TEXT("Should receive 2 callbacks total after EndTrigger"), ReceivedPhases.Num(), 2);
+        TestEqual(TEXT("Second phase should be TriggerEnd"), ReceivedPhases[1], EOGTriggerListenerPhases::TriggerEnd);
+        
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(MultiPhaseHandle);
+    }
+
+    // Test 10: test filters
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int ReceivedFilteredCount = 0;
+        int ReceivedUnfilteredCount = 0;
+
+        // Create test delegates that record filtered and unfiltered counts
+        FOGTriggerDelegate FilteredTriggerDelegate;
+        FilteredTriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ReceivedFilteredCount++;
+        });
+        
+        // Create test delegates that record filtered and unfiltered counts
+        FOGTriggerDelegate UnfilteredTriggerDelegate;
+        UnfilteredTriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ReceivedUnfilteredCount++;
+        });
+        
+        // Register a listener for both start and end phases
+        FOGTriggerListenerHandle FilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, FilteredTriggerDelegate, nullptr, nullptr, false, {UOGTestTriggerFilter_DataIsPositive::StaticClass()->GetDefaultObject<UOGTestTriggerFilter_DataIsPositive>()});
+
+        FOGTriggerListenerHandle UnfilteredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, UnfilteredTriggerDelegate);
+
+        UOGGameplayTriggerContext* InstantTriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(InstantTriggerContext);
+
+        TestEqual(TEXT("Trigger with no data should not pass the filter"), ReceivedFilteredCount, 0);
+        TestEqual(TEXT("Unfiltered count should be 1"), ReceivedUnfilteredCount, 1);
+
+        InstantTriggerContext->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = -123;
+        TriggerSubsystem->InstantaneousTrigger(InstantTriggerContext);
+
+        TestEqual(TEXT("Trigger with negative value in data should not pass the filter"), ReceivedFilteredCount, 0);
+        TestEqual(TEXT("Unfiltered count should be 2"), ReceivedUnfilteredCount, 2);
+
+        InstantTriggerContext->DataBank.GetChecked<FTestTriggerData_Int>().TestInt = 456;
+        TriggerSubsystem->InstantaneousTrigger(InstantTriggerContext);
+
+        TestEqual(TEXT("Trigger with positive value in data should pass the filter"), ReceivedFilteredCount, 1);
+        TestEqual(TEXT("Unfiltered count should be 3"), ReceivedUnfilteredCount, 3);
+
+        //Clean up
+        FilteredHandle.Reset();
+        UnfilteredHandle.Reset();
+    }
+
+    // Test 11: null filters are ignored
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int ReceivedCount = 0;
+
+        FOGTriggerDelegate TriggerDelegate;
+        TriggerDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ReceivedCount++;
+        });
+
+        FOGTriggerListenerHandle NullFilterHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, TriggerDelegate, nullptr, nullptr, false, {nullptr});
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+
+        TestEqual(TEXT("Listener with a null filter should receive the trigger"), ReceivedCount, 1);
+
+        //Clean up
+        TriggerSubsystem->RemoveTriggerListener(NullFilterHandle);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemPendingOperationsTest, "OccamsGamekit.OGGameplayTrigger.PendingOperationsQueue",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemPendingOperationsTest::RunTest(const FString& Parameters)
+{
+    // Setup test environment
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    // Get the trigger subsystem
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    // Test 1: Adding a listener during trigger processing
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int32 PrimaryCallbackCount = 0;
+        int32 SecondaryCallbackCount = 0;
+        FOGTriggerListenerHandle SecondaryHandle;
+
+        // Create a primary delegate that will register a new listener during execution
+        FOGTriggerDelegate PrimaryDelegate;
+        PrimaryDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            PrimaryCallbackCount++;
+
+            if (SecondaryHandle.IsValid())
+                return;
+            // Register a secondary listener during the primary callback
+            FOGTriggerDelegate SecondaryDelegate;
+            SecondaryDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+            {
+                SecondaryCallbackCount++;
+            });
+            
+            SecondaryHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+                EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd, 
+                SecondaryDelegate);
+        });
+
+        // Register the primary listener
+        FOGTriggerListenerHandle PrimaryHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, PrimaryDelegate);
+
+        // Fire the trigger
+        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+
+        // Verify that the primary callback was called, but not the secondary (should be pending)
+        TestEqual(TEXT("Primary callback should have been called once"), PrimaryCallbackCount, 1);
+        TestEqual(TEXT("Secondary callback should not have been called for the current trigger"), SecondaryCallbackCount, 0);
+
+        // Fire another trigger to verify the secondary listener is now active
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+        TestEqual(TEXT("Primary callback should have been called twice"), PrimaryCallbackCount, 2);
+        TestEqual(TEXT("Secondary callback should have been called once"), SecondaryCallbackCount, 1);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(PrimaryHandle);
+        TriggerSubsystem->RemoveTriggerListener(SecondaryHandle);
+    }
+
+    // Test 2: Removing a listener during trigger processing
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int32 FirstCallbackCount = 0;
+        int32 SecondCallbackCount = 0;
+        int32 ThirdCallbackCount = 0;
+        FOGTriggerListenerHandle SecondHandle;
+        FOGTriggerListenerHandle ThirdHandle;
+
+        // Create delegates
+        FOGTriggerDelegate FirstDelegate;
+        FirstDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            FirstCallbackCount++;
+            
+            // Remove the second listener during the first callback
+            if (SecondHandle.IsValid())
+            {
+                TriggerSubsystem->RemoveTriggerListener(SecondHandle);
+            }
+        });
+
+        FOGTriggerDelegate SecondDelegate;
+        SecondDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            SecondCallbackCount++;
+        });
+
+        FOGTriggerDelegate ThirdDelegate;
+        ThirdDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            ThirdCallbackCount++;
+        });
+
+        // Register the listeners in a specific order
+        FOGTriggerListenerHandle FirstHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, FirstDelegate);
+        SecondHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, SecondDelegate);
+        ThirdHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, ThirdDelegate);
+
+        // Fire the trigger
+        UOGGameplayTriggerContext* TriggerContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+
+        // Verify that all callbacks were called for the current trigger despite the removal
+        TestEqual(TEXT("First callback should have been called once"), FirstCallbackCount, 1);
+        TestEqual(TEXT("Second callback should have been called once"), SecondCallbackCount, 1);
+        TestEqual(TEXT("Third callback should have been called once"), ThirdCallbackCount, 1);
+
+        // Fire another trigger to verify the second listener is now inactive
+        TriggerSubsystem->InstantaneousTrigger(TriggerContext);
+        TestEqual(TEXT("First callback should have been called twice"), FirstCallbackCount, 2);
+        TestEqual(TEXT("Second callback should still have been called only once"), SecondCallbackCount, 1);
+        TestEqual(TEXT("Third callback should have been called twice"), ThirdCallbackCount, 2);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(FirstHandle);
+        TriggerSubsystem->RemoveTriggerListener(ThirdHandle);
+    }
+
+    // Test 3: Starting a trigger during trigger processing
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        FGameplayTag NestedTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Nested"));
+        int32 OuterCallbackCount = 0;
+        int32 NestedCallbackCount = 0;
+        FOGGameplayTriggerHandle NestedTriggerHandle;
+
+        // Create delegates
+        FOGTriggerDelegate OuterDelegate;
+        OuterDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            OuterCallbackCount++;
+            
+            // Start a nested trigger during the outer callback
+            UOGGameplayTriggerContext* NestedContext = TriggerSubsystem->MakeGameplayTriggerContext(NestedTriggerType, 
+                FGameplayTagContainer::EmptyContainer);
+            NestedTriggerHandle = TriggerSubsystem->StartTrigger(NestedContext);
+        });
+
+        FOGTriggerDelegate NestedDelegate;
+        NestedDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            NestedCallbackCount++;
+        });
+
+        // Register the listeners
+        FOGTriggerListenerHandle OuterHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, OuterDelegate);
+        FOGTriggerListenerHandle NestedHandle = TriggerSubsystem->RegisterTriggerListener(NestedTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, NestedDelegate);
+
+        // Fire the outer trigger
+        UOGGameplayTriggerContext* OuterContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(OuterContext);
+
+        // Verify that the outer callback was called, and the nested trigger was processed after
+        TestEqual(TEXT("Outer callback should have been called once"), OuterCallbackCount, 1);
+        TestEqual(TEXT("Nested callback should have been called once"), NestedCallbackCount, 1);
+        TestTrue(TEXT("Nested trigger handle should be valid"), NestedTriggerHandle.IsValid());
+
+        // Clean up
+        TriggerSubsystem->EndTrigger(NestedTriggerHandle);
+        TriggerSubsystem->RemoveTriggerListener(OuterHandle);
+        TriggerSubsystem->RemoveTriggerListener(NestedHandle);
+    }
+
+    // Test 4: Ending a trigger during trigger processing
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        FGameplayTag TestTriggerType2 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Nested"));
+        int32 StartCallbackCount = 0;
+        int32 EndCallbackCount = 0;
+        FOGGameplayTriggerHandle TriggerToEndHandle;
+
+        // Create a trigger to end before testing
+        UOGGameplayTriggerContext* PreExistingContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType2, 
+            FGameplayTagContainer::EmptyContainer);
+        TriggerToEndHandle = TriggerSubsystem->StartTrigger(PreExistingContext);
+
+        // Create delegates
+        FOGTriggerDelegate StartDelegate;
+        StartDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            StartCallbackCount++;
+            // End the pre-existing trigger during a callback
+            TriggerSubsystem->EndTrigger(TriggerToEndHandle);
+            TestEqual(TEXT("End callback should not run until after the Start callback is finished"), EndCallbackCount, 0);
+        });
+
+        FOGTriggerDelegate EndDelegate;
+        EndDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            EndCallbackCount++;
+        });
+
+        // Register listeners for both start and end phases
+        FOGTriggerListenerHandle StartHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, StartDelegate);
+        FOGTriggerListenerHandle EndHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType2, 
+            EOGTriggerListenerPhases::TriggerEnd, EndDelegate);
+
+        // Fire a trigger to trigger the start callback
+        UOGGameplayTriggerContext* NewContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(NewContext);
+
+        // Verify that the start callback was called, and the end callback was processed after
+        TestEqual(TEXT("Start callback should have been called once"), StartCallbackCount, 1);
+        TestEqual(TEXT("End callback should have been called once"), EndCallbackCount, 1);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(StartHandle);
+        TriggerSubsystem->RemoveTriggerListener(EndHandle);
+    }
+
+    // Test 5: Queuing multiple operations during trigger processing
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int32 MainCallbackCount = 0;
+        int32 SecondCallbackCount = 0;
+        FOGTriggerListenerHandle SecondHandle;
+        FOGGameplayTriggerHandle TriggerHandleA;
+        FOGGameplayTriggerHandle TriggerHandleB;
+
+        // Create delegates
+        FOGTriggerDelegate MainDelegate;
+        MainDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            MainCallbackCount++;
+            
+            if (MainCallbackCount > 1)
+                return;
+            
+            // Queue multiple operations during the main callback
+            // 1. Start a trigger
+            UOGGameplayTriggerContext* ContextA = TriggerSubsystem->MakeGameplayTriggerContext(
+                TestTriggerType, FGameplayTagContainer::EmptyContainer);
+            TriggerHandleA = TriggerSubsystem->StartTrigger(ContextA);
+            
+            // 2. Register a new listener
+            FOGTriggerDelegate SecondDelegate;
+            SecondDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+            {
+                SecondCallbackCount++;
+                
+                // 3. Start another trigger from the second callback
+                UOGGameplayTriggerContext* ContextB = TriggerSubsystem->MakeGameplayTriggerContext(
+                    TestTriggerType, FGameplayTagContainer::EmptyContainer);
+                TriggerHandleB = TriggerSubsystem->StartTrigger(ContextB);
+
+                TriggerSubsystem->RemoveTriggerListener(SecondHandle);
+            });
+            
+            SecondHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+                EOGTriggerListenerPhases::TriggerStart, SecondDelegate);
+        });
+
+        // Register the main listener
+        FOGTriggerListenerHandle MainHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, MainDelegate);
+
+        // Initial trigger fire
+        UOGGameplayTriggerContext* InitialContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        TriggerSubsystem->InstantaneousTrigger(InitialContext);
+
+        // Verify operation ordering
+        TestEqual(TEXT("Main callback should have been called three times"), MainCallbackCount, 3);
+        TestEqual(TEXT("Second callback should have been called once"), SecondCallbackCount, 1);
+        TestTrue(TEXT("TriggerHandleA should be valid"), TriggerHandleA.IsActive());
+        TestTrue(TEXT("TriggerHandleB should be valid"), TriggerHandleB.IsActive());
+
+        // Clean up
+        TriggerSubsystem->EndTrigger(TriggerHandleA);
+        TriggerSubsystem->EndTrigger(TriggerHandleB);
+        TriggerSubsystem->RemoveTriggerListener(MainHandle);
+        TriggerSubsystem->RemoveTriggerListener(SecondHandle);
+    }
+
+    // Test 6: Multiple 'simultaneous' updates to a trigger
+    {
+        FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+        int32 StartCallbackCount = 0;
+        int32 UpdateCallbackCount = 0;
+
+        // Create delegates
+        FOGTriggerDelegate MainDelegate;
+        MainDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            StartCallbackCount++;
+
+            TestEqual(TEXT("Data On Start"), ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 789);
+
+            UOGGameplayTriggerContext* ContextForUpdate = TriggerSubsystem->GetTriggerContextForUpdate(TriggerHandle);
+            ContextForUpdate->DataBank.GetChecked<FTestTriggerData_Int>().TestInt++;
+            TriggerSubsystem->UpdateTrigger(TriggerHandle, ContextForUpdate);
+        });
+
+        // Create delegates
+        FOGTriggerDelegate UpdateDelegate;
+        UpdateDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            TestEqual(TEXT("Start should be called twice before any updates"), StartCallbackCount, 2);
+            
+            UpdateCallbackCount++;
+            
+            TestEqual(TEXT("Data On Update in first update should be one more than data at start, and in second update should be one higher again"),
+                ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt, 789 + UpdateCallbackCount);
+        });
+
+        // Register two listeners that will update the trigger on start
+        FOGTriggerListenerHandle StartHandleOne = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, MainDelegate);
+        FOGTriggerListenerHandle StartHandleTwo = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, 
+            EOGTriggerListenerPhases::TriggerStart, MainDelegate);
+
+        FOGTriggerListenerHandle UpdateHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType,
+            EOGTriggerListenerPhases::TriggerUpdate, UpdateDelegate);
+        
+        // Initial trigger fire
+        UOGGameplayTriggerContext* InitialContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, 
+            FGameplayTagContainer::EmptyContainer);
+        InitialContext->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 789;
+        FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTrigger(InitialContext);
+
+        // Verify operation ordering
+        TestEqual(TEXT("Main callback should have been called twice"), StartCallbackCount, 2);
+        TestEqual(TEXT("Update callback should have been called twice"), UpdateCallbackCount, 2);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(StartHandleOne);
+        TriggerSubsystem->RemoveTriggerListener(StartHandleTwo);
+        TriggerSubsystem->RemoveTriggerListener(UpdateHandle);
+        TriggerHandle.Reset();
+    }
+
+    return true;
+}
+
+bool UOGTestTriggerFilter_DataIsPositive::DoesTriggerPassFilter_Native(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const
+{
+    const FTestTriggerData_Int* Data = Trigger->DataBank.FindConst<FTestTriggerData_Int>();
+    if (!Data)
+        return false;
+    return Data->TestInt > 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemSnapshotTest, "OccamsGamekit.OGGameplayTrigger.SnapshotRestore",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemSnapshotTest::RunTest(const FString& Parameters)
+{
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    TArray<uint8> SnapshotBytes;
+    FOGGameplayTriggerHandle SavedHandle;
+
+    // Test 1: Snapshot the active triggers of one world
+    {
+        FTestWorldWrapper WorldWrapper;
+        WorldWrapper.CreateTestWorld(EWorldType::Game);
+        UWorld* World = WorldWrapper.GetTestWorld();
+        if (!World)
+            return false;
+        UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+        if (!TriggerSubsystem)
+        {
+            AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+            return false;
+        }
+
+        UOGGameplayTriggerContext* Context = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        Context->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 42;
+        SavedHandle = TriggerSubsystem->StartTrigger(Context);
+
+        TestTrue(TEXT("Snapshot should succeed"), TriggerSubsystem->SaveActiveTriggers(SnapshotBytes));
+        TestTrue(TEXT("Snapshot should contain data"), SnapshotBytes.Num() > 0);
+    }
+
+    // Test 2: Restore silently into a fresh world, then restore again with a batched TriggerStart pass
+    {
+        FTestWorldWrapper WorldWrapper;
+        WorldWrapper.CreateTestWorld(EWorldType::Game);
+        UWorld* World = WorldWrapper.GetTestWorld();
+        if (!World)
+            return false;
+        UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+        if (!TriggerSubsystem)
+        {
+            AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+            return false;
+        }
+
+        int32 StartCallbackCount = 0;
+        int32 RestoredData = 0;
+        FOGTriggerDelegate StartDelegate;
+        StartDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            StartCallbackCount++;
+            RestoredData = ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt;
+        });
+        FOGTriggerListenerHandle StartHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, StartDelegate);
+
+        TMap<FOGGameplayTriggerHandle, FOGGameplayTriggerHandle> RestoredHandles;
+        TestTrue(TEXT("Silent restore should succeed"), TriggerSubsystem->RestoreActiveTriggers(SnapshotBytes, EOGTriggerRestoreMode::Silent, &RestoredHandles));
+        FOGGameplayTriggerHandle RestoredHandle = RestoredHandles.FindRef(SavedHandle);
+        TestTrue(TEXT("Restored trigger should be active under its new handle"), TriggerSubsystem->IsTriggerActive(RestoredHandle));
+        TestTrue(TEXT("Restored trigger should not reuse the saved handle"), RestoredHandle != SavedHandle);
+        TestEqual(TEXT("Silent restore should not fire TriggerStart"), StartCallbackCount, 0);
+        UOGGameplayTriggerContext* NewContext = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        NewContext->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 7;
+        FOGGameplayTriggerHandle NewHandle = TriggerSubsystem->StartTrigger(NewContext);
+        TestTrue(TEXT("Triggers started after a restore should not replace restored ones"), TriggerSubsystem->IsTriggerActive(RestoredHandle) && TriggerSubsystem->IsTriggerActive(NewHandle));
+        TriggerSubsystem->EndTrigger(NewHandle);
+        StartCallbackCount = 0;
+
+        TriggerSubsystem->EndTrigger(RestoredHandle);
+        int32 TapCount = 0;
+        FOGTriggerTapOptions TapOptions;
+        TapOptions.Phases = EOGTriggerListenerPhases::TriggerStart;
+        FOGTriggerTapHandle TapHandle = TriggerSubsystem->AddTriggerTap(TriggerSubsystem, [&TapCount](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            TapCount++;
+        }, TapOptions);
+        RestoredHandles.Reset();
+        TestTrue(TEXT("Batched restore should succeed"), TriggerSubsystem->RestoreActiveTriggers(SnapshotBytes, EOGTriggerRestoreMode::FireTriggerStart, &RestoredHandles));
+        RestoredHandle = RestoredHandles.FindRef(SavedHandle);
+        TestEqual(TEXT("Batched restore should fire TriggerStart once per trigger"), StartCallbackCount, 1);
+        TestEqual(TEXT("Batched restore should reach the taps like any started trigger"), TapCount, 1);
+        TestEqual(TEXT("Restored trigger should keep its data bank"), RestoredData, 42);
+        TapHandle.Reset();
+
+        TArray<uint8> GarbageBytes = {1, 2, 3, 4};
+        AddExpectedError(TEXT("not a gameplay trigger snapshot"), EAutomationExpectedErrorFlags::Contains, 0);
+        TestFalse(TEXT("Restoring garbage should fail"), TriggerSubsystem->RestoreActiveTriggers(GarbageBytes));
+
+        // The trigger count follows the magic and the version
+        TArray<uint8> CorruptedBytes = SnapshotBytes;
+        const int32 HugeTriggerCount = MAX_int32;
+        FMemory::Memcpy(CorruptedBytes.GetData() + 8, &HugeTriggerCount, sizeof(int32));
+        AddExpectedError(TEXT("snapshot is malformed"), EAutomationExpectedErrorFlags::Contains, 0);
+        TestFalse(TEXT("Restoring a snapshot with a corrupted trigger count should fail"), TriggerSubsystem->RestoreActiveTriggers(CorruptedBytes));
+        TArray<uint8> TruncatedBytes(SnapshotBytes.GetData(), 12);
+        TestFalse(TEXT("Restoring a truncated snapshot should fail"), TriggerSubsystem->RestoreActiveTriggers(TruncatedBytes));
+
+        // Clean up
+        TriggerSubsystem->EndTrigger(RestoredHandle);
+        TriggerSubsystem->RemoveTriggerListener(StartHandle);
+    }
+
+    // Test 3: A timed trigger keeps its remaining duration and update interval across a snapshot
+    FGameplayTag TimedTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1"));
+    TArray<uint8> TimedSnapshotBytes;
+    {
+        FTestWorldWrapper WorldWrapper;
+        WorldWrapper.CreateTestWorld(EWorldType::Game);
+        UWorld* World = WorldWrapper.GetTestWorld();
+        if (!World)
+            return false;
+        UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+        if (!TriggerSubsystem)
+        {
+            AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+            return false;
+        }
+
+        // Ends 0.7s after the snapshot, next update 0.2s after it
+        TriggerSubsystem->StartTimedTriggerImplicitContext(TimedTriggerType, FGameplayTagContainer::EmptyContainer, 1.f, 0.25f);
+        TriggerSubsystem->Tick(0.3f);
+        TestTrue(TEXT("Snapshot with a timed trigger should succeed"), TriggerSubsystem->SaveActiveTriggers(TimedSnapshotBytes));
+    }
+    {
+        FTestWorldWrapper WorldWrapper;
+        WorldWrapper.CreateTestWorld(EWorldType::Game);
+        UWorld* World = WorldWrapper.GetTestWorld();
+        if (!World)
+            return false;
+        UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+        if (!TriggerSubsystem)
+        {
+            AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+            return false;
+        }
+
+        int32 UpdateCount = 0;
+        int32 EndCount = 0;
+        FOGTriggerDelegate TimedDelegate;
+        TimedDelegate.BindLambda([&UpdateCount, &EndCount](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            if (TriggerPhase == EOGTriggerListenerPhases::TriggerUpdate)
+                UpdateCount++;
+            if (TriggerPhase == EOGTriggerListenerPhases::TriggerEnd)
+                EndCount++;
+        });
+        FOGTriggerListenerHandle TimedHandle = TriggerSubsystem->RegisterTriggerListener(TimedTriggerType,
+            EOGTriggerListenerPhases::TriggerUpdate | EOGTriggerListenerPhases::TriggerEnd, TimedDelegate);
+
+        TestTrue(TEXT("Restoring a timed trigger should succeed"), TriggerSubsystem->RestoreActiveTriggers(TimedSnapshotBytes));
+        TestEqual(TEXT("Restored timed trigger should be tracked"), TriggerSubsystem->GetNumTimedTriggers(), 1);
+        TriggerSubsystem->Tick(0.1f);
+        TestEqual(TEXT("No update should fire before the remaining interval"), UpdateCount, 0);
+        TriggerSubsystem->Tick(0.15f);
+        TestEqual(TEXT("Restored trigger should keep updating"), UpdateCount, 1);
+        TriggerSubsystem->Tick(0.3f);
+        TestEqual(TEXT("Restored trigger should not end before its remaining duration"), EndCount, 0);
+        TriggerSubsystem->Tick(0.2f);
+        TestEqual(TEXT("Restored trigger should end after its remaining duration"), EndCount, 1);
+        TestEqual(TEXT("Ended trigger should not be tracked"), TriggerSubsystem->GetNumTimedTriggers(), 0);
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(TimedHandle);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemPriorityTest, "OccamsGamekit.OGGameplayTrigger.ListenerPriority",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemPriorityTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    TArray<int32> CallOrder;
+    bool bShouldConsume = false;
+
+    auto MakeListener = [&](int32 Priority, bool bConsumes)
+    {
+        FOGTriggerDelegate Delegate;
+        Delegate.BindLambda([&CallOrder, &bShouldConsume, TriggerSubsystem, Priority, bConsumes](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            CallOrder.Add(Priority);
+            if (bConsumes && bShouldConsume)
+            {
+                TriggerSubsystem->ConsumeTrigger();
+            }
+        });
+        FOGTriggerListenerOptions Options;
+        Options.Priority = Priority;
+        return TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Delegate, Options);
+    };
+
+    FOGTriggerListenerHandle LowHandle = MakeListener(0, false);
+    FOGTriggerListenerHandle HighHandle = MakeListener(10, true);
+    FOGTriggerListenerHandle MidHandle = MakeListener(5, false);
+
+    // Test 1: Listeners run in descending priority order
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("All listeners should be called"), CallOrder.Num(), 3);
+    if (CallOrder.Num() == 3)
+    {
+        TestEqual(TEXT("Highest priority listener should be called first"), CallOrder[0], 10);
+        TestEqual(TEXT("Middle priority listener should be called second"), CallOrder[1], 5);
+        TestEqual(TEXT("Lowest priority listener should be called last"), CallOrder[2], 0);
+    }
+
+    // Test 2: Consuming the trigger skips every lower priority listener
+    CallOrder.Reset();
+    bShouldConsume = true;
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Only the consuming listener should be called"), CallOrder.Num(), 1);
+
+    // Test 3: Consumption only applies to the trigger that was consumed
+    CallOrder.Reset();
+    bShouldConsume = false;
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("All listeners should be called again"), CallOrder.Num(), 3);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(LowHandle);
+    TriggerSubsystem->RemoveTriggerListener(HighHandle);
+    TriggerSubsystem->RemoveTriggerListener(MidHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemListenerEditsDuringDispatchTest, "OccamsGamekit.OGGameplayTrigger.ListenerEditsDuringDispatch",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemListenerEditsDuringDispatchTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    int32 RemovedCount = 0;
+    int32 AddedCount = 0;
+    FOGTriggerListenerOptions LowPriority;
+    LowPriority.Priority = -1;
+    FOGTriggerListenerHandle RemovedHandle = RegisterCountingListener(*TriggerSubsystem, TestTriggerType, EOGTriggerListenerPhases::TriggerStart, RemovedCount, LowPriority);
+    FOGTriggerListenerHandle AddedHandle;
+
+    // The first listener to run swaps the low priority listener for a new one, from inside the dispatch
+    int32 EditorCount = 0;
+    FOGTriggerDelegate EditorDelegate;
+    EditorDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        if (EditorCount++ > 0)
+            return;
+        TriggerSubsystem->RemoveTriggerListener(RemovedHandle);
+        AddedHandle = RegisterCountingListener(*TriggerSubsystem, TestTriggerType, EOGTriggerListenerPhases::TriggerStart, AddedCount, LowPriority);
+    });
+    FOGTriggerListenerOptions HighPriority;
+    HighPriority.Priority = 1;
+    FOGTriggerListenerHandle EditorHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, EditorDelegate, HighPriority);
+
+    // Test 1: The running dispatch keeps the list it started with
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Listener removed during the dispatch should still be called by it"), RemovedCount, 1);
+    TestEqual(TEXT("Listener added during the dispatch should not be called by it"), AddedCount, 0);
+    TestFalse(TEXT("Removed listener handle should be invalid right away"), TriggerSubsystem->IsListenerHandleValid(RemovedHandle));
+    TestTrue(TEXT("Added listener handle should be valid right away"), TriggerSubsystem->IsListenerHandleValid(AddedHandle));
+
+    // Test 2: The next operation sees the edited list
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Removed listener should not be called again"), RemovedCount, 1);
+    TestEqual(TEXT("Added listener should be called by the next trigger"), AddedCount, 1);
+    TestEqual(TEXT("Editing listener should be called for both triggers"), EditorCount, 2);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(EditorHandle);
+    TriggerSubsystem->RemoveTriggerListener(AddedHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemDeferredTest, "OccamsGamekit.OGGameplayTrigger.DeferredListeners",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemDeferredTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    int32 CriticalCallbackCount = 0;
+    int32 DeferredCallbackCount = 0;
+
+    FOGTriggerDelegate CriticalDelegate;
+    CriticalDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        CriticalCallbackCount++;
+    });
+    FOGTriggerDelegate DeferredDelegate;
+    DeferredDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        DeferredCallbackCount++;
+    });
+
+    FOGTriggerListenerOptions DeferredOptions;
+    DeferredOptions.bDeferrable = true;
+    FOGTriggerListenerHandle CriticalHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, CriticalDelegate);
+    FOGTriggerListenerHandle DeferredHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, DeferredDelegate, DeferredOptions);
+
+    // Test 1: Deferrable callbacks wait for the subsystem tick, critical ones don't
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Critical callback should run synchronously"), CriticalCallbackCount, 1);
+    TestEqual(TEXT("Deferrable callback should not run synchronously"), DeferredCallbackCount, 0);
+    TriggerSubsystem->Tick(0.f);
+    TestEqual(TEXT("Deferrable callback should run in the tick"), DeferredCallbackCount, 1);
+
+    // Test 2: Callbacks over budget spill over into the next tick
+    IConsoleVariable* BudgetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("OG.GameplayTrigger.DeferredCallbackBudgetMs"));
+    const float PreviousBudget = BudgetCVar ? BudgetCVar->GetFloat() : 1.f;
+    if (BudgetCVar)
+    {
+        BudgetCVar->Set(0.f);
+    }
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Two callbacks should be pending"), TriggerSubsystem->GetNumPendingDeferredCallbacks(), 2);
+    TriggerSubsystem->Tick(0.f);
+    TestEqual(TEXT("A zero budget should still run one callback per tick"), DeferredCallbackCount, 2);
+    TriggerSubsystem->Tick(0.f);
+    TestEqual(TEXT("The remaining callback should run on the next tick"), DeferredCallbackCount, 3);
+    if (BudgetCVar)
+    {
+        BudgetCVar->Set(PreviousBudget);
+    }
+
+    // Test 3: Removing the listener drops its pending callbacks
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->RemoveTriggerListener(DeferredHandle);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->Tick(0.f);
+    TestEqual(TEXT("Callbacks for a removed listener should not run"), DeferredCallbackCount, 3);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(CriticalHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemAnyThreadTest, "OccamsGamekit.OGGameplayTrigger.AnyThreadListeners",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemAnyThreadTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    std::atomic<bool> bWorkRanOffGameThread = false;
+    std::atomic<int32> WorkResult = 0;
+    FEvent* WorkDoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
+    int32 PendingResultCount = 0;
+    TOGFuture<int32> PendingResult;
+
+    FOGTriggerListenerHandle Handle = TriggerSubsystem->RegisterAnyThreadTriggerListener<int32>(TestTriggerType, EOGTriggerListenerPhases::TriggerStart,
+        [&](const FOGGameplayTriggerHandle& TriggerHandle, EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* FrozenTrigger)
+        {
+            bWorkRanOffGameThread = !IsInGameThread();
+            WorkResult = FrozenTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt;
+            WorkDoneEvent->Trigger();
+            return WorkResult.load();
+        },
+        [&](const FOGGameplayTriggerHandle& TriggerHandle, TOGFuture<int32> Result)
+        {
+            PendingResultCount++;
+            PendingResult = Result;
+        });
+
+    // Test 1: Work runs off the game thread against a snapshot that later modifications don't affect
+    UOGGameplayTriggerContext* Context = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    Context->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 42;
+    FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTrigger(Context);
+    TestEqual(TEXT("The pending result should be handed out during dispatch"), PendingResultCount, 1);
+
+    // Modify the live context in place, the snapshot should not see this
+    TriggerSubsystem->GetTriggerContextForUpdate(TriggerHandle)->DataBank.GetChecked<FTestTriggerData_Int>().TestInt = 999;
+
+    TestTrue(TEXT("Work should complete"), WorkDoneEvent->Wait(FTimespan::FromSeconds(5)));
+    TestTrue(TEXT("Work should run off the game thread"), bWorkRanOffGameThread.load());
+    TestEqual(TEXT("Work should read the frozen context"), WorkResult.load(), 42);
+
+    // Let the result marshal back to the game thread
+    FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+    // Test 2: AnyThread callbacks bound to a UObject are refused, they would resolve the object off the game thread
+    FOGTriggerListenerOptions AnyThreadOptions;
+    AnyThreadOptions.RunOn = EOGTriggerRunOn::AnyThread;
+    AddExpectedError(TEXT("AnyThread listeners can't be bound to a UObject"), EAutomationExpectedErrorFlags::Contains, 1);
+    FOGTriggerListenerHandle WeakHandle = TriggerSubsystem->RegisterTriggerListener(TriggerSubsystem, TestTriggerType, EOGTriggerListenerPhases::TriggerStart,
+        [](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger) {}, AnyThreadOptions);
+    TestFalse(TEXT("UObject bound AnyThread listener should not be registered"), WeakHandle.IsValid());
+
+    // Clean up
+    FPlatformProcess::ReturnSynchEventToPool(WorkDoneEvent);
+    TriggerSubsystem->EndTrigger(TriggerHandle);
+    TriggerSubsystem->RemoveTriggerListener(Handle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemWaitForTriggerTest, "OccamsGamekit.OGGameplayTrigger.WaitForTrigger",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemWaitForTriggerTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    AActor* TestTarget = World->SpawnActor<AActor>();
+
+    // Test 1: The internal listener removes itself after the first matching trigger
+    {
+        FOGTriggerListenerHandle WaitHandle;
+        TOGFuture<const UOGGameplayTriggerContext*> Future = TriggerSubsystem->WaitForTrigger(TestTriggerType, EOGTriggerListenerPhases::TriggerStart,
+            FOGTriggerListenerOptions(), &WaitHandle);
+        TestTrue(TEXT("Waiting listener should be valid before the trigger"), WaitHandle.IsValid());
+
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        TestFalse(TEXT("Waiting listener should remove itself after firing"), WaitHandle.IsValid());
+    }
+
+    // Test 2: Filters in the options are respected
+    {
+        FOGTriggerListenerOptions Options;
+        Options.FilterTarget = TestTarget;
+        FOGTriggerListenerHandle WaitHandle;
+        TOGFuture<const UOGGameplayTriggerContext*> Future = TriggerSubsystem->WaitForTrigger(TestTriggerType, EOGTriggerListenerPhases::TriggerStart,
+            Options, &WaitHandle);
+
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        TestTrue(TEXT("Waiting listener should ignore triggers that don't pass its filters"), WaitHandle.IsValid());
+
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer, nullptr, TestTarget);
+        TestFalse(TEXT("Waiting listener should fire for a matching trigger"), WaitHandle.IsValid());
+    }
+
+    // Test 3: Existing triggers fulfill the wait immediately
+    {
+        FOGGameplayTriggerHandle ExistingTrigger = TriggerSubsystem->StartTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        FOGTriggerListenerOptions Options;
+        Options.bShouldFireForExistingTriggers = true;
+        FOGTriggerListenerHandle WaitHandle;
+        TOGFuture<const UOGGameplayTriggerContext*> Future = TriggerSubsystem->WaitForTrigger(TestTriggerType, EOGTriggerListenerPhases::TriggerStart,
+            Options, &WaitHandle);
+        TestFalse(TEXT("Waiting listener should be fulfilled by an existing trigger"), WaitHandle.IsValid());
+
+        // Clean up
+        TriggerSubsystem->EndTrigger(ExistingTrigger);
+    }
+
+    // Test 4: Fulfilled awaiters go back to the pool, whether they fired during a dispatch or for an existing trigger, and are reused clean
+    {
+        const FOGTriggerEngine& Engine = TriggerSubsystem->GetEngine();
+        TestEqual(TEXT("Every fulfilled awaiter should have been pooled and reused"), Engine.GetNumPooledAwaiters(), 1);
+
+        FOGTriggerListenerOptions Options;
+        Options.FilterTarget = TestTarget;
+        FOGTriggerListenerHandle WaitHandle;
+        TOGFuture<const UOGGameplayTriggerContext*> Future = TriggerSubsystem->WaitForTrigger(TestTriggerType, EOGTriggerListenerPhases::TriggerStart,
+            Options, &WaitHandle);
+        TestEqual(TEXT("Waiting should take the pooled awaiter"), Engine.GetNumPooledAwaiters(), 0);
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer, nullptr, TestTarget);
+        TestEqual(TEXT("Awaiter fulfilled during a dispatch should be pooled once the dispatch is over"), Engine.GetNumPooledAwaiters(), 1);
+
+        TOGFuture<const UOGGameplayTriggerContext*> UnfilteredFuture = TriggerSubsystem->WaitForTrigger(TestTriggerType, EOGTriggerListenerPhases::TriggerStart,
+            FOGTriggerListenerOptions(), &WaitHandle);
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        TestFalse(TEXT("Reused awaiter should not keep the filters of its previous wait"), WaitHandle.IsValid());
+        TestEqual(TEXT("Reused awaiter should be pooled again"), Engine.GetNumPooledAwaiters(), 1);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemListenerGroupTest, "OccamsGamekit.OGGameplayTrigger.ListenerGroups",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemListenerGroupTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag BasicTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    FGameplayTag NestedTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Nested"));
+    int32 GroupedCallCount = 0;
+    int32 UngroupedCallCount = 0;
+
+    FOGTriggerListenerGroupHandle Group = TriggerSubsystem->CreateListenerGroup();
+    TestTrue(TEXT("New group should be valid"), Group.IsValid());
+
+    FOGTriggerListenerOptions GroupOptions;
+    GroupOptions.Group = Group;
+    TArray<FOGTriggerListenerHandle> GroupedHandles;
+    for (int32 i = 0; i < 3; ++i)
+    {
+        GroupedHandles.Add(TriggerSubsystem->RegisterTriggerListener(World, BasicTriggerType, EOGTriggerListenerPhases::TriggerStart,
+            [&](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) { GroupedCallCount++; }, GroupOptions));
+    }
+    GroupedHandles.Add(TriggerSubsystem->RegisterTriggerListener(World, NestedTriggerType, EOGTriggerListenerPhases::TriggerStart,
+        [&](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) { GroupedCallCount++; }, GroupOptions));
+    FOGTriggerListenerHandle UngroupedHandle = TriggerSubsystem->RegisterTriggerListener(World, BasicTriggerType, EOGTriggerListenerPhases::TriggerStart,
+        [&](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) { UngroupedCallCount++; }, FOGTriggerListenerOptions());
+
+    // Test 1: Grouped listeners behave like any other listener
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(BasicTriggerType, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(NestedTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Every grouped listener should be called"), GroupedCallCount, 4);
+    TestEqual(TEXT("The ungrouped listener should be called"), UngroupedCallCount, 1);
+
+    // Test 2: Removing the group removes all of its listeners across trigger types, and nothing else
+    TriggerSubsystem->RemoveListenerGroup(Group);
+    TestFalse(TEXT("Removed group should be invalid"), Group.IsValid());
+    for (const FOGTriggerListenerHandle& Handle : GroupedHandles)
+    {
+        TestFalse(TEXT("Grouped listeners should be removed with their group"), Handle.IsValid());
+    }
+    TestTrue(TEXT("Ungrouped listener should survive the group removal"), UngroupedHandle.IsValid());
+
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(BasicTriggerType, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(NestedTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Removed grouped listeners should not be called"), GroupedCallCount, 4);
+    TestEqual(TEXT("The ungrouped listener should still be called"), UngroupedCallCount, 2);
+
+    // Test 3: Resetting a group handle removes the group
+    {
+        FOGTriggerListenerGroupHandle ScopedGroup = TriggerSubsystem->CreateListenerGroup();
+        FOGTriggerListenerOptions ScopedOptions;
+        ScopedOptions.Group = ScopedGroup;
+        FOGTriggerListenerHandle ScopedHandle = TriggerSubsystem->RegisterTriggerListener(World, BasicTriggerType, EOGTriggerListenerPhases::TriggerStart,
+            [&](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) { GroupedCallCount++; }, ScopedOptions);
+        ScopedGroup.Reset();
+        TestFalse(TEXT("Listeners should be removed when their group handle is reset"), ScopedHandle.IsValid());
+    }
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(UngroupedHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemOwnerBoundListenerTest, "OccamsGamekit.OGGameplayTrigger.OwnerBoundListeners",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemOwnerBoundListenerTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    WorldWrapper.BeginPlayInTestWorld();
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    FOGTriggerDelegate EmptyDelegate;
+    EmptyDelegate.BindLambda([](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) {});
+
+    // Test 1: Every listener owned by, or filtering on, an actor is removed as soon as it ends play
+    {
+        AActor* OwnerActor = World->SpawnActor<AActor>();
+        FOGTriggerListenerOptions OwnerOptions;
+        OwnerOptions.Owner = OwnerActor;
+        FOGTriggerListenerHandle OwnedHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::All, EmptyDelegate, OwnerOptions);
+        FOGTriggerListenerHandle WeakLambdaHandle = TriggerSubsystem->RegisterTriggerListener(OwnerActor, TestTriggerType, EOGTriggerListenerPhases::All,
+            [](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) {}, FOGTriggerListenerOptions());
+        FOGTriggerListenerOptions TargetOptions;
+        TargetOptions.FilterTarget = OwnerActor;
+        FOGTriggerListenerHandle TargetFilterHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::All, EmptyDelegate, TargetOptions);
+        FOGTriggerListenerHandle UnrelatedHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::All, EmptyDelegate, FOGTriggerListenerOptions());
+
+        OwnerActor->Destroy();
+        TestFalse(TEXT("Listener owned by the actor should be removed when it ends play"), OwnedHandle.IsValid());
+        TestFalse(TEXT("Weak lambda listeners should default to being owned by their context object"), WeakLambdaHandle.IsValid());
+        TestFalse(TEXT("Listener filtering on the actor should be removed when it ends play"), TargetFilterHandle.IsValid());
+        TestTrue(TEXT("Listeners not bound to the actor should remain"), UnrelatedHandle.IsValid());
+
+        // Clean up
+        TriggerSubsystem->RemoveTriggerListener(UnrelatedHandle);
+    }
+
+    // Test 2: Listeners owned by other objects are removed when the owner is garbage collected
+    {
+        UObject* OwnerObject = NewObject<UOGTestTriggerFilter_DataIsPositive>(GetTransientPackage());
+        FOGTriggerListenerOptions OwnerOptions;
+        OwnerOptions.Owner = OwnerObject;
+        FOGTriggerListenerHandle OwnedHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::All, EmptyDelegate, OwnerOptions);
+        TestTrue(TEXT("Listener should be valid while its owner is alive"), OwnedHandle.IsValid());
+
+        OwnerObject->MarkAsGarbage();
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        TestFalse(TEXT("Listener should be removed when its owner is garbage collected"), OwnedHandle.IsValid());
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemListenerSweepTest, "OccamsGamekit.OGGameplayTrigger.ListenerSweep",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemListenerSweepTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    IConsoleVariable* SweepCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("OG.GameplayTrigger.SweepListenersPerFrame"));
+    if (!SweepCVar)
+    {
+        AddError(TEXT("Failed to find OG.GameplayTrigger.SweepListenersPerFrame"));
+        return false;
+    }
+    const int32 PreviousListenersPerFrame = SweepCVar->GetInt();
+    SweepCVar->Set(2);
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    FOGTriggerDelegate EmptyDelegate;
+    EmptyDelegate.BindLambda([](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) {});
+
+    UOGTestTriggerFilter_Stale* StaleFilter = NewObject<UOGTestTriggerFilter_Stale>();
+    TArray<FOGTriggerListenerHandle> StaleHandles;
+    TArray<FOGTriggerListenerHandle> LiveHandles;
+    FOGTriggerListenerOptions StaleOptions;
+    StaleOptions.Filters = {StaleFilter};
+    for (int32 i = 0; i < 3; ++i)
+    {
+        StaleHandles.Add(TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::All, EmptyDelegate, StaleOptions));
+        LiveHandles.Add(TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::All, EmptyDelegate, FOGTriggerListenerOptions()));
+    }
+    StaleFilter->bIsStale = true;
+
+    // Test 1: The sweep removes stale listeners without any trigger being fired, a bounded number of listeners per frame
+    const FOGTriggerSweepStats StatsBefore = TriggerSubsystem->GetSweepStats();
+    TriggerSubsystem->Tick(0.f);
+    TestEqual(TEXT("The sweep should visit at most the configured number of listeners per frame"),
+        TriggerSubsystem->GetSweepStats().NumListenersVisited - StatsBefore.NumListenersVisited, int64(2));
+    for (int32 Frame = 0; Frame < 4; ++Frame)
+    {
+        TriggerSubsystem->Tick(0.f);
+    }
+
+    for (const FOGTriggerListenerHandle& Handle : StaleHandles)
+    {
+        TestFalse(TEXT("Stale listeners should be swept"), Handle.IsValid());
+    }
+    for (const FOGTriggerListenerHandle& Handle : LiveHandles)
+    {
+        TestTrue(TEXT("Live listeners should survive the sweep"), Handle.IsValid());
+    }
+    const FOGTriggerSweepStats& StatsAfter = TriggerSubsystem->GetSweepStats();
+    TestEqual(TEXT("The sweep should report the reclaimed listeners"), StatsAfter.NumListenersReclaimed - StatsBefore.NumListenersReclaimed, int64(3));
+    TestEqual(TEXT("The sweep should report one released filter reference per reclaimed listener, even for a shared filter"), StatsAfter.NumFilterReferencesReleased - StatsBefore.NumFilterReferencesReleased, int64(3));
+
+    // Clean up
+    SweepCVar->Set(PreviousListenersPerFrame);
+    for (const FOGTriggerListenerHandle& Handle : LiveHandles)
+    {
+        TriggerSubsystem->RemoveTriggerListener(Handle);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemTrimTablesTest, "OccamsGamekit.OGGameplayTrigger.TrimTables",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemTrimTablesTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    FOGTriggerDelegate EmptyDelegate;
+    EmptyDelegate.BindLambda([](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) {});
+
+    // Simulate a spike of temporary triggers and listeners
+    TArray<FOGGameplayTriggerHandle> TriggerHandles;
+    TArray<FOGTriggerListenerHandle> ListenerHandles;
+    for (int32 i = 0; i < 50; ++i)
+    {
+        TriggerHandles.Add(TriggerSubsystem->StartTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer));
+        ListenerHandles.Add(TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::All, EmptyDelegate, FOGTriggerListenerOptions()));
+    }
+    TriggerSubsystem->TrimTables();
+    const SIZE_T PeakBytes = TriggerSubsystem->GetMemoryStats().AllocatedBytes;
+
+    // Test 1: High-water marks are kept after the spike is over
+    for (int32 i = 0; i < 50; ++i)
+    {
+        TriggerSubsystem->EndTrigger(TriggerHandles[i]);
+        TriggerSubsystem->RemoveTriggerListener(ListenerHandles[i]);
+    }
+    const FOGTriggerMemoryStats& Stats = TriggerSubsystem->GetMemoryStats();
+    TestEqual(TEXT("No listeners should be left"), Stats.NumListeners, 0);
+    TestEqual(TEXT("No active triggers should be left"), Stats.NumActiveTriggers, 0);
+    TestEqual(TEXT("Peak listeners should be kept"), Stats.PeakListeners, 50);
+    TestEqual(TEXT("Peak active triggers should be kept"), Stats.PeakActiveTriggers, 50);
+
+    // Test 2: Tables are only trimmed once they have stayed idle for a whole trim period
+    TriggerSubsystem->TrimTables();
+    TestEqual(TEXT("Tables that just went idle should not be trimmed yet"), Stats.NumTrimmedTables, 0);
+    TriggerSubsystem->TrimTables();
+    TestEqual(TEXT("Both idle tables should be released"), Stats.NumTrimmedTables, 2);
+    TestTrue(TEXT("Trimming should give memory back"), Stats.AllocatedBytes < PeakBytes);
+    TestEqual(TEXT("Peak allocated size should be kept"), Stats.PeakAllocatedBytes, PeakBytes);
+
+    // Test 3: Released tables are recreated on demand
+    bool bCallbackReceived = false;
+    FOGTriggerListenerHandle Handle = TriggerSubsystem->RegisterTriggerListener(World, TestTriggerType, EOGTriggerListenerPhases::TriggerStart,
+        [&](const FOGGameplayTriggerHandle&, const EOGTriggerListenerPhases&, const UOGGameplayTriggerContext*) { bCallbackReceived = true; }, FOGTriggerListenerOptions());
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestTrue(TEXT("Triggers should work after their tables were trimmed"), bCallbackReceived);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(Handle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemTagSetTest, "OccamsGamekit.OGGameplayTrigger.InternedTagSets",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemTagSetTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    FGameplayTag Tag1 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1"));
+    FGameplayTag Tag2 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+    FGameplayTag ParentTag = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger"));
+
+    // Test 1: Contexts with the same tags share a single interned set, regardless of tag order
+    {
+        FGameplayTagContainer Tags12;
+        Tags12.AddTag(Tag1);
+        Tags12.AddTag(Tag2);
+        FGameplayTagContainer Tags21;
+        Tags21.AddTag(Tag2);
+        Tags21.AddTag(Tag1);
+
+        UOGGameplayTriggerContext* ContextA = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, Tags12);
+        UOGGameplayTriggerContext* ContextB = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, Tags21);
+        TestTrue(TEXT("Contexts with the same tags should share their tag set"), &ContextA->GetTriggerTagSet() == &ContextB->GetTriggerTagSet());
+        TestTrue(TEXT("Interned tags should match the original tags"), ContextA->GetTriggerTags() == Tags12);
+        TestTrue(TEXT("Contexts without tags should use the empty set"), &TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer)->GetTriggerTagSet() == &FOGTriggerTagSet::Empty());
+    }
+
+    // Test 2: Bitset queries match the tag container semantics
+    {
+        FGameplayTagContainer Tags1;
+        Tags1.AddTag(Tag1);
+        FGameplayTagContainer Tags12;
+        Tags12.AddTag(Tag1);
+        Tags12.AddTag(Tag2);
+        FGameplayTagContainer ParentTags;
+        ParentTags.AddTag(ParentTag);
+
+        const FOGTriggerTagSet& Set1 = FOGTriggerTagSet::Intern(Tags1);
+        const FOGTriggerTagSet& Set12 = FOGTriggerTagSet::Intern(Tags12);
+        const FOGTriggerTagSet& ParentSet = FOGTriggerTagSet::Intern(ParentTags);
+
+        TestTrue(TEXT("HasTag should find explicit tags"), Set1.HasTag(Tag1));
+        TestTrue(TEXT("HasTag should find parent tags"), Set1.HasTag(ParentTag));
+        TestFalse(TEXT("HasTagExact should not find parent tags"), Set1.HasTagExact(ParentTag));
+        TestFalse(TEXT("HasTag should not find missing tags"), Set1.HasTag(Tag2));
+        TestTrue(TEXT("HasAll should succeed for a subset"), Set12.HasAll(Set1));
+        TestFalse(TEXT("HasAll should fail for a superset"), Set1.HasAll(Set12));
+        TestTrue(TEXT("HasAll should match parents"), Set1.HasAll(ParentSet));
+        TestFalse(TEXT("Parents should not match children"), ParentSet.HasAny(Set1));
+        TestTrue(TEXT("HasAny should succeed for overlapping sets"), Set1.HasAny(Set12));
+        TestTrue(TEXT("Everything has all of the empty set"), Set1.HasAll(FOGTriggerTagSet::Empty()));
+        TestFalse(TEXT("Nothing has any of the empty set"), Set1.HasAny(FOGTriggerTagSet::Empty()));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemListenerTagRequirementsTest, "OccamsGamekit.OGGameplayTrigger.ListenerTagRequirements",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemListenerTagRequirementsTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    FGameplayTag Tag1 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1"));
+    FGameplayTag Tag2 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+    FGameplayTag ParentTag = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger"));
+
+    int32 RequiresTag1Count = 0;
+    int32 RequiresParentCount = 0;
+    int32 BlocksTag2Count = 0;
+
+    auto MakeListener = [&](int32& Counter, const FGameplayTagContainer& RequiredTags, const FGameplayTagContainer& BlockedTags)
+    {
+        FOGTriggerListenerOptions Options;
+        Options.RequiredTags = RequiredTags;
+        Options.BlockedTags = BlockedTags;
+        return RegisterCountingListener(*TriggerSubsystem, TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Counter, Options);
+    };
+
+    FGameplayTagContainer Tags1(Tag1);
+    FGameplayTagContainer Tags2(Tag2);
+    FGameplayTagContainer Tags12;
+    Tags12.AddTag(Tag1);
+    Tags12.AddTag(Tag2);
+
+    FOGTriggerListenerHandle RequiresTag1Handle = MakeListener(RequiresTag1Count, Tags1, FGameplayTagContainer::EmptyContainer);
+    FOGTriggerListenerHandle RequiresParentHandle = MakeListener(RequiresParentCount, FGameplayTagContainer(ParentTag), FGameplayTagContainer::EmptyContainer);
+    FOGTriggerListenerHandle BlocksTag2Handle = MakeListener(BlocksTag2Count, FGameplayTagContainer::EmptyContainer, Tags2);
+
+    // Test 1: Triggers without tags only reach listeners without requirements
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Listener requiring Tag1 should not be called"), RequiresTag1Count, 0);
+    TestEqual(TEXT("Listener requiring the parent tag should not be called"), RequiresParentCount, 0);
+    TestEqual(TEXT("Listener blocking Tag2 should be called"), BlocksTag2Count, 1);
+
+    // Test 2: Required tags match the trigger's tags and their parents
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, Tags1);
+    TestEqual(TEXT("Listener requiring Tag1 should be called"), RequiresTag1Count, 1);
+    TestEqual(TEXT("Listener requiring the parent tag should be called"), RequiresParentCount, 1);
+    TestEqual(TEXT("Listener blocking Tag2 should be called"), BlocksTag2Count, 2);
+
+    // Test 3: Blocked tags reject the trigger even if the requirements are met
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, Tags12);
+    TestEqual(TEXT("Listener requiring Tag1 should be called"), RequiresTag1Count, 2);
+    TestEqual(TEXT("Listener requiring the parent tag should be called"), RequiresParentCount, 2);
+    TestEqual(TEXT("Listener blocking Tag2 should not be called"), BlocksTag2Count, 2);
+
+    // Test 4: Requirements stay attached to their listener when listeners before it are removed
+    TriggerSubsystem->RemoveTriggerListener(RequiresTag1Handle);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, Tags2);
+    TestEqual(TEXT("Removed listener should not be called"), RequiresTag1Count, 2);
+    TestEqual(TEXT("Listener requiring the parent tag should be called"), RequiresParentCount, 3);
+    TestEqual(TEXT("Listener blocking Tag2 should not be called"), BlocksTag2Count, 2);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(RequiresParentHandle);
+    TriggerSubsystem->RemoveTriggerListener(BlocksTag2Handle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemTimedTriggersTest, "OccamsGamekit.OGGameplayTrigger.TimedTriggers",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemTimedTriggersTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+
+    int32 UpdateCount = 0;
+    int32 EndCount = 0;
+    FOGTriggerDelegate Delegate;
+    Delegate.BindLambda([&UpdateCount, &EndCount](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        if (TriggerPhase == EOGTriggerListenerPhases::TriggerUpdate)
+            UpdateCount++;
+        if (TriggerPhase == EOGTriggerListenerPhases::TriggerEnd)
+            EndCount++;
+    });
+    FOGTriggerListenerHandle ListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType,
+        EOGTriggerListenerPhases::TriggerUpdate | EOGTriggerListenerPhases::TriggerEnd, Delegate);
+
+    // Test 1: Periodic updates fire until the duration runs out, then the trigger ends itself
+    {
+        FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTimedTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer, 1.f, 0.25f);
+        TestEqual(TEXT("Timed trigger should be tracked"), TriggerSubsystem->GetNumTimedTriggers(), 1);
+
+        TriggerSubsystem->Tick(0.2f);
+        TestEqual(TEXT("No update should fire before the interval"), UpdateCount, 0);
+        TriggerSubsystem->Tick(0.1f);
+        TestEqual(TEXT("One update should fire after the interval"), UpdateCount, 1);
+        TriggerSubsystem->Tick(0.5f);
+        TestEqual(TEXT("A long frame should only fire one update"), UpdateCount, 2);
+        TriggerSubsystem->Tick(0.1f);
+        TestEqual(TEXT("The overdue update should fire on the next frame"), UpdateCount, 3);
+        TestTrue(TEXT("Trigger should still be active before the duration"), TriggerSubsystem->IsTriggerActive(TriggerHandle));
+
+        TriggerSubsystem->Tick(0.2f);
+        TestFalse(TEXT("Trigger should end after the duration"), TriggerSubsystem->IsTriggerActive(TriggerHandle));
+        TestEqual(TEXT("TriggerEnd should fire once"), EndCount, 1);
+        TestEqual(TEXT("Ended trigger should not be tracked"), TriggerSubsystem->GetNumTimedTriggers(), 0);
+    }
+
+    // Test 2: Ending a timed trigger early cancels its timers
+    {
+        UpdateCount = 0;
+        EndCount = 0;
+        FOGGameplayTriggerHandle TriggerHandle = TriggerSubsystem->StartTimedTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer, 1.f, 0.1f);
+        TriggerSubsystem->EndTrigger(TriggerHandle);
+        TestEqual(TEXT("Ended trigger should not be tracked"), TriggerSubsystem->GetNumTimedTriggers(), 0);
+        TriggerSubsystem->Tick(2.f);
+        TestEqual(TEXT("Cancelled trigger should not update"), UpdateCount, 0);
+        TestEqual(TEXT("Cancelled trigger should only end once"), EndCount, 1);
+    }
+
+    // Test 3: Many triggers with spread out durations all expire on time, including ones past the first wheel level
+    {
+        EndCount = 0;
+        constexpr int32 NumTriggers = 1000;
+        for (int32 i = 0; i < NumTriggers; ++i)
+        {
+            FOGTriggerStartOptions Options;
+            Options.Duration = 0.05f + i * 0.01f;
+            TriggerSubsystem->StartTrigger(TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer), Options);
+        }
+        TriggerSubsystem->Tick(5.005f);
+        TestEqual(TEXT("Triggers due by now should have ended"), EndCount, 496);
+        TriggerSubsystem->Tick(5.1f);
+        TestEqual(TEXT("Every trigger should have ended"), EndCount, NumTriggers);
+        TestEqual(TEXT("No timed triggers should be left"), TriggerSubsystem->GetNumTimedTriggers(), 0);
+    }
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(ListenerHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemRateLimitTest, "OccamsGamekit.OGGameplayTrigger.RateLimitedListeners",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemRateLimitTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+
+    int32 IntervalCount = 0;
+    int32 PerFrameCount = 0;
+    int32 FilterCount = 0;
+
+    auto MakeListener = [&](int32& Counter, float MinInterval, int32 MaxPerFrame, UOGGameplayTriggerFilter* Filter)
+    {
+        FOGTriggerListenerOptions Options;
+        Options.MinInterval = MinInterval;
+        Options.MaxPerFrame = MaxPerFrame;
+        if (Filter)
+        {
+            Options.Filters.Add(Filter);
+        }
+        return RegisterCountingListener(*TriggerSubsystem, TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Counter, Options);
+    };
+
+    UOGTestTriggerFilter_Counting* CountingFilter = NewObject<UOGTestTriggerFilter_Counting>();
+    CountingFilter->Counter = &FilterCount;
+
+    FOGTriggerListenerHandle IntervalHandle = MakeListener(IntervalCount, 0.5f, 0, CountingFilter);
+    FOGTriggerListenerHandle PerFrameHandle = MakeListener(PerFrameCount, 0.f, 2, nullptr);
+
+    // Test 1: Listeners are throttled within a frame, and throttled triggers never reach the filters
+    for (int32 i = 0; i < 4; ++i)
+    {
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    }
+    TestEqual(TEXT("MinInterval listener should be called once"), IntervalCount, 1);
+    TestEqual(TEXT("Filter of the throttled listener should only run for the call that passed"), FilterCount, 1);
+    TestEqual(TEXT("MaxPerFrame listener should be called twice"), PerFrameCount, 2);
+
+    // Test 2: The interval listener fires again once the engine has ticked past the interval
+    TriggerSubsystem->Tick(0.25f);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("MinInterval listener should still be throttled"), IntervalCount, 1);
+    TriggerSubsystem->Tick(0.5f);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("MinInterval listener should be called after the interval"), IntervalCount, 2);
+
+    // Test 3: The per frame budget resets on every engine tick
+    TestEqual(TEXT("MaxPerFrame listener should be called once per ticked frame"), PerFrameCount, 4);
+    TriggerSubsystem->Tick(0.f);
+    for (int32 i = 0; i < 3; ++i)
+    {
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    }
+    TestEqual(TEXT("MaxPerFrame listener should get its full budget on a new frame"), PerFrameCount, 6);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(IntervalHandle);
+    TriggerSubsystem->RemoveTriggerListener(PerFrameHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemCoalescingTest, "OccamsGamekit.OGGameplayTrigger.CoalescedTriggers",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemCoalescingTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    UObject* TargetA = NewObject<UOGTestTriggerFilter_DataIsPositive>();
+    UObject* TargetB = NewObject<UOGTestTriggerFilter_DataIsPositive>();
+
+    TArray<TPair<const UObject*, int32>> Calls;
+    FOGTriggerDelegate Delegate;
+    Delegate.BindLambda([&Calls](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        Calls.Emplace(ActiveTrigger->TargetObject.Get(), ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt);
+    });
+    FOGTriggerListenerHandle ListenerHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Delegate);
+
+    TriggerSubsystem->RegisterTriggerCoalescing(TestTriggerType, FOGTriggerMergeDelegate::CreateLambda(
+        [](UOGGameplayTriggerContext* MergedTrigger, const UOGGameplayTriggerContext* IncomingTrigger)
+        {
+            MergedTrigger->DataBank.GetChecked<FTestTriggerData_Int>().TestInt += IncomingTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt;
+        }));
+
+    auto FireHit = [&](UObject* Target, int32 Damage)
+    {
+        UOGGameplayTriggerContext* Context = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer, nullptr, Target);
+        Context->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = Damage;
+        return TriggerSubsystem->InstantaneousTrigger(Context);
+    };
+
+    // Test 1: Triggers with the same key are merged into one dispatch at the end of the frame
+    {
+        FOGGameplayTriggerHandle FirstHandle = FireHit(TargetA, 10);
+        FOGGameplayTriggerHandle SecondHandle = FireHit(TargetA, 5);
+        FireHit(TargetB, 7);
+        FireHit(TargetA, 1);
+        TestEqual(TEXT("Coalesced triggers should not dispatch immediately"), Calls.Num(), 0);
+        TestEqual(TEXT("One trigger should be pending per key"), TriggerSubsystem->GetNumPendingCoalescedTriggers(), 2);
+        TestTrue(TEXT("Merged triggers should share a handle"), FirstHandle == SecondHandle);
+
+        TriggerSubsystem->Tick(0.f);
+        TestEqual(TEXT("One dispatch per key"), Calls.Num(), 2);
+        if (Calls.Num() == 2)
+        {
+            TestTrue(TEXT("Keys should dispatch in the order they were first seen"), Calls[0].Key == TargetA && Calls[1].Key == TargetB);
+            TestEqual(TEXT("Merge hook should sum the data"), Calls[0].Value, 16);
+            TestEqual(TEXT("Unmerged trigger should keep its data"), Calls[1].Value, 7);
+        }
+        TestEqual(TEXT("Nothing should be pending after the flush"), TriggerSubsystem->GetNumPendingCoalescedTriggers(), 0);
+    }
+
+    // Test 2: Unregistering flushes pending triggers and later triggers dispatch immediately
+    {
+        Calls.Reset();
+        FireHit(TargetA, 3);
+        TriggerSubsystem->UnregisterTriggerCoalescing(TestTriggerType);
+        TestEqual(TEXT("Pending trigger should be flushed on unregister"), Calls.Num(), 1);
+        FireHit(TargetA, 4);
+        TestEqual(TEXT("Triggers should dispatch immediately once coalescing is off"), Calls.Num(), 2);
+    }
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(ListenerHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemSpatialListenersTest, "OccamsGamekit.OGGameplayTrigger.SpatialListeners",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemSpatialListenersTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+
+    AActor* TrackedActor = World->SpawnActor<AActor>();
+    USceneComponent* Root = NewObject<USceneComponent>(TrackedActor);
+    TrackedActor->SetRootComponent(Root);
+    Root->RegisterComponent();
+    TrackedActor->SetActorLocation(FVector(5000.f, 0.f, 0.f));
+
+    int32 NearCount = 0;
+    int32 FarCount = 0;
+    int32 HearingCount = 0;
+    int32 TrackedCount = 0;
+    int32 GlobalCount = 0;
+
+    auto MakeListener = [&](int32& Counter, TOptional<FVector> Location, const AActor* Actor, float Radius)
+    {
+        FOGTriggerListenerOptions Options;
+        Options.Location = Location;
+        Options.TrackedActor = Actor;
+        Options.Radius = Radius;
+        return RegisterCountingListener(*TriggerSubsystem, TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Counter, Options);
+    };
+
+    TArray<FOGTriggerListenerHandle> Handles;
+    Handles.Add(MakeListener(NearCount, FVector(100.f, 0.f, 0.f), nullptr, 0.f));
+    Handles.Add(MakeListener(FarCount, FVector(-20000.f, 0.f, 0.f), nullptr, 0.f));
+    Handles.Add(MakeListener(HearingCount, FVector(0.f, 800.f, 0.f), nullptr, 500.f));
+    Handles.Add(MakeListener(TrackedCount, TOptional<FVector>(), TrackedActor, 0.f));
+    Handles.Add(MakeListener(GlobalCount, TOptional<FVector>(), nullptr, 0.f));
+
+    auto FireAt = [&](const FVector& Location, float Radius)
+    {
+        UOGGameplayTriggerContext* Context = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+        Context->SetLocation(Location, Radius);
+        TriggerSubsystem->InstantaneousTrigger(Context);
+    };
+
+    // Test 1: Located triggers only reach spatial listeners in range, listeners without a location get everything
+    FireAt(FVector::ZeroVector, 400.f);
+    TestEqual(TEXT("Listener inside the radius should be called"), NearCount, 1);
+    TestEqual(TEXT("Far listener should not be called"), FarCount, 0);
+    TestEqual(TEXT("Listener radius should extend the reach"), HearingCount, 1);
+    TestEqual(TEXT("Tracked listener away from the trigger should not be called"), TrackedCount, 0);
+    TestEqual(TEXT("Listener without a location should be called"), GlobalCount, 1);
+
+    // Test 2: Triggers without a location reach every listener
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Spatial listeners should receive unlocated triggers"), NearCount + FarCount + HearingCount + TrackedCount, 6);
+
+    // Test 3: Tracked listeners follow their actor once the subsystem ticks
+    TrackedActor->SetActorLocation(FVector(0.f, 0.f, 100.f));
+    FireAt(FVector::ZeroVector, 400.f);
+    TestEqual(TEXT("Tracked listener should not move before the tick"), TrackedCount, 1);
+    TriggerSubsystem->Tick(0.f);
+    FireAt(FVector::ZeroVector, 400.f);
+    TestEqual(TEXT("Tracked listener should be called at its new location"), TrackedCount, 2);
+
+    // Test 4: Removed spatial listeners leave the grid
+    TriggerSubsystem->RemoveTriggerListener(Handles[0]);
+    FireAt(FVector::ZeroVector, 400.f);
+    TestEqual(TEXT("Removed listener should not be called"), NearCount, 4);
+    TestEqual(TEXT("Remaining listeners should keep their position in the list"), TrackedCount, 3);
+
+    // Test 5: Changing the cell size doesn't move listeners that are already in a grid
+    IConsoleVariable* CellSizeVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("OG.GameplayTrigger.SpatialCellSize"));
+    const float PreviousCellSize = CellSizeVariable->GetFloat();
+    int32 MovedCount = 0;
+    FOGTriggerListenerOptions MovedOptions;
+    MovedOptions.Location = FVector(2500.f, 2500.f, 0.f);
+    FOGTriggerListenerHandle MovedHandle = RegisterCountingListener(*TriggerSubsystem, TestTriggerType, EOGTriggerListenerPhases::TriggerStart, MovedCount, MovedOptions);
+    CellSizeVariable->Set(10.f);
+    TriggerSubsystem->RemoveTriggerListener(MovedHandle);
+    FireAt(FVector(0.f, 1200.f, 0.f), 0.f);
+    TestEqual(TEXT("Listeners added before the cell size changed should still be found"), HearingCount, 6);
+    CellSizeVariable->Set(PreviousCellSize);
+    FireAt(FVector(2500.f, 2500.f, 0.f), 100.f);
+    TestEqual(TEXT("Listener removed while the cell size was different should have left the grid"), MovedCount, 0);
+
+    // Test 6: Tracked listeners leave the grid when their actor is garbage collected
+    AActor* CollectedActor = World->SpawnActor<AActor>();
+    int32 CollectedCount = 0;
+    FOGTriggerListenerHandle CollectedHandle = MakeListener(CollectedCount, TOptional<FVector>(), CollectedActor, 0.f);
+    TestEqual(TEXT("Both tracked listeners should be in the grid"), TriggerSubsystem->GetNumTrackedListeners(), 2);
+    CollectedActor->MarkAsGarbage();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    TestFalse(TEXT("Listener tracking a collected actor should be removed"), CollectedHandle.IsValid());
+    TestEqual(TEXT("Listener tracking a collected actor should leave the grid"), TriggerSubsystem->GetNumTrackedListeners(), 1);
+    TriggerSubsystem->Tick(0.f);
+    FireAt(FVector::ZeroVector, 400.f);
+    TestEqual(TEXT("Remaining tracked listener should still follow its actor"), TrackedCount, 4);
+
+    // Test 7: Spatial listeners are still found when a listener added during dispatch shifts the list
+    int32 AddedCount = 0;
+    bool bHasAddedListener = false;
+    FOGTriggerListenerHandle AddedHandle;
+    FOGTriggerDelegate AddingDelegate;
+    AddingDelegate.BindLambda([&](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        if (bHasAddedListener)
+            return;
+        bHasAddedListener = true;
+        FOGTriggerListenerOptions AddedOptions;
+        AddedOptions.Priority = 200;
+        AddedOptions.Location = FVector::ZeroVector;
+        AddedHandle = RegisterCountingListener(*TriggerSubsystem, TestTriggerType, EOGTriggerListenerPhases::TriggerStart, AddedCount, AddedOptions);
+        FireAt(FVector::ZeroVector, 400.f);
+    });
+    FOGTriggerListenerOptions AddingOptions;
+    AddingOptions.Priority = 100;
+    FOGTriggerListenerHandle AddingHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, AddingDelegate, AddingOptions);
+    const int32 HearingCountBefore = HearingCount;
+    const int32 TrackedCountBefore = TrackedCount;
+    FireAt(FVector::ZeroVector, 400.f);
+    TestEqual(TEXT("Spatial listener should receive the trigger being dispatched and the one fired from it"), HearingCount - HearingCountBefore, 2);
+    TestEqual(TEXT("Tracked listener should receive the trigger being dispatched and the one fired from it"), TrackedCount - TrackedCountBefore, 2);
+    TestEqual(TEXT("Listener added during dispatch should only receive the trigger fired after it"), AddedCount, 1);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(AddingHandle);
+    TriggerSubsystem->RemoveTriggerListener(AddedHandle);
+    for (const FOGTriggerListenerHandle& Handle : Handles)
+    {
+        TriggerSubsystem->RemoveTriggerListener(Handle);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemHeadlessEngineTest, "OccamsGamekit.OGGameplayTrigger.HeadlessEngine",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemHeadlessEngineTest::RunTest(const FString& Parameters)
+{
+    // No world, the engines are driven directly
+    FOGTriggerEngine EngineA;
+    FOGTriggerEngine EngineB;
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+
+    int32 CountA = 0;
+    int32 CountB = 0;
+    const FOGTriggerListenerHandle HandleA = RegisterCountingListener(EngineA, TestTriggerType, EOGTriggerListenerPhases::All, CountA);
+    const FOGTriggerListenerHandle HandleB = RegisterCountingListener(EngineB, TestTriggerType, EOGTriggerListenerPhases::All, CountB);
+
+    // Test 1: Dispatch works without a world or subsystem
+    EngineA.InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Headless engine should dispatch to its listeners"), CountA, 1);
+    TestTrue(TEXT("Headless engine should know its listener"), EngineA.IsListenerHandleValid(HandleA));
+
+    // Test 2: Engines side by side don't share listeners or triggers
+    TestEqual(TEXT("Other engine should not receive the trigger"), CountB, 0);
+    TestFalse(TEXT("Other engine should not know the listener"), EngineB.IsListenerHandleValid(HandleA));
+    const FOGGameplayTriggerHandle TriggerB = EngineB.StartTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    TestTrue(TEXT("Trigger should be active in the engine that started it"), EngineB.IsTriggerActive(TriggerB));
+    TestFalse(TEXT("Trigger should not be active in the other engine"), EngineA.IsTriggerActive(TriggerB));
+
+    // Test 3: Timed triggers advance with the engine's own tick
+    const FOGGameplayTriggerHandle TimedA = EngineA.StartTimedTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer, 1.f);
+    EngineA.Tick(0.5f);
+    TestTrue(TEXT("Timed trigger should still be active"), EngineA.IsTriggerActive(TimedA));
+    EngineA.Tick(0.6f);
+    TestFalse(TEXT("Timed trigger should end after its duration"), EngineA.IsTriggerActive(TimedA));
+    TestEqual(TEXT("Timed trigger should start and end"), CountA, 3);
+
+    // Test 4: Handles from a headless engine have no subsystem, calls go through the engine
+    EngineB.EndTrigger(TriggerB);
+    TestFalse(TEXT("Trigger should end through its engine"), EngineB.IsTriggerActive(TriggerB));
+    EngineA.RemoveTriggerListener(HandleA);
+    TestFalse(TEXT("Listener should be removed through its engine"), EngineA.IsListenerHandleValid(HandleA));
+    TestTrue(TEXT("Removing a listener should not affect the other engine"), EngineB.IsListenerHandleValid(HandleB));
+
+    // Clean up
+    EngineA.Reset();
+    EngineB.Reset();
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemTypedTriggerTest, "OccamsGamekit.OGGameplayTrigger.TypedTriggers",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemTypedTriggerTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    typedef TOGTypedTrigger<FTestTriggerPayload_Damage> FDamageTrigger;
+
+    AActor* TargetActor = World->SpawnActor<AActor>();
+    int32 CallCount = 0;
+    float TotalDamage = 0.f;
+    const UObject* ReceivedTarget = nullptr;
+    FOGTriggerListenerHandle Handle = FDamageTrigger::Listen(*TriggerSubsystem, TargetActor, EOGTriggerListenerPhases::TriggerStart,
+        [&](const FTestTriggerPayload_Damage& Damage, const UOGGameplayTriggerContext* Trigger)
+        {
+            CallCount++;
+            TotalDamage += Damage.Amount;
+            ReceivedTarget = Trigger->TargetObject;
+        });
+
+    // Test 1: Typed fire reaches typed listeners with the payload
+    FTestTriggerPayload_Damage Damage;
+    Damage.Amount = 25.f;
+    FDamageTrigger::Fire(*TriggerSubsystem, Damage, nullptr, TargetActor);
+    TestEqual(TEXT("Typed listener should be called"), CallCount, 1);
+    TestEqual(TEXT("Typed listener should receive the payload"), TotalDamage, 25.f);
+    TestEqual(TEXT("Typed listener should receive the context"), ReceivedTarget, static_cast<const UObject*>(TargetActor));
+
+    // Test 2: The payload is in the data bank, so untyped listeners see it as well
+    float UntypedDamage = 0.f;
+    FOGTriggerListenerHandle UntypedHandle = TriggerSubsystem->RegisterTriggerListener(TargetActor, FDamageTrigger::GetTriggerType(), EOGTriggerListenerPhases::TriggerStart,
+        [&UntypedDamage](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+        {
+            if (const FTestTriggerPayload_Damage* Payload = ActiveTrigger->DataBank.FindConst<FTestTriggerPayload_Damage>())
+            {
+                UntypedDamage += Payload->Amount;
+            }
+        });
+    Damage.Amount = 10.f;
+    FDamageTrigger::Fire(*TriggerSubsystem, Damage);
+    TestEqual(TEXT("Untyped listener should find the payload in the data bank"), UntypedDamage, 10.f);
+    TestEqual(TEXT("Typed listener should be called again"), TotalDamage, 35.f);
+
+    // Test 3: Untyped triggers of the type are only delivered to typed listeners if they carry the payload
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(FDamageTrigger::GetTriggerType(), FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Trigger without payload should be skipped"), CallCount, 2);
+    UOGGameplayTriggerContext* Context = TriggerSubsystem->MakeGameplayTriggerContext(FDamageTrigger::GetTriggerType(), FGameplayTagContainer::EmptyContainer);
+    Context->DataBank.AddUnique<FTestTriggerPayload_Damage>().Amount = 5.f;
+    TriggerSubsystem->InstantaneousTrigger(Context);
+    TestEqual(TEXT("Payload added through the data bank should be found"), TotalDamage, 40.f);
+
+    // Test 4: Payload changes made for an update reach typed listeners
+    Damage.Amount = 1.f;
+    int32 UpdateCount = 0;
+    float UpdatedDamage = 0.f;
+    FOGTriggerListenerHandle UpdateHandle = FDamageTrigger::Listen(*TriggerSubsystem, TargetActor, EOGTriggerListenerPhases::TriggerUpdate,
+        [&](const FTestTriggerPayload_Damage& Payload, const UOGGameplayTriggerContext* Trigger)
+        {
+            UpdateCount++;
+            UpdatedDamage = Payload.Amount;
+        });
+    const FOGGameplayTriggerHandle PersistentHandle = FDamageTrigger::Start(*TriggerSubsystem, Damage);
+    UOGGameplayTriggerContext* UpdateContext = TriggerSubsystem->GetTriggerContextForUpdate(PersistentHandle);
+    UpdateContext->DataBank.GetChecked<FTestTriggerPayload_Damage>().Amount = 2.f;
+    TriggerSubsystem->UpdateTrigger(PersistentHandle, UpdateContext);
+    TestEqual(TEXT("Update should reach the typed listener"), UpdateCount, 1);
+    TestEqual(TEXT("Update should carry the modified payload"), UpdatedDamage, 2.f);
+    TriggerSubsystem->EndTrigger(PersistentHandle);
+
+    // Test 5: Data added to the bank after the payload doesn't lose it
+    Damage.Amount = 3.f;
+    UOGGameplayTriggerContext* GrownContext = FDamageTrigger::MakeContext(*TriggerSubsystem, Damage);
+    GrownContext->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 1;
+    TriggerSubsystem->InstantaneousTrigger(GrownContext);
+    TestEqual(TEXT("Typed listener should find the payload after the data bank grew"), TotalDamage, 44.f);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(Handle);
+    TriggerSubsystem->RemoveTriggerListener(UntypedHandle);
+    TriggerSubsystem->RemoveTriggerListener(UpdateHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemLazyTriggerTest, "OccamsGamekit.OGGameplayTrigger.LazyTriggers",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemLazyTriggerTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+    int32 BuildCount = 0;
+    auto BuildContext = [&BuildCount](UOGGameplayTriggerContext& Context)
+    {
+        BuildCount++;
+        Context.DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 7;
+    };
+
+    // Test 1: Nothing is built while nobody listens
+    TestFalse(TEXT("Type without listeners should report none"), TriggerSubsystem->HasListeners(TestTriggerType));
+    FOGGameplayTriggerHandle Handle = TriggerSubsystem->FireLazy(TestTriggerType, BuildContext);
+    TestEqual(TEXT("Builder should not run without listeners"), BuildCount, 0);
+    TestFalse(TEXT("Skipped trigger should return an invalid handle"), Handle.IsValid());
+
+    // Test 2: Listeners of other phases don't count
+    FOGTriggerDelegate EmptyDelegate;
+    EmptyDelegate.BindLambda([](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger) {});
+    FOGTriggerListenerHandle UpdateHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerUpdate, EmptyDelegate);
+    TestTrue(TEXT("Update listener should be reported"), TriggerSubsystem->HasListeners(TestTriggerType, EOGTriggerListenerPhases::TriggerUpdate));
+    TestFalse(TEXT("Update listener should not count for start"), TriggerSubsystem->HasListeners(TestTriggerType, EOGTriggerListenerPhases::TriggerStart));
+    TriggerSubsystem->FireLazy(TestTriggerType, BuildContext);
+    TestEqual(TEXT("Builder should not run for listeners that can't receive instantaneous triggers"), BuildCount, 0);
+
+    // Test 3: The builder runs once a listener could receive the trigger, and the listener sees what it built
+    int32 ReceivedData = 0;
+    FOGTriggerDelegate Delegate;
+    Delegate.BindLambda([&ReceivedData](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        ReceivedData = ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt;
+    });
+    FOGTriggerListenerHandle StartHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Delegate);
+    Handle = TriggerSubsystem->FireLazy(TestTriggerType, BuildContext);
+    TestEqual(TEXT("Builder should run once"), BuildCount, 1);
+    TestEqual(TEXT("Listener should receive the built context"), ReceivedData, 7);
+    TestTrue(TEXT("Fired trigger should return a valid handle"), Handle.IsValid());
+
+    // Test 4: Removing the last listener of a phase clears it
+    TriggerSubsystem->RemoveTriggerListener(StartHandle);
+    TestFalse(TEXT("Removed listener should no longer be reported"), TriggerSubsystem->HasListeners(TestTriggerType, EOGTriggerListenerPhases::TriggerStart));
+    TestTrue(TEXT("Remaining listener should still be reported"), TriggerSubsystem->HasListeners(TestTriggerType));
+
+    // Test 5: A tap alone is enough for the trigger to be built
+    TriggerSubsystem->RemoveTriggerListener(UpdateHandle);
+    TestFalse(TEXT("Type without listeners should report none"), TriggerSubsystem->HasListeners(TestTriggerType));
+    int32 TapCount = 0;
+    FOGTriggerTapHandle TapHandle = TriggerSubsystem->AddTriggerTap(TriggerSubsystem, [&TapCount](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        TapCount++;
+    });
+    TestTrue(TEXT("A tap should count as a listener of every type"), TriggerSubsystem->HasListeners(TestTriggerType, EOGTriggerListenerPhases::TriggerStart));
+    BuildCount = 0;
+    Handle = TriggerSubsystem->FireLazy(TestTriggerType, BuildContext);
+    TestEqual(TEXT("Builder should run for a tap"), BuildCount, 1);
+    TestTrue(TEXT("Tap should receive the lazy trigger"), TapCount > 0);
+    TestTrue(TEXT("Fired trigger should return a valid handle"), Handle.IsValid());
+    TriggerSubsystem->RemoveTriggerTap(TapHandle);
+    TestFalse(TEXT("Removing the tap should clear it"), TriggerSubsystem->HasListeners(TestTriggerType));
+
+    // Test 6: Aggregate views and histories are remembered on the type, and survive trimming its empty listener table
+    FOGTriggerAggregateViewOptions ViewOptions;
+    ViewOptions.TriggerType = TestTriggerType;
+    FOGTriggerAggregateViewHandle ViewHandle = TriggerSubsystem->CreateAggregateView(ViewOptions);
+    TriggerSubsystem->TrimTables();
+    TriggerSubsystem->TrimTables();
+    TestTrue(TEXT("An aggregate view should count as a listener"), TriggerSubsystem->HasListeners(TestTriggerType));
+    TriggerSubsystem->RemoveAggregateView(ViewHandle);
+    TestFalse(TEXT("Removing the view should clear it"), TriggerSubsystem->HasListeners(TestTriggerType));
+    TriggerSubsystem->EnableTriggerHistory(TestTriggerType, 4);
+    TestFalse(TEXT("A history should not count as a listener"), TriggerSubsystem->HasListeners(TestTriggerType));
+    BuildCount = 0;
+    TriggerSubsystem->FireLazy(TestTriggerType, BuildContext);
+    TestEqual(TEXT("Builder should run for a type that keeps a history"), BuildCount, 1);
+    TriggerSubsystem->DisableTriggerHistory(TestTriggerType);
+    TriggerSubsystem->FireLazy(TestTriggerType, BuildContext);
+    TestEqual(TEXT("Builder should not run once the history is gone"), BuildCount, 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemHistoryTest, "OccamsGamekit.OGGameplayTrigger.TriggerHistory",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemHistoryTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+    TriggerSubsystem->EnableTriggerHistory(TestTriggerType, 3);
+
+    // Test 1: Nobody listens, but the history still records, and the ring keeps only the newest triggers.
+    // The same context is fired every time, the history keeps its own copy
+    UOGGameplayTriggerContext* Context = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer);
+    double FourthTriggerTime = 0.0;
+    for (int32 i = 1; i <= 5; ++i)
+    {
+        if (i == 4)
+        {
+            FourthTriggerTime = TriggerSubsystem->GetEngineTime();
+        }
+        Context->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = i;
+        TriggerSubsystem->InstantaneousTrigger(Context);
+        TriggerSubsystem->Tick(1.f);
+    }
+    TestEqual(TEXT("History should be bounded by its capacity"), TriggerSubsystem->GetNumTriggersInHistory(TestTriggerType), 3);
+
+    TArray<int32> Received;
+    FOGTriggerDelegate Delegate;
+    Delegate.BindLambda([&Received](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        Received.Add(ActiveTrigger->DataBank.GetConstChecked<FTestTriggerData_Int>().TestInt);
+    });
+
+    // Test 2: Late listeners replay the history oldest first
+    FOGTriggerListenerOptions Options;
+    Options.ReplayHistorySince = 0.0;
+    FOGTriggerListenerHandle AllHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Delegate, Options);
+    TestEqual(TEXT("Replay should deliver the triggers kept in history, oldest first"), Received, TArray<int32>({3, 4, 5}));
+
+    // Test 3: Replay only goes back to the requested time
+    Received.Reset();
+    Options.ReplayHistorySince = FourthTriggerTime;
+    FOGTriggerListenerHandle RecentHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Delegate, Options);
+    TestEqual(TEXT("Replay should skip triggers older than the requested time"), Received, TArray<int32>({4, 5}));
+
+    // Test 4: Listeners without the option don't replay
+    Received.Reset();
+    FOGTriggerListenerHandle PlainHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Delegate);
+    TestEqual(TEXT("Listener without replay should not receive history"), Received.Num(), 0);
+
+    // Test 5: Shrinking the history keeps the newest triggers, lazy triggers are built for the history even without listeners
+    TriggerSubsystem->RemoveTriggerListener(AllHandle);
+    TriggerSubsystem->RemoveTriggerListener(RecentHandle);
+    TriggerSubsystem->RemoveTriggerListener(PlainHandle);
+    TriggerSubsystem->EnableTriggerHistory(TestTriggerType, 2);
+    TestEqual(TEXT("Shrunk history should keep its capacity"), TriggerSubsystem->GetNumTriggersInHistory(TestTriggerType), 2);
+    TriggerSubsystem->FireLazy(TestTriggerType, [](UOGGameplayTriggerContext& LazyContext)
+    {
+        LazyContext.DataBank.AddUnique<FTestTriggerData_Int>().TestInt = 6;
+    });
+    Received.Reset();
+    Options.ReplayHistorySince = 0.0;
+    FOGTriggerListenerHandle ShrunkHandle = TriggerSubsystem->RegisterTriggerListener(TestTriggerType, EOGTriggerListenerPhases::TriggerStart, Delegate, Options);
+    TestEqual(TEXT("History should hold the newest triggers"), Received, TArray<int32>({5, 6}));
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerListener(ShrunkHandle);
+    TriggerSubsystem->DisableTriggerHistory(TestTriggerType);
+    TestEqual(TEXT("Disabled history should be released"), TriggerSubsystem->GetNumTriggersInHistory(TestTriggerType), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemMultiTypeListenerTest, "OccamsGamekit.OGGameplayTrigger.MultiTypeListeners",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemMultiTypeListenerTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag Tag1 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1"));
+    FGameplayTag Tag2 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+    FGameplayTag OtherTag = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    FGameplayTagContainer TriggerTypes;
+    TriggerTypes.AddTag(Tag1);
+    TriggerTypes.AddTag(Tag2);
+
+    TArray<FGameplayTag> ReceivedTypes;
+    FOGTriggerDelegate Delegate;
+    Delegate.BindLambda([&ReceivedTypes](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        ReceivedTypes.Add(ActiveTrigger->TriggerType);
+    });
+
+    // Test 1: A single registration fires for every type in the set, and only for those
+    const int32 NumListenersBefore = TriggerSubsystem->GetMemoryStats().NumListeners;
+    bool bWasRemoved = false;
+    TOGFuture<void> WhenListenerRemoved;
+    FOGTriggerListenerOptions Options;
+    Options.bShouldFireForExistingTriggers = true;
+    FOGGameplayTriggerHandle ExistingTrigger = TriggerSubsystem->StartTriggerImplicitContext(Tag2, FGameplayTagContainer::EmptyContainer);
+    FOGTriggerListenerHandle Handle = TriggerSubsystem->RegisterTriggerListener(TriggerTypes, EOGTriggerListenerPhases::TriggerStart, Delegate, Options, &WhenListenerRemoved);
+    WhenListenerRemoved->Then(TOGFuture<void>::FThenDelegate::CreateLambda([&bWasRemoved]() { bWasRemoved = true; }));
+    TestTrue(TEXT("Multi type listener should have a valid handle"), TriggerSubsystem->IsListenerHandleValid(Handle));
+    TestEqual(TEXT("Multi type listener should count as a single listener"), TriggerSubsystem->GetMemoryStats().NumListeners, NumListenersBefore + 1);
+    TestEqual(TEXT("Existing triggers of any of the types should fire"), ReceivedTypes, TArray<FGameplayTag>({Tag2}));
+    TestTrue(TEXT("Every type should report a listener"), TriggerSubsystem->HasListeners(Tag1) && TriggerSubsystem->HasListeners(Tag2));
+
+    ReceivedTypes.Reset();
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(Tag1, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(OtherTag, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(Tag2, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Listener should receive both of its types and nothing else"), ReceivedTypes, TArray<FGameplayTag>({Tag1, Tag2}));
+
+    // Test 2: Removing the handle removes the listener from every type, and resolves the future once
+    TriggerSubsystem->RemoveTriggerListener(Handle);
+    TestTrue(TEXT("WhenListenerRemoved should resolve on removal"), bWasRemoved);
+    TestFalse(TEXT("Removed listener should no longer be valid"), TriggerSubsystem->IsListenerHandleValid(Handle));
+    TestFalse(TEXT("No type should keep the removed listener"), TriggerSubsystem->HasListeners(Tag1) || TriggerSubsystem->HasListeners(Tag2));
+    TestEqual(TEXT("Listener count should be back to where it was"), TriggerSubsystem->GetMemoryStats().NumListeners, NumListenersBefore);
+
+    // Test 3: Removing a group met through several types removes the listener once
+    FOGTriggerListenerGroupHandle Group = TriggerSubsystem->CreateListenerGroup();
+    FOGTriggerListenerOptions GroupOptions;
+    GroupOptions.Group = Group;
+    FOGTriggerListenerHandle GroupHandle = TriggerSubsystem->RegisterTriggerListener(TriggerTypes, EOGTriggerListenerPhases::TriggerStart, Delegate, GroupOptions);
+    TriggerSubsystem->RemoveListenerGroup(Group);
+    TestFalse(TEXT("Group removal should remove the multi type listener"), TriggerSubsystem->IsListenerHandleValid(GroupHandle));
+    TestFalse(TEXT("Group removal should clear every type"), TriggerSubsystem->HasListeners(Tag1) || TriggerSubsystem->HasListeners(Tag2));
+    TestEqual(TEXT("Group removal should only count the listener once"), TriggerSubsystem->GetMemoryStats().NumListeners, NumListenersBefore);
+
+    // Clean up
+    TriggerSubsystem->EndTrigger(ExistingTrigger);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemTapTest, "OccamsGamekit.OGGameplayTrigger.TriggerTaps",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemTapTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag Tag1 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1"));
+    FGameplayTag Tag2 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+
+    TArray<FString> CallOrder;
+    FOGTriggerDelegate TypedDelegate;
+    TypedDelegate.BindLambda([&CallOrder](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        CallOrder.Add(TEXT("Typed"));
+    });
+    FOGTriggerDelegate TapDelegate;
+    TapDelegate.BindLambda([&CallOrder](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        CallOrder.Add(ActiveTrigger->TriggerType.ToString());
+    });
+
+    // Test 1: A tap sees triggers of every type, after the typed listeners, without being a typed listener
+    FOGTriggerListenerHandle TypedHandle = TriggerSubsystem->RegisterTriggerListener(Tag1, EOGTriggerListenerPhases::TriggerStart, TypedDelegate);
+    FOGTriggerTapHandle TapHandle = TriggerSubsystem->AddTriggerTap(TapDelegate);
+    TestTrue(TEXT("Tap handle should be valid"), TapHandle.IsValid());
+    TestTrue(TEXT("Taps should be reported as listening to every type"), TriggerSubsystem->HasListeners(Tag2));
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(Tag1, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(Tag2, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Tap should run after the typed listeners, for every type"), CallOrder, TArray<FString>({TEXT("Typed"), Tag1.ToString(), Tag2.ToString()}));
+
+    // Test 2: Phases filter what the tap sees
+    CallOrder.Reset();
+    FOGTriggerTapOptions EndOnly;
+    EndOnly.Phases = EOGTriggerListenerPhases::TriggerEnd;
+    TapHandle.Reset();
+    TestFalse(TEXT("Reset tap handle should no longer be valid"), TriggerSubsystem->IsTriggerTapValid(TapHandle));
+    FOGTriggerTapHandle EndTapHandle = TriggerSubsystem->AddTriggerTap(TapDelegate, EndOnly);
+    FOGGameplayTriggerHandle Persistent = TriggerSubsystem->StartTriggerImplicitContext(Tag2, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("End only tap should not see the start of a trigger"), CallOrder.Num(), 0);
+    TriggerSubsystem->EndTrigger(Persistent);
+    TestEqual(TEXT("End only tap should see the end of a trigger"), CallOrder, TArray<FString>({Tag2.ToString()}));
+    TriggerSubsystem->RemoveTriggerTap(EndTapHandle);
+
+    // Test 3: Sampled taps see a fixed fraction of the traffic, starting with the first trigger
+    int32 NumSampled = 0;
+    FOGTriggerTapOptions Sampled;
+    Sampled.SampleRate = 0.25f;
+    FOGTriggerTapHandle SampledHandle = TriggerSubsystem->AddTriggerTap(TriggerSubsystem, [&NumSampled](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        NumSampled++;
+    }, Sampled);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(Tag2, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("The first trigger should be sampled"), NumSampled, 1);
+    for (int32 i = 0; i < 15; ++i)
+    {
+        TriggerSubsystem->InstantaneousTriggerImplicitContext(Tag2, FGameplayTagContainer::EmptyContainer);
+    }
+    TestEqual(TEXT("A quarter of the triggers should be sampled"), NumSampled, 4);
+
+    // Clean up
+    TriggerSubsystem->RemoveTriggerTap(SampledHandle);
+    TriggerSubsystem->RemoveTriggerListener(TypedHandle);
+    TestEqual(TEXT("Every tap should be removed"), TriggerSubsystem->GetEngine().GetNumTriggerTaps(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemTelemetryTest, "OccamsGamekit.OGGameplayTrigger.Telemetry",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemTelemetryTest::RunTest(const FString& Parameters)
+{
+    FOGTriggerEngine Engine;
+    FGameplayTag Tag1 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1"));
+    FGameplayTag Tag2 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+    FGameplayTagContainer Tags;
+    Tags.AddTag(Tag2);
+    USceneComponent* Instigator = NewObject<USceneComponent>();
+
+    FOGTriggerTelemetryOptions Options;
+    Options.Directory = FPaths::AutomationTransientDir() / TEXT("TriggerTelemetry");
+    Options.WindowSeconds = 1.0;
+    IFileManager::Get().DeleteDirectory(*Options.Directory, false, true);
+    const FString FilePath = Options.Directory / TEXT("Triggers_0.ogtt");
+    {
+        FOGTriggerTelemetrySink Sink(Engine, Options);
+
+        // Test 1: Triggers are counted per type, tag set and instigator class
+        for (int32 i = 0; i < 3; ++i)
+        {
+            Engine.InstantaneousTriggerImplicitContext(Tag1, FGameplayTagContainer::EmptyContainer, Instigator);
+        }
+        Engine.InstantaneousTriggerImplicitContext(Tag1, Tags);
+        const FOGGameplayTriggerHandle Persistent = Engine.StartTriggerImplicitContext(Tag2, FGameplayTagContainer::EmptyContainer);
+        Engine.UpdateTrigger(Persistent, Engine.GetTriggerContextForUpdate(Persistent));
+        Engine.EndTrigger(Persistent);
+        TestEqual(TEXT("Each combination should have its own counter"), Sink.GetNumCountersInWindow(), 3);
+
+        // Test 2: The window is handed to the writer from the engine tick once it is over, without waiting for another trigger
+        Engine.Tick(1.5f);
+        TestEqual(TEXT("The finished window should be closed by the tick"), Sink.GetNumCountersInWindow(), 0);
+        Sink.WaitForWrites();
+        TestEqual(TEXT("The finished window should be written"), Sink.GetNumWindowsWritten(), int64(1));
+
+        // Test 3: The last window before a quiet period is written on time
+        Engine.InstantaneousTriggerImplicitContext(Tag2, FGameplayTagContainer::EmptyContainer);
+        TestEqual(TEXT("The trigger should be counted in the new window"), Sink.GetNumCountersInWindow(), 1);
+        Engine.Tick(3.f);
+        Sink.WaitForWrites();
+        TestEqual(TEXT("The window before the quiet period should be written"), Sink.GetNumWindowsWritten(), int64(2));
+    }
+
+    // Test 4: The file holds both windows, and the sink going away doesn't write an empty one
+    TArray<FOGTriggerTelemetryWindow> Windows;
+    TestTrue(TEXT("Telemetry file should be readable"), FOGTriggerTelemetrySink::ReadTelemetryFile(FilePath, Windows));
+    if (TestEqual(TEXT("Telemetry file should hold both windows"), Windows.Num(), 2))
+    {
+        TestEqual(TEXT("First window should end on the window length"), Windows[0].EndTime, 1.0);
+        const FOGTriggerTelemetryRow* InstigatedRow = Windows[0].Rows.FindByPredicate([&Tag1](const FOGTriggerTelemetryRow& Row)
+        {
+            return Row.TriggerType == Tag1.ToString() && !Row.InstigatorClass.IsEmpty();
+        });
+        if (TestNotNull(TEXT("Instigated triggers should have their own row"), InstigatedRow))
+        {
+            TestEqual(TEXT("Instigated row should name the instigator class"), InstigatedRow->InstigatorClass, USceneComponent::StaticClass()->GetName());
+            TestEqual(TEXT("Instigated row should count every trigger"), InstigatedRow->Count, uint32(3));
+        }
+        const FOGTriggerTelemetryRow* PersistentRow = Windows[0].Rows.FindByPredicate([&Tag2](const FOGTriggerTelemetryRow& Row) { return Row.TriggerType == Tag2.ToString(); });
+        if (TestNotNull(TEXT("Persistent triggers should be counted"), PersistentRow))
+        {
+            TestEqual(TEXT("Updates and ends should not be counted"), PersistentRow->Count, uint32(1));
+        }
+        TestEqual(TEXT("Second window should hold the last trigger"), Windows[1].Rows.Num(), 1);
+        TestEqual(TEXT("Second window should end on its boundary rather than on the next trigger"), Windows[1].EndTime, 2.0);
+    }
+
+    // Test 5: Corrupted counts are rejected before anything is sized from them
+    TArray<uint8> CorruptedBytes;
+    FFileHelper::LoadFileToArray(CorruptedBytes, *FilePath);
+    // The name count follows the magic, the version and the window times
+    const int32 HugeCount = MAX_int32;
+    FMemory::Memcpy(CorruptedBytes.GetData() + 24, &HugeCount, sizeof(int32));
+    const FString CorruptedPath = Options.Directory / TEXT("Corrupted.ogtt");
+    FFileHelper::SaveArrayToFile(CorruptedBytes, *CorruptedPath);
+    TArray<FOGTriggerTelemetryWindow> CorruptedWindows;
+    TestFalse(TEXT("A corrupted name count should be rejected"), FOGTriggerTelemetrySink::ReadTelemetryFile(CorruptedPath, CorruptedWindows));
+
+    CorruptedBytes.Reset();
+    FMemoryWriter CorruptedWriter(CorruptedBytes);
+    uint32 Magic = 0x4F475454;
+    int32 Version = 1;
+    double StartTime = 0.0;
+    double EndTime = 1.0;
+    int32 NumNames = 0;
+    int32 NumRows = HugeCount;
+    CorruptedWriter << Magic << Version << StartTime << EndTime << NumNames << NumRows;
+    FFileHelper::SaveArrayToFile(CorruptedBytes, *CorruptedPath);
+    TestFalse(TEXT("A corrupted row count should be rejected"), FOGTriggerTelemetrySink::ReadTelemetryFile(CorruptedPath, CorruptedWindows));
+    TestEqual(TEXT("Corrupted windows should not be returned"), CorruptedWindows.Num(), 0);
+
+    // Clean up
+    IFileManager::Get().DeleteDirectory(*Options.Directory, false, true);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemAggregateViewTest, "OccamsGamekit.OGGameplayTrigger.AggregateViews",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemAggregateViewTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag TestTriggerType = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+    USceneComponent* TargetA = NewObject<USceneComponent>(World);
+    USceneComponent* TargetB = NewObject<USceneComponent>(World);
+    auto StartWithValue = [&](UObject* Target, int32 Value)
+    {
+        UOGGameplayTriggerContext* Context = TriggerSubsystem->MakeGameplayTriggerContext(TestTriggerType, FGameplayTagContainer::EmptyContainer, nullptr, Target);
+        Context->DataBank.AddUnique<FTestTriggerData_Int>().TestInt = Value;
+        return TriggerSubsystem->StartTrigger(Context);
+    };
+
+    // Test 1: Views include the triggers that were already active when they were created
+    FOGGameplayTriggerHandle First = StartWithValue(TargetA, 5);
+    FOGTriggerAggregateViewOptions CountOptions;
+    CountOptions.TriggerType = TestTriggerType;
+    CountOptions.KeyBy = EOGTriggerAggregateKey::Target;
+    FOGTriggerAggregateViewHandle CountView = TriggerSubsystem->CreateAggregateView(CountOptions);
+    TestEqual(TEXT("Existing trigger should be counted"), TriggerSubsystem->ReadAggregateView(CountView, TargetA), 1.0);
+
+    FOGTriggerAggregateViewOptions SumOptions = CountOptions;
+    SumOptions.Op = EOGTriggerAggregateOp::Sum;
+    SumOptions.Value = FOGTriggerAggregateViewOptions::DataField(&FTestTriggerData_Int::TestInt);
+    FOGTriggerAggregateViewHandle SumView = TriggerSubsystem->CreateAggregateView(SumOptions);
+    FOGTriggerAggregateViewOptions MaxOptions = SumOptions;
+    MaxOptions.Op = EOGTriggerAggregateOp::Max;
+    MaxOptions.KeyBy = EOGTriggerAggregateKey::None;
+    FOGTriggerAggregateViewHandle MaxView = TriggerSubsystem->CreateAggregateView(MaxOptions);
+
+    // Test 2: Views follow triggers as they start, per target
+    FOGGameplayTriggerHandle Second = StartWithValue(TargetA, 3);
+    FOGGameplayTriggerHandle Third = StartWithValue(TargetB, 10);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(TestTriggerType, FGameplayTagContainer::EmptyContainer, nullptr, TargetA);
+    TestEqual(TEXT("Count should be kept per target"), TriggerSubsystem->ReadAggregateView(CountView, TargetA), 2.0);
+    TestEqual(TEXT("Instantaneous triggers should not stay in the view"), TriggerSubsystem->GetAggregateViewCount(CountView, TargetA), 2);
+    TestEqual(TEXT("Sum should add the field of every trigger of the target"), TriggerSubsystem->ReadAggregateView(SumView, TargetA), 8.0);
+    TestEqual(TEXT("Sum of the other target should be separate"), TriggerSubsystem->ReadAggregateView(SumView, TargetB), 10.0);
+    TestEqual(TEXT("Unkeyed max should cover every target"), TriggerSubsystem->ReadAggregateView(MaxView), 10.0);
+
+    // Test 3: Updates in place replace the previous value
+    UOGGameplayTriggerContext* Updated = TriggerSubsystem->GetTriggerContextForUpdate(Second);
+    Updated->DataBank.GetChecked<FTestTriggerData_Int>().TestInt = 20;
+    TriggerSubsystem->UpdateTrigger(Second, Updated);
+    TestEqual(TEXT("Sum should use the updated value"), TriggerSubsystem->ReadAggregateView(SumView, TargetA), 25.0);
+    TestEqual(TEXT("Max should use the updated value"), TriggerSubsystem->ReadAggregateView(MaxView), 20.0);
+
+    // Test 4: Ending triggers takes them out of the views
+    TriggerSubsystem->EndTrigger(Second);
+    TestEqual(TEXT("Max should fall back to the largest remaining value"), TriggerSubsystem->ReadAggregateView(MaxView), 10.0);
+    TriggerSubsystem->EndTrigger(First);
+    TestEqual(TEXT("Target without triggers should count zero"), TriggerSubsystem->ReadAggregateView(CountView, TargetA), 0.0);
+    TriggerSubsystem->EndTrigger(Third);
+    TestEqual(TEXT("Empty max should read the default value"), TriggerSubsystem->ReadAggregateView(MaxView, nullptr, -1.0), -1.0);
+
+    // Test 5: Min and max stay right when values are removed from below the top, or removed many times over
+    FOGTriggerAggregateViewOptions MinOptions = MaxOptions;
+    MinOptions.Op = EOGTriggerAggregateOp::Min;
+    FOGTriggerAggregateViewHandle MinView = TriggerSubsystem->CreateAggregateView(MinOptions);
+    FOGGameplayTriggerHandle Four = StartWithValue(TargetA, 4);
+    FOGGameplayTriggerHandle OtherFour = StartWithValue(TargetA, 4);
+    FOGGameplayTriggerHandle Seven = StartWithValue(TargetA, 7);
+    FOGGameplayTriggerHandle Nine = StartWithValue(TargetB, 9);
+    FOGGameplayTriggerHandle One = StartWithValue(TargetB, 1);
+    TriggerSubsystem->EndTrigger(Four);
+    TestEqual(TEXT("Removing a value below the min should keep it"), TriggerSubsystem->ReadAggregateView(MinView), 1.0);
+    TriggerSubsystem->EndTrigger(One);
+    TestEqual(TEXT("Min should fall back to the equal value still active"), TriggerSubsystem->ReadAggregateView(MinView), 4.0);
+    TriggerSubsystem->EndTrigger(OtherFour);
+    TestEqual(TEXT("Min should skip values removed while they were below it"), TriggerSubsystem->ReadAggregateView(MinView), 7.0);
+    for (int32 i = 0; i < 16; ++i)
+    {
+        TriggerSubsystem->EndTrigger(StartWithValue(TargetA, 100 + i));
+    }
+    TestEqual(TEXT("Churn above the min should not change it"), TriggerSubsystem->ReadAggregateView(MinView), 7.0);
+    TestEqual(TEXT("Churn below the max should not change it"), TriggerSubsystem->ReadAggregateView(MaxView), 9.0);
+    TriggerSubsystem->EndTrigger(Seven);
+    TestEqual(TEXT("Min should reach the last value"), TriggerSubsystem->ReadAggregateView(MinView), 9.0);
+    TriggerSubsystem->EndTrigger(Nine);
+    TestEqual(TEXT("Empty min should read the default value"), TriggerSubsystem->ReadAggregateView(MinView, nullptr, -1.0), -1.0);
+
+    // Clean up
+    TriggerSubsystem->RemoveAggregateView(MinView);
+    CountView.Reset();
+    TriggerSubsystem->RemoveAggregateView(SumView);
+    TriggerSubsystem->RemoveAggregateView(MaxView);
+    TestFalse(TEXT("Removed views should no longer be valid"), TriggerSubsystem->IsAggregateViewValid(CountView) || TriggerSubsystem->IsAggregateViewValid(SumView));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOGTriggerSubsystemCompositeTest, "OccamsGamekit.OGGameplayTrigger.CompositeTriggers",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FOGTriggerSubsystemCompositeTest::RunTest(const FString& Parameters)
+{
+    FTestWorldWrapper WorldWrapper;
+    WorldWrapper.CreateTestWorld(EWorldType::Game);
+    UWorld* World = WorldWrapper.GetTestWorld();
+    if (!World)
+        return false;
+
+    UOGGameplayTriggerSubsystem* TriggerSubsystem = UOGGameplayTriggerSubsystem::Get(World);
+    if (!TriggerSubsystem)
+    {
+        AddError(TEXT("Failed to get OGGameplayTriggerSubsystem"));
+        return false;
+    }
+
+    FGameplayTag BasicTag = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Basic"));
+    FGameplayTag Tag1 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1"));
+    FGameplayTag Tag2 = FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag2"));
+
+    int32 NumStarts = 0;
+    int32 NumEnds = 0;
+    TWeakObjectPtr<UObject> LastTarget;
+    FOGTriggerListenerHandle OutputListener = TriggerSubsystem->RegisterTriggerListener(TriggerSubsystem, Tag2, EOGTriggerListenerPhases::TriggerStart | EOGTriggerListenerPhases::TriggerEnd,
+        [&NumStarts, &NumEnds, &LastTarget](const FOGGameplayTriggerHandle& TriggerHandle, const EOGTriggerListenerPhases& TriggerPhase, const UOGGameplayTriggerContext* ActiveTrigger)
+    {
+        (TriggerPhase == EOGTriggerListenerPhases::TriggerStart ? NumStarts : NumEnds)++;
+        LastTarget = ActiveTrigger->TargetObject.Get();
+    });
+
+    // Test 1: The derived trigger starts and ends only when the condition flips
+    FOGTriggerCompositeOptions Options;
+    Options.OutputType = Tag2;
+    Options.Require(BasicTag).Exclude(Tag1);
+    FOGTriggerCompositeHandle Composite = TriggerSubsystem->CreateCompositeTrigger(Options);
+    TestTrue(TEXT("Composite handle should be valid"), Composite.IsValid());
+    TestFalse(TEXT("Composite should not hold without triggers"), TriggerSubsystem->IsCompositeTriggerActive(Composite));
+    FOGGameplayTriggerHandle FirstBasic = TriggerSubsystem->StartTriggerImplicitContext(BasicTag, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Derived trigger should start when the condition holds"), NumStarts, 1);
+    FOGGameplayTriggerHandle SecondBasic = TriggerSubsystem->StartTriggerImplicitContext(BasicTag, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Inputs that don't flip the condition should not start it again"), NumStarts, 1);
+    FOGGameplayTriggerHandle Excluded = TriggerSubsystem->StartTriggerImplicitContext(Tag1, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Excluded trigger should end the derived trigger"), NumEnds, 1);
+    TestFalse(TEXT("Composite should not hold with an excluded trigger"), TriggerSubsystem->IsCompositeTriggerActive(Composite));
+
+    // Test 2: Instantaneous triggers are never counted
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(Tag1, FGameplayTagContainer::EmptyContainer);
+    TriggerSubsystem->EndTrigger(Excluded);
+    TestEqual(TEXT("Ending the excluded trigger should start the derived trigger again"), NumStarts, 2);
+    TriggerSubsystem->InstantaneousTriggerImplicitContext(Tag1, FGameplayTagContainer::EmptyContainer);
+    TestEqual(TEXT("Instantaneous excluded trigger should not end the derived trigger"), NumEnds, 1);
+    TriggerSubsystem->EndTrigger(FirstBasic);
+    TestEqual(TEXT("Remaining required trigger should keep the derived trigger"), NumEnds, 1);
+    TriggerSubsystem->EndTrigger(SecondBasic);
+    TestEqual(TEXT("Last required trigger should end the derived trigger"), NumEnds, 2);
+    Composite.Reset();
+    TestFalse(TEXT("Reset composite should no longer be valid"), TriggerSubsystem->IsCompositeTriggerValid(Composite));
+
+    // Test 3: Keyed composites hold per target, and start right away if they already hold
+    USceneComponent* TargetA = NewObject<USceneComponent>(World);
+    USceneComponent* TargetB = NewObject<USceneComponent>(World);
+    FOGGameplayTriggerHandle BasicOnA = TriggerSubsystem->StartTriggerImplicitContext(BasicTag, FGameplayTagContainer::EmptyContainer, nullptr, TargetA);
+    FOGGameplayTriggerHandle Tag1OnB = TriggerSubsystem->StartTriggerImplicitContext(Tag1, FGameplayTagContainer::EmptyContainer, nullptr, TargetB);
+    FOGTriggerCompositeOptions KeyedOptions;
+    KeyedOptions.OutputType = Tag2;
+    KeyedOptions.KeyBy = EOGTriggerAggregateKey::Target;
+    KeyedOptions.Require(BasicTag).Require(Tag1);
+    FOGTriggerCompositeHandle KeyedComposite = TriggerSubsystem->CreateCompositeTrigger(KeyedOptions);
+    TestEqual(TEXT("Terms held by different targets should not start the derived trigger"), NumStarts, 2);
+    FOGGameplayTriggerHandle Tag1OnA = TriggerSubsystem->StartTriggerImplicitContext(Tag1, FGameplayTagContainer::EmptyContainer, nullptr, TargetA);
+    TestEqual(TEXT("Derived trigger should start once a target holds every term"), NumStarts, 3);
+    TestTrue(TEXT("Derived trigger should target the key"), LastTarget.Get() == TargetA);
+    TestTrue(TEXT("Composite should hold for the first target"), TriggerSubsystem->IsCompositeTriggerActive(KeyedComposite, TargetA));
+    TestFalse(TEXT("Composite should not hold for the second target"), TriggerSubsystem->IsCompositeTriggerActive(KeyedComposite, TargetB));
+
+    FOGGameplayTriggerHandle BasicOnB = TriggerSubsystem->StartTriggerImplicitContext(BasicTag, FGameplayTagContainer::EmptyContainer, nullptr, TargetB);
+    TestEqual(TEXT("Derived trigger should start for the second target"), NumStarts, 4);
+    FOGTriggerCompositeHandle SeededComposite = TriggerSubsystem->CreateCompositeTrigger(KeyedOptions);
+    TestEqual(TEXT("Composite created while its condition holds should start right away"), NumStarts, 6);
+    TriggerSubsystem->RemoveCompositeTrigger(SeededComposite);
+    TestEqual(TEXT("Removing a composite should end its derived triggers"), NumEnds, 4);
+
+    // Clean up
+    KeyedComposite.Reset();
+    TriggerSubsystem->EndTrigger(BasicOnA);
+    TriggerSubsystem->EndTrigger(BasicOnB);
+    TriggerSubsystem->EndTrigger(Tag1OnA);
+    TriggerSubsystem->EndTrigger(Tag1OnB);
+    OutputListener.Reset();
+
+    return true;
+}
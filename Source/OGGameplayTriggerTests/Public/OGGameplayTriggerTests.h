@@ -1,24 +1,61 @@
-﻿/// Copyright Occam's Gamekit contributors 2025
-
-#pragma once
-
-#include "OGGameplayTriggerTypes.h"
-#include "OGGameplayTriggerTests.generated.h"
-
-USTRUCT(BlueprintType)
-struct FTestTriggerData_Int : public FOGTriggerDataType
-{
-	GENERATED_BODY()
-
-	UPROPERTY(BlueprintReadWrite)
-	int TestInt;
-};
-
-UCLASS(NotBlueprintType)
-class UOGTestTriggerFilter_DataIsPositive : public UOGGameplayTriggerFilter
-{
-	GENERATED_BODY()
-
-protected:
-	virtual bool DoesTriggerPassFilter_Native(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const override;
-};
\ No newline at end of file
+﻿/// Copyright Occam's Gamekit contributors 2025
+
+#pragma once
+
+#include "OGGameplayTriggerTypes.h"
+#include "OGGameplayTriggerTests.generated.h"
+
+USTRUCT(BlueprintType)
+struct FTestTriggerData_Int : public FOGTriggerDataType
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite)
+	int TestInt;
+};
+
+USTRUCT()
+struct FTestTriggerPayload_Damage : public FOGTriggerDataType
+{
+	GENERATED_BODY()
+
+	static FGameplayTag GetTriggerType() { return FGameplayTag::RequestGameplayTag(TEXT("Test.Trigger.Tag1")); }
+
+	UPROPERTY()
+	float Amount = 0.f;
+};
+
+UCLASS(NotBlueprintType)
+class UOGTestTriggerFilter_DataIsPositive : public UOGGameplayTriggerFilter
+{
+	GENERATED_BODY()
+
+protected:
+	virtual bool DoesTriggerPassFilter_Native(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const override;
+};
+UCLASS(NotBlueprintType)
+class UOGTestTriggerFilter_Stale : public UOGGameplayTriggerFilter
+{
+	GENERATED_BODY()
+
+public:
+	bool bIsStale = false;
+
+protected:
+	virtual bool IsFilterStale_Native() const override { return bIsStale; }
+};
+UCLASS(NotBlueprintType)
+class UOGTestTriggerFilter_Counting : public UOGGameplayTriggerFilter
+{
+	GENERATED_BODY()
+
+public:
+	int32* Counter = nullptr;
+
+protected:
+	virtual bool DoesTriggerPassFilter_Native(const EOGTriggerListenerPhases TriggerPhase, const UOGGameplayTriggerContext* Trigger, bool& OutIsFilterStale) const override
+	{
+		++*Counter;
+		return true;
+	}
+};